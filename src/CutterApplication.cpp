@@ -4,6 +4,9 @@
 #include "CutterConfig.h"
 #include "common/Decompiler.h"
 #include "common/ResourcePaths.h"
+#include "common/BatchAnalysis.h"
+#include "core/CoreLockProfiler.h"
+#include "common/StallWatchdog.h"
 
 #include <QApplication>
 #include <QFileOpenEvent>
@@ -19,6 +22,8 @@
 #include <QTranslator>
 #include <QLibraryInfo>
 #include <QFontDatabase>
+#include <QThread>
+#include <QTimer>
 #ifdef Q_OS_WIN
 #    include <QtNetwork/QtNetwork>
 #endif // Q_OS_WIN
@@ -87,11 +92,24 @@ CutterApplication::CutterApplication(int &argc, char **argv) : QApplication(argc
         std::exit(1);
     }
 
+    if (!clOptions.coreLockProfileFile.isEmpty()) {
+        CoreLockProfiler::instance()->setEnabled(true);
+        connect(this, &QCoreApplication::aboutToQuit, this, [this]() {
+            QString error;
+            if (!CoreLockProfiler::instance()->save(clOptions.coreLockProfileFile, &error)) {
+                qWarning() << "Cannot save the core lock profile:" << error;
+            }
+        });
+    }
+
     // Check rizin version
     QString rzversion = rz_core_version();
     QString localVersion = CUTTER_COMPILE_TIME_RZ_VERSION;
     qDebug() << rzversion << localVersion;
-    if (rzversion != localVersion) {
+    if (rzversion != localVersion && clOptions.batch) {
+        qWarning() << "The version used to compile Cutter" << localVersion
+                   << "does not match the binary version of rizin" << rzversion;
+    } else if (rzversion != localVersion) {
         QMessageBox msg;
         msg.setIcon(QMessageBox::Critical);
         msg.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
@@ -130,26 +148,31 @@ CutterApplication::CutterApplication(int &argc, char **argv) : QApplication(argc
         plugin->registerDecompilers();
     }
 
-    mainWindow = new MainWindow();
-    installEventFilter(mainWindow);
+    if (clOptions.batch) {
+        startBatchAnalysis();
+    } else {
+        mainWindow = new MainWindow();
+        installEventFilter(mainWindow);
+        StallWatchdog::instance()->setThreshold(Config()->getStallThreshold());
 
-    // set up context menu shortcut display fix
+        // set up context menu shortcut display fix
 #if QT_VERSION_CHECK(5, 10, 0) < QT_VERSION
-    setStyle(new CutterProxyStyle());
+        setStyle(new CutterProxyStyle());
 #endif // QT_VERSION_CHECK(5, 10, 0) < QT_VERSION
 
-    if (clOptions.args.empty() && clOptions.fileOpenOptions.projectFile.isEmpty()) {
-        // check if this is the first execution of Cutter in this computer
-        // Note: the execution after the preferences been reset, will be considered as
-        // first-execution
-        if (Config()->isFirstExecution()) {
-            mainWindow->displayWelcomeDialog();
+        if (clOptions.args.empty() && clOptions.fileOpenOptions.projectFile.isEmpty()) {
+            // check if this is the first execution of Cutter in this computer
+            // Note: the execution after the preferences been reset, will be considered as
+            // first-execution
+            if (Config()->isFirstExecution()) {
+                mainWindow->displayWelcomeDialog();
+            }
+            mainWindow->displayNewFileDialog();
+        } else { // filename specified as positional argument
+            bool askOptions = (clOptions.analysisLevel != AutomaticAnalysisLevel::Ask)
+                    || !clOptions.fileOpenOptions.projectFile.isEmpty();
+            mainWindow->openNewFile(clOptions.fileOpenOptions, askOptions);
         }
-        mainWindow->displayNewFileDialog();
-    } else { // filename specified as positional argument
-        bool askOptions = (clOptions.analysisLevel != AutomaticAnalysisLevel::Ask)
-                || !clOptions.fileOpenOptions.projectFile.isEmpty();
-        mainWindow->openNewFile(clOptions.fileOpenOptions, askOptions);
     }
 
 #ifdef APPIMAGE
@@ -210,11 +233,18 @@ void CutterApplication::launchNewInstance(const QStringList &args)
     process.startDetached(qApp->applicationFilePath(), allArgs);
 }
 
+bool CutterApplication::notify(QObject *receiver, QEvent *event)
+{
+    // Tells the StallWatchdog what the GUI thread is busy with
+    StallWatchdog::EventScope scope(receiver, event);
+    return QApplication::notify(receiver, event);
+}
+
 bool CutterApplication::event(QEvent *e)
 {
     if (e->type() == QEvent::FileOpen) {
         QFileOpenEvent *openEvent = static_cast<QFileOpenEvent *>(e);
-        if (openEvent) {
+        if (openEvent && mainWindow) {
             if (m_FileAlreadyDropped) {
                 // We already dropped a file in macOS, let's spawn another instance
                 // (Like the File -> Open)
@@ -292,10 +322,44 @@ bool CutterApplication::loadTranslations()
     return false;
 }
 
+void CutterApplication::startBatchAnalysis()
+{
+    // Workers get the same options, with a single file each
+    InitialOptions workerOptions = clOptions.fileOpenOptions;
+    workerOptions.filename.clear();
+    workerOptions.projectFile.clear();
+    QStringList workerArgs = { "--batch" };
+    if (!clOptions.batchOutputDir.isEmpty()) {
+        workerArgs.push_back("--output-dir");
+        workerArgs.push_back(clOptions.batchOutputDir);
+    }
+    if (!clOptions.pythonHome.isEmpty()) {
+        workerArgs.push_back("--pythonhome");
+        workerArgs.push_back(clOptions.pythonHome);
+    }
+    if (!clOptions.enableCutterPlugins) {
+        workerArgs.push_back("--no-cutter-plugins");
+    }
+    if (!clOptions.enableRizinPlugins) {
+        workerArgs.push_back("--no-rizin-plugins");
+    }
+    workerArgs.append(getArgs(workerOptions));
+
+    int jobs = clOptions.batchJobs > 0 ? clOptions.batchJobs : QThread::idealThreadCount();
+    auto batchAnalysis = new BatchAnalysis(clOptions.fileOpenOptions, clOptions.args,
+                                           clOptions.batchOutputDir, jobs, workerArgs, this);
+    connect(batchAnalysis, &BatchAnalysis::finished, this, &QCoreApplication::exit);
+    // exit() only works once the event loop runs
+    QTimer::singleShot(0, batchAnalysis, &BatchAnalysis::start);
+}
+
 QStringList CutterApplication::getArgs() const
 {
-    auto &options = clOptions.fileOpenOptions;
+    return getArgs(clOptions.fileOpenOptions);
+}
 
+QStringList CutterApplication::getArgs(const InitialOptions &options) const
+{
     QStringList args;
     switch (clOptions.analysisLevel) {
     case AutomaticAnalysisLevel::None:
@@ -328,6 +392,10 @@ QStringList CutterApplication::getArgs() const
         args.push_back("-p");
         args.push_back(options.projectFile);
     }
+    if (!options.analysisTraceFile.isEmpty()) {
+        args.push_back("--analysis-trace");
+        args.push_back(options.analysisTraceFile);
+    }
     if (!options.arch.isEmpty()) {
         args.push_back("-a");
         args.push_back(options.arch);
@@ -469,6 +537,42 @@ bool CutterApplication::parseCommandLineOptions()
                                            QObject::tr("Do not load rizin plugins"));
     cmd_parser.addOption(disableRizinPlugins);
 
+    QCommandLineOption analysisTraceOption(
+            "analysis-trace",
+            QObject::tr("Save the time, memory and results of each analysis stage to a trace "
+                        "file for chrome://tracing or Perfetto. In batch mode, a trace is saved "
+                        "next to each project instead."),
+            QObject::tr("file"));
+    cmd_parser.addOption(analysisTraceOption);
+
+    QCommandLineOption batchOption(
+            "batch",
+            QObject::tr("Analyze the files without user interface and save a project for each "
+                        "of them. Needs filenames to be specified. The analysis level defaults "
+                        "to 1."));
+    cmd_parser.addOption(batchOption);
+
+    QCommandLineOption jobsOption(
+            { "j", "jobs" },
+            QObject::tr("Number of files analyzed in parallel in batch mode. Defaults to the "
+                        "number of CPU cores."),
+            QObject::tr("count"));
+    cmd_parser.addOption(jobsOption);
+
+    QCommandLineOption outputDirOption(
+            "output-dir",
+            QObject::tr("Directory for the projects saved in batch mode. Defaults to the "
+                        "directory of each file."),
+            QObject::tr("directory"));
+    cmd_parser.addOption(outputDirOption);
+
+    QCommandLineOption coreLockProfileOption(
+            "core-lock-profile",
+            QObject::tr("Measure how long each caller waits for and holds the rizin core and "
+                        "save the histograms to a file on exit."),
+            QObject::tr("file"));
+    cmd_parser.addOption(coreLockProfileOption);
+
     cmd_parser.process(*this);
 
     CutterCommandLineOptions opts;
@@ -498,6 +602,34 @@ bool CutterApplication::parseCommandLineOptions()
         }
     }
 
+    opts.batch = cmd_parser.isSet(batchOption);
+    if (opts.batch) {
+        if (opts.args.empty()) {
+            fprintf(stderr, "%s\n",
+                    QObject::tr("Filenames must be specified in batch mode.")
+                            .toLocal8Bit()
+                            .constData());
+            return false;
+        }
+        if (cmd_parser.isSet(jobsOption)) {
+            bool ok = false;
+            opts.batchJobs = cmd_parser.value(jobsOption).toInt(&ok);
+            if (!ok || opts.batchJobs < 1) {
+                fprintf(stderr, "%s\n",
+                        QObject::tr("Invalid number of jobs.").toLocal8Bit().constData());
+                return false;
+            }
+        }
+        opts.batchOutputDir = cmd_parser.value(outputDirOption);
+        if (!opts.batchOutputDir.isEmpty() && !QDir().mkpath(opts.batchOutputDir)) {
+            fprintf(stderr, "%s\n",
+                    QObject::tr("Cannot create the output directory.")
+                            .toLocal8Bit()
+                            .constData());
+            return false;
+        }
+    }
+
     if (opts.args.empty() && opts.analysisLevel != AutomaticAnalysisLevel::Ask) {
         fprintf(stderr, "%s\n",
                 QObject::tr("Filename must be specified to start analysis automatically.")
@@ -537,6 +669,7 @@ bool CutterApplication::parseCommandLineOptions()
             break;
         }
         opts.fileOpenOptions.script = cmd_parser.value(scriptOption);
+        opts.fileOpenOptions.analysisTraceFile = cmd_parser.value(analysisTraceOption);
         opts.fileOpenOptions.arch = cmd_parser.value(archOption);
         opts.fileOpenOptions.cpu = cmd_parser.value(cpuOption);
         opts.fileOpenOptions.os = cmd_parser.value(osOption);
@@ -575,6 +708,8 @@ bool CutterApplication::parseCommandLineOptions()
         opts.pythonHome = cmd_parser.value(pythonHomeOption);
     }
 
+    opts.coreLockProfileFile = cmd_parser.value(coreLockProfileOption);
+
     opts.outputRedirectionEnabled = !cmd_parser.isSet(disableRedirectOption);
     if (cmd_parser.isSet(disablePlugins)) {
         opts.enableCutterPlugins = false;
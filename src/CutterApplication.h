@@ -19,6 +19,12 @@ struct CutterCommandLineOptions
     bool outputRedirectionEnabled = true;
     bool enableCutterPlugins = true;
     bool enableRizinPlugins = true;
+    /// Analyze the files and save their projects without any UI, see BatchAnalysis
+    bool batch = false;
+    int batchJobs = 0;
+    QString batchOutputDir;
+    /// Record the CoreLockProfiler from the start and save it here on exit
+    QString coreLockProfileFile;
 };
 
 class CutterApplication : public QApplication
@@ -36,6 +42,9 @@ public:
     InitialOptions getInitialOptions() const { return clOptions.fileOpenOptions; }
     void setInitialOptions(const InitialOptions &options) { clOptions.fileOpenOptions = options; }
     QStringList getArgs() const;
+    bool isBatchMode() const { return clOptions.batch; }
+
+    bool notify(QObject *receiver, QEvent *event) override;
 
 protected:
     bool event(QEvent *e);
@@ -51,11 +60,19 @@ private:
      * @return false if options have error
      */
     bool parseCommandLineOptions();
+    /**
+     * @brief Command line options for \p options, including the analysis level
+     */
+    QStringList getArgs(const InitialOptions &options) const;
+    /**
+     * @brief Analyze the files given on the command line without the MainWindow
+     */
+    void startBatchAnalysis();
 
 private:
     bool m_FileAlreadyDropped;
     CutterCore core;
-    MainWindow *mainWindow;
+    MainWindow *mainWindow = nullptr;
     CutterCommandLineOptions clOptions;
 };
 
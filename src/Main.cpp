@@ -4,10 +4,12 @@
 #include "common/UpdateWorker.h"
 #include "CutterConfig.h"
 #include "common/SettingsUpgrade.h"
+#include "common/OmnibarTask.h"
 
 #include <QJsonObject>
 #include <QJsonArray>
 #include <iostream>
+#include <cstring>
 
 /**
  * @brief Attempt to connect to a parent console and configure outputs.
@@ -52,14 +54,35 @@ static void connectToConsole()
 }
 #endif
 
+/**
+ * @brief Check for --batch before the application parses the command line
+ */
+static bool isBatchMode(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--batch")) {
+            return true;
+        }
+    }
+    return false;
+}
+
 int main(int argc, char *argv[])
 {
 #ifdef Q_OS_WIN
     connectToConsole();
 #endif
 
+    bool batch = isBatchMode(argc, argv);
+    if (batch && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        // Batch mode shows nothing and must also run on machines without a display
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     qRegisterMetaType<QList<StringDescription>>();
     qRegisterMetaType<QList<FunctionDescription>>();
+    qRegisterMetaType<QList<OmnibarMatch>>();
+    qRegisterMetaType<QList<SearchDescription>>();
 
     QCoreApplication::setOrganizationName("rizin");
 #ifndef Q_OS_MACOS // don't set on macOS so that it doesn't affect config path there
@@ -69,7 +92,7 @@ int main(int argc, char *argv[])
 
     // Importing settings after setting rename, needs separate handling in addition to regular
     // version to version upgrade.
-    if (Cutter::shouldOfferSettingImport()) {
+    if (!batch && Cutter::shouldOfferSettingImport()) {
         Cutter::showSettingImportDialog(argc, argv);
     }
 
@@ -89,7 +112,7 @@ int main(int argc, char *argv[])
 
     Cutter::migrateThemes();
 
-    if (Config()->getAutoUpdateEnabled()) {
+    if (!a.isBatchMode() && Config()->getAutoUpdateEnabled()) {
 #if CUTTER_UPDATE_WORKER_AVAILABLE
         UpdateWorker *updateWorker = new UpdateWorker;
         QObject::connect(updateWorker, &UpdateWorker::checkComplete,
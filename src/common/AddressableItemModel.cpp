@@ -1,5 +1,6 @@
 #include <stdexcept>
 #include "AddressableItemModel.h"
+#include "core/Cutter.h"
 
 #include <stdexcept>
 
@@ -37,3 +38,31 @@ void AddressableFilterProxyModel::setSourceModel(AddressableItemModelI *sourceMo
     ParentClass::setSourceModel(sourceModel ? sourceModel->asItemModel() : nullptr);
     addressableSourceModel = sourceModel;
 }
+
+void AddressableFilterProxyModel::setFilterWildcardIndexed(const QString &pattern)
+{
+    nameIndexFilterActive =
+            nameIndexKinds && !pattern.isEmpty() && NameIndex::isPlainSubstring(pattern);
+    nameIndexPattern = pattern;
+    nameIndexGeneration = -1;
+    nameIndexMatches.clear();
+    setFilterWildcard(pattern);
+}
+
+bool AddressableFilterProxyModel::rejectedByNameIndex(RVA offset) const
+{
+    if (!nameIndexFilterActive) {
+        return false;
+    }
+    int generation = Core()->getNameIndexGeneration();
+    if (generation != nameIndexGeneration) {
+        // Names changed since the last query (or this is the first one). Until they are
+        // reindexed in the background, the rows are only matched by the filter expression.
+        if (!Core()->requestNameIndex(nameIndexKinds)) {
+            return false;
+        }
+        nameIndexMatches = Core()->findNameAddresses(nameIndexPattern, nameIndexKinds);
+        nameIndexGeneration = generation;
+    }
+    return !nameIndexMatches.contains(offset);
+}
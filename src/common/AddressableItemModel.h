@@ -7,6 +7,9 @@
 #include <QAbstractItemModel>
 
 #include "core/CutterCommon.h"
+#include "common/NameIndex.h"
+
+#include <QSet>
 
 class CUTTER_EXPORT AddressableItemModelI
 {
@@ -48,9 +51,35 @@ public:
     QString name(const QModelIndex &) const override;
     void setSourceModel(AddressableItemModelI *sourceModel);
 
+    /**
+     * @brief Use the core's NameIndex to narrow down the rows accepted by the filter
+     *
+     * Subclasses which filter by the name of one of \p kinds should check
+     * rejectedByNameIndex() before matching the filter expression.
+     */
+    void setNameIndexKinds(NameIndex::Kinds kinds) { nameIndexKinds = kinds; }
+
+    /**
+     * @brief Like setFilterWildcard(), but uses the NameIndex if it is enabled.
+     */
+    void setFilterWildcardIndexed(const QString &pattern);
+
+protected:
+    /**
+     * @return true if the row with the given address can't match the current filter according to
+     * the NameIndex
+     */
+    bool rejectedByNameIndex(RVA offset) const;
+
 private:
     void setSourceModel(QAbstractItemModel *sourceModel) override; // Don't use this directly
     AddressableItemModelI *addressableSourceModel;
+
+    NameIndex::Kinds nameIndexKinds;
+    bool nameIndexFilterActive = false;
+    QString nameIndexPattern;
+    mutable int nameIndexGeneration = -1;
+    mutable QSet<RVA> nameIndexMatches;
 };
 
 #endif // ADDRESSABLEITEMMODEL_H
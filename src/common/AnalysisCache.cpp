@@ -0,0 +1,207 @@
+#include "common/AnalysisCache.h"
+#include "CutterConfig.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QList>
+#include <QPair>
+#include <QStandardPaths>
+
+namespace {
+
+/// Changed whenever the key is computed differently
+const char *const KeyVersion = "2";
+
+QByteArray fileHash(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file)) {
+        return QByteArray();
+    }
+    return hash.result().toHex();
+}
+
+bool isKeyConfig(const QString &name)
+{
+    static const QStringList names = { "asm.arch", "asm.bits", "asm.cpu", "asm.os",
+                                       "cfg.bigendian", "io.va" };
+    return name.startsWith("analysis.") || name.startsWith("bin.") || names.contains(name);
+}
+
+QFileInfoList cachedProjects()
+{
+    // Least recently used first
+    return QDir(AnalysisCache::directory())
+            .entryInfoList({ "*.rzdb" }, QDir::Files, QDir::Time | QDir::Reversed);
+}
+
+}
+
+QByteArray AnalysisCache::inputHash(const InitialOptions &options)
+{
+    QByteArray contentHash = fileHash(options.filename);
+    if (contentHash.isEmpty()) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData("file=" + contentHash + "\n");
+    if (!options.pdbFile.isEmpty()) {
+        hash.addData("pdb=" + fileHash(options.pdbFile) + "\n");
+    }
+    if (!options.script.isEmpty()) {
+        hash.addData("script=" + fileHash(options.script) + "\n");
+    }
+    return hash.result().toHex();
+}
+
+QString AnalysisCache::key(RzCore *core, const InitialOptions &options,
+                           const QByteArray &inputHash)
+{
+    if (inputHash.isEmpty()) {
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    auto add = [&hash](const QString &name, const QString &value) {
+        hash.addData(QString("%1=%2\n").arg(name, value).toUtf8());
+    };
+    add("key", KeyVersion);
+    add("input", inputHash);
+    // Both may analyze differently or store the project differently
+    add("cutter", CUTTER_VERSION_FULL);
+    add("rizin", rz_core_version());
+    add("va", QString::number(options.useVA));
+    add("baddr", QString::number(options.binLoadAddr));
+    add("maddr", QString::number(options.mapAddr));
+    add("bininfo", QString::number(options.loadBinInfo));
+    add("format", options.forceBinPlugin);
+    add("shellcode", options.shellcode);
+    for (const CommandDescription &cmd : options.analysisCmd) {
+        add("cmd", cmd.command);
+    }
+
+    // Everything else the analysis depends on, as set up for the file
+    RzListIter *it;
+    RzConfigNode *node;
+    CutterRzListForeach (core->config->nodes, it, RzConfigNode, node) {
+        if (isKeyConfig(node->name)) {
+            add(node->name, node->value);
+        }
+    }
+    return hash.result().toHex();
+}
+
+bool AnalysisCache::load(RzCore *core, const QString &key)
+{
+    QString file = projectFile(key);
+    if (!QFileInfo::exists(file)) {
+        return false;
+    }
+
+    // Loading a project also restores its configuration, e.g. the display options of whoever
+    // stored it, and makes it the project saved by the user
+    QList<QPair<QByteArray, QByteArray>> userConfig;
+    RzListIter *it;
+    RzConfigNode *node;
+    CutterRzListForeach (core->config->nodes, it, RzConfigNode, node) {
+        userConfig.append({ node->name, node->value });
+    }
+    RzList *res = rz_list_new();
+    RzProjectErr err = rz_project_load_file(core, file.toUtf8().constData(), false, res);
+    rz_list_free(res);
+    for (const auto &option : userConfig) {
+        // Setting a variable may run its callback, so only the changed ones are set
+        const char *value = rz_config_get(core->config, option.first.constData());
+        if (value && option.second != value) {
+            rz_config_set(core->config, option.first.constData(), option.second.constData());
+        }
+    }
+    if (err != RZ_PROJECT_ERR_SUCCESS) {
+        // Damaged or not readable by this rizin anymore
+        QFile::remove(file);
+        return false;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    // The modification time tells the eviction which projects were used recently
+    QFile used(file);
+    if (used.open(QIODevice::ReadWrite)) {
+        used.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+#endif
+    return true;
+}
+
+bool AnalysisCache::store(RzCore *core, const QString &key)
+{
+    if (!QDir().mkpath(directory())) {
+        return false;
+    }
+    QString file = projectFile(key);
+    // Other processes, e.g. in batch mode, may store the same key at the same time
+    QString temporary = QString("%1.%2.tmp").arg(file).arg(QCoreApplication::applicationPid());
+
+    QByteArray userProject = rz_config_get(core->config, "prj.file");
+    RzProjectErr err = rz_project_save_file(core, temporary.toUtf8().constData(), false);
+    rz_config_set(core->config, "prj.file", userProject.constData());
+    if (err != RZ_PROJECT_ERR_SUCCESS) {
+        QFile::remove(temporary);
+        return false;
+    }
+    QFile::remove(file);
+    if (!QFile::rename(temporary, file)) {
+        QFile::remove(temporary);
+        return false;
+    }
+    return true;
+}
+
+QString AnalysisCache::directory()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+            .filePath("analysis");
+}
+
+qint64 AnalysisCache::size()
+{
+    qint64 total = 0;
+    for (const QFileInfo &info : cachedProjects()) {
+        total += info.size();
+    }
+    return total;
+}
+
+void AnalysisCache::evict(qint64 maxSize)
+{
+    QFileInfoList projects = cachedProjects();
+    qint64 total = 0;
+    for (const QFileInfo &info : projects) {
+        total += info.size();
+    }
+    for (const QFileInfo &info : projects) {
+        if (total <= maxSize) {
+            break;
+        }
+        if (QFile::remove(info.filePath())) {
+            total -= info.size();
+        }
+    }
+}
+
+void AnalysisCache::clear()
+{
+    evict(0);
+}
+
+QString AnalysisCache::projectFile(const QString &key)
+{
+    return QDir(directory()).filePath(key + ".rzdb");
+}
@@ -0,0 +1,54 @@
+#ifndef ANALYSISCACHE_H
+#define ANALYSISCACHE_H
+
+#include "core/CutterCommon.h"
+#include "common/InitialOptions.h"
+
+#include <QString>
+
+/**
+ * @brief Projects of earlier analyses, reused when the same file is analyzed the same way again
+ *
+ * The key of an analysis is a hash of the content of the file, the Cutter and rizin versions,
+ * the options and the analysis commands, and of the analysis, asm and bin configuration once the
+ * file is loaded. Only the analysis state is taken from a cached project, the file itself is
+ * loaded as usual and the configuration of the user is kept. Least recently used projects are
+ * removed once the cache exceeds the size set in the configuration. The cache is disabled by
+ * default.
+ */
+class CUTTER_EXPORT AnalysisCache
+{
+public:
+    /**
+     * @brief Hash of the files read by the analysis of \p options, without using the core
+     *
+     * Hashing large files takes a while, so this should be called before locking the core.
+     * Empty if the analysis can't be cached, e.g. if the file can't be read.
+     */
+    static QByteArray inputHash(const InitialOptions &options);
+
+    /**
+     * @brief Key of analyzing the file of \p options, which \p core has loaded already
+     * @param inputHash the result of inputHash()
+     */
+    static QString key(RzCore *core, const InitialOptions &options, const QByteArray &inputHash);
+
+    /**
+     * @brief Restore the analysis cached for \p key into \p core
+     * @return false if there is none or it could not be loaded
+     */
+    static bool load(RzCore *core, const QString &key);
+    static bool store(RzCore *core, const QString &key);
+
+    static QString directory();
+    /// Total size of the cached projects in bytes
+    static qint64 size();
+    /// Remove the least recently used projects until the cache fits into \p maxSize bytes
+    static void evict(qint64 maxSize);
+    static void clear();
+
+private:
+    static QString projectFile(const QString &key);
+};
+
+#endif // ANALYSISCACHE_H
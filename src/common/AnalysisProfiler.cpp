@@ -0,0 +1,201 @@
+#include "common/AnalysisProfiler.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#ifdef Q_OS_WIN
+#    include <windows.h>
+#    include <psapi.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+namespace {
+
+thread_local AnalysisProfiler *currentProfiler = nullptr;
+
+void processUsage(qint64 *cpuUs, qint64 *peakRssKb)
+{
+    *cpuUs = 0;
+    *peakRssKb = 0;
+#ifdef Q_OS_WIN
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        // In units of 100 ns
+        auto toUs = [](const FILETIME &time) {
+            return ((static_cast<qint64>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10;
+        };
+        *cpuUs = toUs(kernel) + toUs(user);
+    }
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        *peakRssKb = static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+    }
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        *cpuUs = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000LL
+                + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#    ifdef Q_OS_MACOS
+        // In bytes on macOS
+        *peakRssKb = usage.ru_maxrss / 1024;
+#    else
+        *peakRssKb = usage.ru_maxrss;
+#    endif
+    }
+#endif
+}
+
+QString formatDelta(qint64 value)
+{
+    return value > 0 ? QStringLiteral("+%1").arg(value) : QString::number(value);
+}
+
+}
+
+AnalysisProfiler::Scope::Scope(RzCore *core, const QString &name)
+    : profiler(currentProfiler), core(core)
+{
+    if (profiler) {
+        profiler->begin(core, name);
+    }
+}
+
+AnalysisProfiler::Scope::~Scope()
+{
+    if (profiler) {
+        profiler->end(core);
+    }
+}
+
+void AnalysisProfiler::activate()
+{
+    stages.clear();
+    open.clear();
+    timer.start();
+    currentProfiler = this;
+}
+
+void AnalysisProfiler::deactivate()
+{
+    if (currentProfiler == this) {
+        currentProfiler = nullptr;
+    }
+}
+
+AnalysisProfiler::Sample AnalysisProfiler::sample(RzCore *core) const
+{
+    Sample sample;
+    sample.wallUs = timer.nsecsElapsed() / 1000;
+    processUsage(&sample.cpuUs, &sample.peakRssKb);
+    sample.functions = rz_list_length(core->analysis->fcns);
+    sample.xrefs = static_cast<qint64>(rz_analysis_xrefs_count(core->analysis));
+    sample.flags = rz_flag_count(core->flags, "*");
+    return sample;
+}
+
+void AnalysisProfiler::begin(RzCore *core, const QString &name)
+{
+    Stage stage;
+    stage.name = name;
+    stage.depth = open.size();
+    stages.append(stage);
+    open.append({ stages.size() - 1, sample(core) });
+}
+
+void AnalysisProfiler::end(RzCore *core)
+{
+    if (open.isEmpty()) {
+        return;
+    }
+    QPair<int, Sample> started = open.takeLast();
+    const Sample &before = started.second;
+    Sample after = sample(core);
+    Stage &stage = stages[started.first];
+    stage.startUs = before.wallUs;
+    stage.wallUs = after.wallUs - before.wallUs;
+    stage.cpuUs = after.cpuUs - before.cpuUs;
+    stage.peakRssKb = after.peakRssKb - before.peakRssKb;
+    stage.functions = after.functions - before.functions;
+    stage.xrefs = after.xrefs - before.xrefs;
+    stage.flags = after.flags - before.flags;
+}
+
+QString AnalysisProfiler::summary() const
+{
+    QStringList names;
+    int nameWidth = tr("Stage").size();
+    for (const Stage &stage : stages) {
+        names.append(QString(stage.depth * 2, QLatin1Char(' ')) + stage.name);
+        nameWidth = qMax(nameWidth, names.last().size());
+    }
+
+    auto row = [nameWidth](const QString &name, const QStringList &columns) {
+        QString line = QStringLiteral("%1").arg(name, -nameWidth);
+        for (const QString &column : columns) {
+            line += QStringLiteral("  %1").arg(column, 10);
+        }
+        return line;
+    };
+    QStringList lines;
+    lines.append(row(tr("Stage"),
+                     { tr("Wall ms"), tr("CPU ms"), tr("Peak KB"), tr("Functions"), tr("Xrefs"),
+                       tr("Flags") }));
+    for (int i = 0; i < stages.size(); i++) {
+        const Stage &stage = stages.at(i);
+        lines.append(row(names.at(i),
+                         { QString::number(stage.wallUs / 1000.0, 'f', 1),
+                           QString::number(stage.cpuUs / 1000.0, 'f', 1),
+                           formatDelta(stage.peakRssKb), formatDelta(stage.functions),
+                           formatDelta(stage.xrefs), formatDelta(stage.flags) }));
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+QByteArray AnalysisProfiler::toTraceJson() const
+{
+    double pid = static_cast<double>(QCoreApplication::applicationPid());
+    QJsonArray events;
+    for (const Stage &stage : stages) {
+        QJsonObject args;
+        args["cpu_ms"] = stage.cpuUs / 1000.0;
+        args["peak_rss_delta_kb"] = static_cast<double>(stage.peakRssKb);
+        args["functions"] = static_cast<double>(stage.functions);
+        args["xrefs"] = static_cast<double>(stage.xrefs);
+        args["flags"] = static_cast<double>(stage.flags);
+
+        // Complete events, nesting follows from the times
+        QJsonObject event;
+        event["name"] = stage.name;
+        event["cat"] = "analysis";
+        event["ph"] = "X";
+        event["ts"] = static_cast<double>(stage.startUs);
+        event["dur"] = static_cast<double>(stage.wallUs);
+        event["pid"] = pid;
+        event["tid"] = 1;
+        event["args"] = args;
+        events.append(event);
+    }
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+    return QJsonDocument(root).toJson();
+}
+
+bool AnalysisProfiler::saveTrace(const QString &file, QString *error) const
+{
+    QFile output(file);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *error = output.errorString();
+        return false;
+    }
+    QByteArray json = toTraceJson();
+    if (output.write(json) != json.size()) {
+        *error = output.errorString();
+        return false;
+    }
+    return true;
+}
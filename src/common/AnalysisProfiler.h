@@ -0,0 +1,94 @@
+#ifndef ANALYSISPROFILER_H
+#define ANALYSISPROFILER_H
+
+#include "core/CutterCommon.h"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+/**
+ * @brief Wall time, CPU time, memory and analysis results of the stages of an analysis
+ *
+ * Stages are recorded with Scope, which does nothing unless a profiler is active on the current
+ * thread, so code shared with other callers, like CutterCore::loadFile(), can be instrumented
+ * too. Stages started inside another one are nested in it. The stages can be shown as a table or
+ * exported in the Trace Event Format read by chrome://tracing and Perfetto.
+ */
+class CUTTER_EXPORT AnalysisProfiler
+{
+    Q_DECLARE_TR_FUNCTIONS(AnalysisProfiler)
+
+public:
+    struct Stage
+    {
+        QString name;
+        /// Number of stages this one is nested in
+        int depth = 0;
+        /// Start relative to the activation of the profiler
+        qint64 startUs = 0;
+        qint64 wallUs = 0;
+        /// CPU time of the whole process, including other threads
+        qint64 cpuUs = 0;
+        /// Growth of the peak resident set size of the process
+        qint64 peakRssKb = 0;
+        /// Number of functions, xrefs and flags added, negative if some were removed
+        qint64 functions = 0;
+        qint64 xrefs = 0;
+        qint64 flags = 0;
+    };
+
+    /**
+     * @brief Stage lasting until the end of the scope, requires exclusive access to the core
+     */
+    class Scope
+    {
+    public:
+        Scope(RzCore *core, const QString &name);
+        ~Scope();
+
+    private:
+        AnalysisProfiler *profiler;
+        RzCore *core;
+    };
+
+    /**
+     * @brief Record the stages of the current thread into this profiler until deactivate()
+     */
+    void activate();
+    void deactivate();
+
+    const QList<Stage> &getStages() const { return stages; }
+
+    /**
+     * @brief Table of the stages with one line per stage, for the log of the task
+     */
+    QString summary() const;
+    QByteArray toTraceJson() const;
+    bool saveTrace(const QString &file, QString *error) const;
+
+private:
+    struct Sample
+    {
+        qint64 wallUs;
+        qint64 cpuUs;
+        qint64 peakRssKb;
+        qint64 functions;
+        qint64 xrefs;
+        qint64 flags;
+    };
+
+    Sample sample(RzCore *core) const;
+    void begin(RzCore *core, const QString &name);
+    void end(RzCore *core);
+
+    QElapsedTimer timer;
+    QList<Stage> stages;
+    /// Stages which were started but not ended yet, with the sample at their start
+    QList<QPair<int, Sample>> open;
+};
+
+#endif // ANALYSISPROFILER_H
@@ -1,5 +1,7 @@
 #include "core/Cutter.h"
 #include "common/AnalysisTask.h"
+#include "common/AnalysisCache.h"
+#include "common/Configuration.h"
 #include "core/MainWindow.h"
 #include "dialogs/InitialOptionsDialog.h"
 #include <QJsonArray>
@@ -14,6 +16,12 @@ void AnalysisTask::interrupt()
 {
     AsyncTask::interrupt();
     rz_cons_singleton()->context->breaked = true;
+    resumed.release();
+}
+
+void AnalysisTask::resume()
+{
+    resumed.release();
 }
 
 QString AnalysisTask::getTitle()
@@ -28,6 +36,26 @@ QString AnalysisTask::getTitle()
 }
 
 void AnalysisTask::runTask()
+{
+    profiler.activate();
+    analyze();
+    profiler.deactivate();
+
+    if (profiler.getStages().isEmpty()) {
+        return;
+    }
+    QString summary = profiler.summary();
+    log(summary);
+    Core()->message(summary);
+    if (!options.analysisTraceFile.isEmpty()) {
+        QString error;
+        if (!profiler.saveTrace(options.analysisTraceFile, &error)) {
+            log(tr("Failed to save the analysis trace: %1").arg(error));
+        }
+    }
+}
+
+bool AnalysisTask::prepare()
 {
     int perms = RZ_PERM_RX;
     if (options.writeEnabled) {
@@ -44,23 +72,25 @@ void AnalysisTask::runTask()
     if (rz_list_empty(descs) && options.filename.length()) {
         log(tr("Loading the file..."));
         openFailed = false;
-        bool fileLoaded =
+        AnalysisProfiler::Scope scope(core, tr("Load the file"));
+        bool loaded =
                 Core()->loadFile(options.filename, options.binLoadAddr, options.mapAddr, perms,
                                  options.useVA, options.loadBinInfo, options.forceBinPlugin);
-        if (!fileLoaded) {
+        if (!loaded) {
             // Something wrong happened, fallback to open dialog
             openFailed = true;
             emit openFileFailed();
             interrupt();
-            return;
+            return false;
         }
+        fileLoaded = true;
     }
 
     // rz_core_bin_load might change asm.bits, so let's set that after the bin is loaded
     Core()->setCPU(options.arch, options.cpu, options.bits);
 
     if (isInterrupted()) {
-        return;
+        return false;
     }
 
     if (!options.os.isNull()) {
@@ -70,11 +100,12 @@ void AnalysisTask::runTask()
 
     if (!options.pdbFile.isNull()) {
         log(tr("Loading PDB file..."));
+        AnalysisProfiler::Scope scope(core, tr("Load the PDB file"));
         Core()->loadPDB(options.pdbFile);
     }
 
     if (isInterrupted()) {
-        return;
+        return false;
     }
 
     if (!options.shellcode.isNull() && options.shellcode.size() / 2 > 0) {
@@ -90,25 +121,110 @@ void AnalysisTask::runTask()
 
     if (!options.script.isNull()) {
         log(tr("Executing script..."));
+        AnalysisProfiler::Scope scope(core, tr("Execute the script"));
         Core()->loadScript(options.script);
     }
 
-    if (isInterrupted()) {
+    return !isInterrupted();
+}
+
+void AnalysisTask::analyze()
+{
+    if (!prepare()) {
+        return;
+    }
+
+    QList<CommandDescription> commands;
+    for (const CommandDescription &cmd : options.analysisCmd) {
+        if (cmd.command == "aaa" || cmd.command == "aaaa") {
+            // The core is locked during the whole command, which may take minutes. Batch mode
+            // runs the same steps, so that both give the same results for a file.
+            log(tr("Running %1 as separate steps").arg(cmd.command));
+            commands += autoAnalysisSteps(cmd.command == "aaaa");
+        } else {
+            commands.append(cmd);
+        }
+    }
+    if (commands.isEmpty()) {
+        log(tr("Skipping Analysis."));
         return;
     }
 
-    if (!options.analysisCmd.empty()) {
-        log(tr("Executing analysis..."));
-        for (const CommandDescription &cmd : options.analysisCmd) {
-            if (isInterrupted()) {
-                return;
-            }
-            log(cmd.description);
+    QString cacheKey;
+    if (fileLoaded && Config()->getAnalysisCacheEnabled()) {
+        // Large files take a while to hash, so the core is not locked meanwhile
+        QByteArray inputHash = AnalysisCache::inputHash(options);
+        RzCoreLocked core(Core());
+        AnalysisProfiler::Scope scope(core, tr("Look up the analysis cache"));
+        cacheKey = AnalysisCache::key(core, options, inputHash);
+        if (!cacheKey.isEmpty() && AnalysisCache::load(core, cacheKey)) {
+            log(tr("Loaded the analysis from the cache."));
+            return;
+        }
+    }
+
+    // A newly loaded file can be browsed right away, a reanalysis after its first command
+    publishTimer.start();
+    if (fileLoaded) {
+        publish();
+    }
+    log(tr("Executing analysis..."));
+    for (int i = 0; i < commands.size(); i++) {
+        if (isInterrupted()) {
+            return;
+        }
+        const CommandDescription &cmd = commands.at(i);
+        log(cmd.description);
+        emit progressChanged(i, commands.size(), cmd.description);
+        {
+            // The core is only locked during each command, so the UI can use it in between
+            RzCoreLocked core(Core());
+            AnalysisProfiler::Scope scope(core, cmd.command);
             // use cmd instead of cmdRaw because commands can be unexpected
             Core()->cmd(cmd.command);
         }
-        log(tr("Analysis complete!"));
-    } else {
-        log(tr("Skipping Analysis."));
+        if (i + 1 < commands.size() && publishTimer.elapsed() >= PublishInterval) {
+            publish();
+        }
+    }
+    log(tr("Analysis complete!"));
+
+    if (!cacheKey.isEmpty() && !isInterrupted()) {
+        RzCoreLocked core(Core());
+        AnalysisProfiler::Scope scope(core, tr("Store the analysis in the cache"));
+        if (AnalysisCache::store(core, cacheKey)) {
+            AnalysisCache::evict(Config()->getAnalysisCacheSizeLimit() * qint64(1024 * 1024));
+        }
+    }
+}
+
+QList<CommandDescription> AnalysisTask::autoAnalysisSteps(bool experimental)
+{
+    // Same steps as rz_core_analysis_everything() of rizin 0.8, the version in
+    // cmake/BundledRizin.cmake, which implements aaa and aaaa. Compare them when updating rizin.
+    QList<CommandDescription> steps = {
+        { "aa", tr("Analyze all symbols and the entry point") },
+        { "aac", tr("Analyze function calls") },
+        { "aar", tr("Analyze references") },
+        { "avrr", tr("Recover class information from RTTI") },
+        { "aaft", tr("Type and argument matching analysis") },
+        { "aanr", tr("Propagate noreturn information") },
+    };
+    if (experimental) {
+        steps.append({ "aap", tr("Analyze function preludes") });
+        steps.append({ "e analysis.types.constraint=true",
+                       tr("Enable constraint types analysis for variables") });
+    }
+    return steps;
+}
+
+void AnalysisTask::publish()
+{
+    if (!publishing || isInterrupted()) {
+        return;
     }
+    resumed.tryAcquire(resumed.available());
+    emit resultsAvailable();
+    resumed.tryAcquire(1, ResumeTimeout);
+    publishTimer.start();
 }
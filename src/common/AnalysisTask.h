@@ -4,6 +4,10 @@
 #include "common/AsyncTask.h"
 #include "core/Cutter.h"
 #include "common/InitialOptions.h"
+#include "common/AnalysisProfiler.h"
+
+#include <QElapsedTimer>
+#include <QSemaphore>
 
 class CutterCore;
 class MainWindow;
@@ -24,17 +28,52 @@ public:
     void interrupt() override;
 
     bool getOpenFileFailed() { return openFailed; }
+    const AnalysisProfiler &getProfiler() const { return profiler; }
+
+    /**
+     * @brief Emit resultsAvailable() while the analysis runs, so the file can be browsed
+     */
+    void setPublishResults(bool publish) { publishing = publish; }
+    /**
+     * @brief Continue the analysis after resultsAvailable()
+     */
+    void resume();
 
 protected:
     void runTask() override;
 
 signals:
     void openFileFailed();
+    /**
+     * @brief Once the file is loaded and then between the analysis commands, at most every
+     * PublishInterval
+     *
+     * The core is not locked meanwhile. The analysis waits until resume() is called, or at most
+     * ResumeTimeout, so the UI can refresh from the partial results without competing for the
+     * core with the next command.
+     */
+    void resultsAvailable();
+    void progressChanged(int step, int steps, const QString &description);
 
 private:
+    static constexpr int PublishInterval = 1000;
+    static constexpr int ResumeTimeout = 5000;
+
+    /// Load and set up the file, false if the task should stop
+    bool prepare();
+    void analyze();
+    /// aaa, or aaaa if \p experimental, split into the commands it runs
+    static QList<CommandDescription> autoAnalysisSteps(bool experimental);
+    void publish();
+
     InitialOptions options;
+    AnalysisProfiler profiler;
 
     bool openFailed = false;
+    bool fileLoaded = false;
+    bool publishing = false;
+    QSemaphore resumed;
+    QElapsedTimer publishTimer;
 };
 
 #endif // ANALTHREAD_H
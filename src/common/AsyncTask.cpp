@@ -1,5 +1,7 @@
 
 #include "AsyncTask.h"
+#include "common/StallWatchdog.h"
+#include "core/CoreLockProfiler.h"
 
 AsyncTask::AsyncTask() : QObject(nullptr), QRunnable()
 {
@@ -47,7 +49,13 @@ void AsyncTask::run()
 
     logBuffer.clear();
     emit logChanged(logBuffer);
-    runTask();
+    const char *name = CoreLockProfiler::internName(getTitle(), metaObject()->className());
+    StallWatchdog::taskStarted(this, name);
+    {
+        CoreLockScope scope(name);
+        runTask();
+    }
+    StallWatchdog::taskFinished(this);
 
     running = false;
 
@@ -69,7 +77,7 @@ AsyncTaskManager::AsyncTaskManager(QObject *parent) : QObject(parent)
 
 AsyncTaskManager::~AsyncTaskManager() {}
 
-void AsyncTaskManager::start(AsyncTask::Ptr task)
+void AsyncTaskManager::start(AsyncTask::Ptr task, Priority priority)
 {
     tasks.append(task);
     task->prepareRun();
@@ -79,10 +87,34 @@ void AsyncTaskManager::start(AsyncTask::Ptr task)
         tasks.removeOne(weakPtr);
         emit tasksChanged();
     });
-    threadPool->start(task.data());
+    threadPool->start(task.data(), priority);
     emit tasksChanged();
 }
 
+void AsyncTaskManager::replace(const QString &key, AsyncTask::Ptr task, Priority priority)
+{
+    AsyncTask::Ptr previous = keyedTasks.value(key);
+    if (previous) {
+        if (threadPool->tryTake(previous.data())) {
+            // Never started, so it won't emit finished either
+            tasks.removeOne(previous);
+            emit tasksChanged();
+        } else {
+            previous->interrupt();
+        }
+    }
+    keyedTasks.insert(key, task);
+
+    QWeakPointer<AsyncTask> weakPtr = task;
+    connect(task.data(), &AsyncTask::finished, this, [this, key, weakPtr]() {
+        auto it = keyedTasks.find(key);
+        if (it != keyedTasks.end() && *it == weakPtr) {
+            keyedTasks.erase(it);
+        }
+    });
+    start(task, priority);
+}
+
 bool AsyncTaskManager::getTasksRunning()
 {
     return !tasks.isEmpty();
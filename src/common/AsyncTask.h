@@ -10,6 +10,7 @@
 #include <QElapsedTimer>
 #include <QSharedPointer>
 #include <QList>
+#include <QHash>
 
 class AsyncTaskManager;
 
@@ -59,19 +60,45 @@ private:
     void prepareRun();
 };
 
+/**
+ * @brief Runs the AsyncTasks in a thread pool, the queued ones by priority
+ *
+ * Tasks started with replace() are coalesced by their key: a new task takes the place of the
+ * previous one of the same key, which is dropped if it is still queued or interrupted if it is
+ * already running. The caller should ignore the results of a replaced task, e.g. by comparing
+ * it with its current task, as they may still arrive from a task which doesn't check
+ * AsyncTask::isInterrupted().
+ */
 class AsyncTaskManager : public QObject
 {
     Q_OBJECT
 
+public:
+    /// Queued tasks of a higher priority start first, running tasks are never preempted
+    enum Priority {
+        /// Results nobody is waiting for yet
+        PrefetchPriority = 0,
+        /// Results for a widget that is not visible
+        HiddenPriority = 1,
+        /// Results for a visible widget, or tasks started by the user
+        VisiblePriority = 2,
+    };
+
 private:
     QThreadPool *threadPool;
     QList<AsyncTask::Ptr> tasks;
+    /// Most recent task of each key passed to replace()
+    QHash<QString, AsyncTask::Ptr> keyedTasks;
 
 public:
     explicit AsyncTaskManager(QObject *parent = nullptr);
     ~AsyncTaskManager();
 
-    void start(AsyncTask::Ptr task);
+    void start(AsyncTask::Ptr task, Priority priority = VisiblePriority);
+    /**
+     * @brief Start \p task in place of the previous task of \p key, without waiting for it
+     */
+    void replace(const QString &key, AsyncTask::Ptr task, Priority priority = VisiblePriority);
     bool getTasksRunning();
 
 signals:
@@ -0,0 +1,165 @@
+#include "common/BatchAnalysis.h"
+#include "common/AnalysisTask.h"
+#include "common/Helpers.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+
+#include <cstdio>
+
+BatchAnalysis::BatchAnalysis(const InitialOptions &options, const QStringList &files,
+                             const QString &outputDir, int jobs, const QStringList &workerArgs,
+                             QObject *parent)
+    : QObject(parent),
+      options(options),
+      files(files),
+      outputDir(outputDir),
+      jobs(qMax(jobs, 1)),
+      workerArgs(workerArgs)
+{
+}
+
+void BatchAnalysis::start()
+{
+    if (files.isEmpty()) {
+        emit finished(0);
+    } else if (files.size() == 1) {
+        analyzeFile(files.first());
+    } else {
+        startWorkers();
+    }
+}
+
+QString BatchAnalysis::projectFileName(const QString &file, const QString &outputDir)
+{
+    QString name = QString("%1.%2").arg(file).arg("rzdb");
+    if (outputDir.isEmpty()) {
+        return name;
+    }
+    return QDir(outputDir).filePath(QFileInfo(name).fileName());
+}
+
+void BatchAnalysis::analyzeFile(const QString &file)
+{
+    QString projectFile = projectFileName(file, outputDir);
+    InitialOptions fileOptions = options;
+    fileOptions.filename = file;
+    fileOptions.projectFile.clear();
+    if (!fileOptions.analysisTraceFile.isEmpty()) {
+        // One trace per file, the workers all get the same options
+        fileOptions.analysisTraceFile = projectFile + ".trace.json";
+    }
+
+    AnalysisTask *analysisTask = new AnalysisTask();
+    analysisTask->setOptions(fileOptions);
+
+    // The log is passed as a whole each time, only print what was added
+    int printed = 0;
+    connect(analysisTask, &AsyncTask::logChanged, this,
+            [this, file, printed](const QString &log) mutable {
+                if (log.size() < printed) {
+                    printed = 0;
+                }
+                const QString added = log.mid(printed);
+                for (const QString &line : added.split('\n', CUTTER_QT_SKIP_EMPTY_PARTS)) {
+                    print(QString("%1: %2").arg(file, line));
+                }
+                printed = log.size();
+            });
+    connect(analysisTask, &AsyncTask::finished, this, [this, analysisTask, file, projectFile]() {
+        if (analysisTask->getOpenFileFailed()) {
+            print(tr("%1: Failed to open the file").arg(file));
+            emit finished(1);
+            return;
+        }
+
+        emit Core()->batchAnalysisFinished(file);
+
+        RzProjectErr err = rz_project_save_file(RzCoreLocked(Core()),
+                                                projectFile.toUtf8().constData(), false);
+        if (err != RZ_PROJECT_ERR_SUCCESS) {
+            const char *s = rz_project_err_message(err);
+            print(QString("%1: %2").arg(
+                    file,
+                    QCoreApplication::translate("MainWindow", "Failed to save project: %1")
+                            .arg(QString::fromUtf8(s))));
+            emit finished(1);
+            return;
+        }
+        print(tr("%1: Saved project %2").arg(file, projectFile));
+        emit finished(0);
+    });
+
+    Core()->getAsyncTaskManager()->start(AsyncTask::Ptr(analysisTask));
+}
+
+void BatchAnalysis::startWorkers()
+{
+    while (running < jobs && next < files.size()) {
+        QString file = files.at(next++);
+        // With --output-dir, files with the same name in different directories would overwrite
+        // each other's project
+        QString projectFile = QFileInfo(projectFileName(file, outputDir)).absoluteFilePath();
+        QString owner = projectOwners.value(projectFile);
+        if (!owner.isEmpty()) {
+            done++;
+            failed++;
+            print(tr("[%1/%2] %3: Failed").arg(done).arg(files.size()).arg(file));
+            print(tr("%1: The project %2 is already saved for %3")
+                          .arg(file, projectFile, owner));
+            continue;
+        }
+        projectOwners.insert(projectFile, file);
+
+        QProcess *process = new QProcess(this);
+        // The output is only shown for the files which fail, the others would drown it
+        process->setProcessChannelMode(QProcess::MergedChannels);
+        connect(process,
+                static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+                this, [this, process, file](int exitCode, QProcess::ExitStatus exitStatus) {
+                    workerFinished(process, file,
+                                   exitStatus == QProcess::NormalExit && exitCode == 0);
+                });
+        connect(process, &QProcess::errorOccurred, this,
+                [this, process, file](QProcess::ProcessError error) {
+                    if (error == QProcess::FailedToStart) {
+                        workerFinished(process, file, false);
+                    }
+                });
+        running++;
+        process->start(QCoreApplication::applicationFilePath(), QStringList(workerArgs) << file);
+    }
+
+    // A worker failing to start may have finished the batch already
+    if (running == 0 && next >= files.size() && !allDone) {
+        allDone = true;
+        print(tr("%1 of %2 files analyzed").arg(files.size() - failed).arg(files.size()));
+        emit finished(failed ? 1 : 0);
+    }
+}
+
+void BatchAnalysis::workerFinished(QProcess *process, const QString &file, bool ok)
+{
+    running--;
+    done++;
+    if (ok) {
+        print(tr("[%1/%2] %3: Done").arg(done).arg(files.size()).arg(file));
+    } else {
+        failed++;
+        print(tr("[%1/%2] %3: Failed").arg(done).arg(files.size()).arg(file));
+        QString output = QString::fromLocal8Bit(process->readAll()).trimmed();
+        if (!output.isEmpty()) {
+            print(output);
+        }
+    }
+    process->deleteLater();
+
+    startWorkers();
+}
+
+void BatchAnalysis::print(const QString &message)
+{
+    fprintf(stderr, "%s\n", message.toLocal8Bit().constData());
+    fflush(stderr);
+}
@@ -0,0 +1,71 @@
+#ifndef BATCHANALYSIS_H
+#define BATCHANALYSIS_H
+
+#include "common/InitialOptions.h"
+
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QStringList>
+
+/**
+ * @brief Analysis of files without any user interface, saving a project for each of them
+ *
+ * A single file is analyzed in this process with AnalysisTask. Several files are each analyzed by
+ * a worker process, which is Cutter started again in batch mode with just that file, so that up
+ * to the given number of files are analyzed in parallel and a file crashing rizin only fails
+ * itself.
+ */
+class BatchAnalysis : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param options options for all files, the filename is set for each of them
+     * @param outputDir directory for the projects, next to the files if empty
+     * @param jobs number of worker processes running at the same time
+     * @param workerArgs command line of a worker, without the file to analyze
+     */
+    BatchAnalysis(const InitialOptions &options, const QStringList &files,
+                  const QString &outputDir, int jobs, const QStringList &workerArgs,
+                  QObject *parent = nullptr);
+
+    /**
+     * @brief Start analyzing the files, finished() is emitted once all of them are done
+     */
+    void start();
+
+    /**
+     * @brief Project file for \p file, named like the one suggested when saving it from the UI
+     */
+    static QString projectFileName(const QString &file, const QString &outputDir);
+
+signals:
+    /**
+     * @param exitCode 0 if all files were analyzed and saved, 1 otherwise
+     */
+    void finished(int exitCode);
+
+private:
+    void analyzeFile(const QString &file);
+    void startWorkers();
+    void workerFinished(QProcess *process, const QString &file, bool ok);
+    void print(const QString &message);
+
+    InitialOptions options;
+    QStringList files;
+    QString outputDir;
+    int jobs;
+    QStringList workerArgs;
+
+    int next = 0;
+    int running = 0;
+    int done = 0;
+    int failed = 0;
+    bool allDone = false;
+    /// File whose project is saved at each path, by absolute path
+    QHash<QString, QString> projectOwners;
+};
+
+#endif // BATCHANALYSIS_H
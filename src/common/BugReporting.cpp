@@ -6,7 +6,7 @@
 #include "CutterConfig.h"
 #include <QDesktopServices>
 
-void openIssue()
+void openIssue(const QString &additionalContext)
 {
     RzCoreLocked core(Core());
     RzBinFile *bf = rz_bin_cur(core->bin);
@@ -38,6 +38,10 @@ void openIssue()
               "**Screenshots**\n\n<!-- If applicable, add screenshots to help explain your "
               "problem. -->\n\n\n"
               "**Additional context**\n\n<!-- Add any other context about the problem here. -->\n";
+    if (!additionalContext.isEmpty()) {
+        url += "\n```\n" + QString::fromUtf8(QUrl::toPercentEncoding(additionalContext))
+                + "\n```\n";
+    }
 
     QDesktopServices::openUrl(QUrl(url, QUrl::TolerantMode));
 }
@@ -1,10 +1,13 @@
 #ifndef CRASHREPORTING_H
 #define CRASHREPORTING_H
 
+#include <QString>
+
 /**
  * @brief Opens issue on Cutter's github page
  * with current file and system information.
+ * @param additionalContext added as a code block, e.g. the log of the StallWatchdog
  */
-void openIssue();
+void openIssue(const QString &additionalContext = QString());
 
 #endif // CRASHREPORTING_H
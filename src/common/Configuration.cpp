@@ -222,6 +222,38 @@ void Configuration::setAutoUpdateEnabled(bool au)
     s.setValue("autoUpdateEnabled", au);
 }
 
+bool Configuration::getAnalysisCacheEnabled() const
+{
+    // Stores a project of every analyzed file, so only if the user asks for it
+    return s.value("analysisCache.enabled", false).toBool();
+}
+
+void Configuration::setAnalysisCacheEnabled(bool enabled)
+{
+    s.setValue("analysisCache.enabled", enabled);
+}
+
+int Configuration::getAnalysisCacheSizeLimit() const
+{
+    return s.value("analysisCache.sizeLimit", 1024).toInt();
+}
+
+void Configuration::setAnalysisCacheSizeLimit(int megabytes)
+{
+    s.setValue("analysisCache.sizeLimit", megabytes);
+}
+
+int Configuration::getStallThreshold() const
+{
+    // Off by default, the watchdog wakes up a thread and a timer several times a second
+    return s.value("stallWatchdog.threshold", 0).toInt();
+}
+
+void Configuration::setStallThreshold(int ms)
+{
+    s.setValue("stallWatchdog.threshold", ms);
+}
+
 /**
  * @brief get the current Locale set in Cutter's user configuration
  * @return a QLocale object describes user's current locale
@@ -70,6 +70,17 @@ public:
     bool getAutoUpdateEnabled() const;
     void setAutoUpdateEnabled(bool au);
 
+    // Analysis cache, see AnalysisCache
+    bool getAnalysisCacheEnabled() const;
+    void setAnalysisCacheEnabled(bool enabled);
+    /// Size limit of the cache in MiB
+    int getAnalysisCacheSizeLimit() const;
+    void setAnalysisCacheSizeLimit(int megabytes);
+
+    /// Shortest interface stall logged by the StallWatchdog in ms, 0 if it is disabled
+    int getStallThreshold() const;
+    void setStallThreshold(int ms);
+
     // Languages
     QLocale getCurrLocale() const;
     void setLocale(const QLocale &l);
@@ -1,8 +1,11 @@
 #include "DisassemblyPreview.h"
 #include "Configuration.h"
+#include "PreviewCache.h"
 #include "widgets/GraphView.h"
 
 #include <QCoreApplication>
+#include <QCursor>
+#include <QPointer>
 #include <QWidget>
 #include <QToolTip>
 #include <QProcessEnvironment>
@@ -32,6 +35,66 @@ QString DisassemblyPreview::getToolTipStyleSheet()
             .arg(Config()->getColor("gui.tooltip.foreground").name());
 }
 
+static QString disasPreviewToolTip(const QStringList &disasmPreview)
+{
+    const QFont &fnt = Config()->getFont();
+    return QString { "<html><div style=\"font-family: %1; font-size: %2pt; "
+                     "white-space: nowrap;\"><div style=\"margin-bottom: "
+                     "10px;\"><strong>Disassembly Preview</strong>:<br>%3<div>" }
+            .arg(fnt.family())
+            .arg(qMax(8, fnt.pointSize() - 1))
+            .arg(disasmPreview.join("<br>"));
+}
+
+namespace {
+
+struct PendingPreview
+{
+    QPointer<QWidget> parent;
+    QPoint pointOfEvent;
+    RVA offset = RVA_INVALID;
+};
+
+PendingPreview pendingPreview;
+
+}
+
+static void showPendingPreview(QWidget *parent, const QPoint &pointOfEvent, RVA offset)
+{
+    static bool connected = false;
+    if (!connected) {
+        PreviewCache *previews = Core()->getPreviewCache();
+        QObject::connect(previews, &PreviewCache::previewReady, previews,
+                         [previews](PreviewCache::Kind kind, RVA address) {
+                             if (kind != PreviewCache::Kind::Disassembly
+                                 || address != pendingPreview.offset) {
+                                 return;
+                             }
+                             QPointer<QWidget> parent = pendingPreview.parent;
+                             QPoint pointOfEvent = pendingPreview.pointOfEvent;
+                             pendingPreview = PendingPreview();
+                             QStringList disasmPreview;
+                             if (!parent || !QToolTip::isVisible()
+                                 || (QCursor::pos() - pointOfEvent).manhattanLength() > 4
+                                 || !previews->lookup(kind, address, &disasmPreview)) {
+                                 return;
+                             }
+                             if (disasmPreview.isEmpty()) {
+                                 QToolTip::hideText();
+                             } else {
+                                 QToolTip::showText(pointOfEvent,
+                                                    disasPreviewToolTip(disasmPreview), parent,
+                                                    QRect {}, 3500);
+                             }
+                         });
+        connected = true;
+    }
+    pendingPreview.parent = parent;
+    pendingPreview.pointOfEvent = pointOfEvent;
+    pendingPreview.offset = offset;
+    QToolTip::showText(pointOfEvent, QObject::tr("Loading preview..."), parent, QRect {}, 3500);
+}
+
 bool DisassemblyPreview::showDisasPreview(QWidget *parent, const QPoint &pointOfEvent,
                                           const RVA offsetFrom)
 {
@@ -49,23 +112,18 @@ bool DisassemblyPreview::showDisasPreview(QWidget *parent, const QPoint &pointOf
          * on *and* the former is a valid offset, we are allowed to get a preview of offsetTo
          */
         if (offsetTo != offsetFrom && offsetTo != RVA_INVALID) {
-            QStringList disasmPreview = Core()->getDisassemblyPreview(offsetTo, 10);
+            QStringList disasmPreview;
+            if (!Core()->getPreviewCache()->lookup(PreviewCache::Kind::Disassembly, offsetTo,
+                                                   &disasmPreview)) {
+                // Generated in the background, shown once ready unless the mouse moved away
+                showPendingPreview(parent, pointOfEvent, offsetTo);
+                return true;
+            }
 
             // Last check to make sure the returned preview isn't an empty text (QStringList)
             if (!disasmPreview.isEmpty()) {
-                const QFont &fnt = Config()->getFont();
-
-                QFontMetrics fm { fnt };
-
-                QString tooltip =
-                        QString { "<html><div style=\"font-family: %1; font-size: %2pt; "
-                                  "white-space: nowrap;\"><div style=\"margin-bottom: "
-                                  "10px;\"><strong>Disassembly Preview</strong>:<br>%3<div>" }
-                                .arg(fnt.family())
-                                .arg(qMax(8, fnt.pointSize() - 1))
-                                .arg(disasmPreview.join("<br>"));
-
-                QToolTip::showText(pointOfEvent, tooltip, parent, QRect {}, 3500);
+                QToolTip::showText(pointOfEvent, disasPreviewToolTip(disasmPreview), parent,
+                                   QRect {}, 3500);
                 return true;
             }
         }
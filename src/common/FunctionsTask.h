@@ -19,7 +19,10 @@ protected:
     void runTask() override
     {
         auto functions = Core()->getAllFunctions();
-        emit fetchFinished(functions);
+        // Superseded by a newer fetch meanwhile
+        if (!isInterrupted()) {
+            emit fetchFinished(functions);
+        }
     }
 };
 
@@ -1,5 +1,6 @@
 #include "common/Helpers.h"
 #include "Configuration.h"
+#include "common/AddressableItemModel.h"
 
 #include <cmath>
 #include <QPlainTextEdit>
@@ -14,6 +15,8 @@
 #include <QDockWidget>
 #include <QMenu>
 #include <QComboBox>
+#include <QCursor>
+#include <QToolTip>
 
 static QAbstractItemView::ScrollMode scrollMode()
 {
@@ -103,6 +106,42 @@ void setVerticalScrollMode(QAbstractItemView *tw)
     tw->setVerticalScrollMode(scrollMode());
 }
 
+void refreshHoveredToolTip(QAbstractItemView *view)
+{
+    if (!QToolTip::isVisible() || !view->isVisible()) {
+        return;
+    }
+    QPoint globalPos = QCursor::pos();
+    QWidget *viewport = view->viewport();
+    QPoint pos = viewport->mapFromGlobal(globalPos);
+    if (!viewport->rect().contains(pos)) {
+        return;
+    }
+    QModelIndex index = view->indexAt(pos);
+    QString text = index.isValid() ? index.data(Qt::ToolTipRole).toString() : QString();
+    if (!text.isEmpty()) {
+        QToolTip::showText(globalPos, text, viewport, view->visualRect(index));
+    }
+}
+
+QList<RVA> neighborAddresses(AddressableItemModelI *model, const QModelIndex &index, int radius)
+{
+    QList<RVA> addresses;
+    if (!index.isValid()) {
+        return addresses;
+    }
+    addresses << model->address(index);
+    for (int distance = 1; distance <= radius; distance++) {
+        for (int row : { index.row() - distance, index.row() + distance }) {
+            QModelIndex neighbor = index.sibling(row, index.column());
+            if (neighbor.isValid()) {
+                addresses << model->address(neighbor);
+            }
+        }
+    }
+    return addresses;
+}
+
 void setCheckedWithoutSignals(QAbstractButton *button, bool checked)
 {
     bool blocked = button->signalsBlocked();
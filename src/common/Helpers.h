@@ -5,6 +5,7 @@
 
 #include <QString>
 #include <QColor>
+#include <QList>
 #include <QSizePolicy>
 #include <functional>
 
@@ -25,6 +26,8 @@ class QPaintDevice;
 class QComboBox;
 class QSortFilterProxyModel;
 class QMouseEvent;
+class QModelIndex;
+class AddressableItemModelI;
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
 #    define CUTTER_QT_SKIP_EMPTY_PARTS QString::SkipEmptyParts
@@ -45,6 +48,18 @@ CUTTER_EXPORT QTreeWidgetItem *appendRow(QTreeWidget *tw, const QString &str,
 
 CUTTER_EXPORT void setVerticalScrollMode(QAbstractItemView *tw);
 
+/**
+ * @brief Show the current Qt::ToolTipRole of the hovered item again if its tooltip is visible,
+ * e.g. when it was generated asynchronously
+ */
+CUTTER_EXPORT void refreshHoveredToolTip(QAbstractItemView *view);
+
+/**
+ * @brief Addresses of \p index and up to \p radius rows above and below it, nearest first
+ */
+CUTTER_EXPORT QList<RVA> neighborAddresses(AddressableItemModelI *model, const QModelIndex &index,
+                                           int radius);
+
 CUTTER_EXPORT void setCheckedWithoutSignals(QAbstractButton *button, bool checked);
 
 struct CUTTER_EXPORT SizePolicyMinMax
@@ -41,6 +41,8 @@ struct InitialOptions
     QString script;
 
     QList<CommandDescription> analysisCmd = { { "aaa", "Auto analysis" } };
+    /// Save the timings of the analysis stages there, see AnalysisProfiler
+    QString analysisTraceFile;
 
     QString shellcode;
 };
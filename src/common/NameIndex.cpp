@@ -0,0 +1,306 @@
+#include "NameIndex.h"
+
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+int NameIndex::kindIndex(Kind kind)
+{
+    switch (kind) {
+    case Kind::Function:
+        return 0;
+    case Kind::Flag:
+        return 1;
+    case Kind::Symbol:
+        return 2;
+    case Kind::String:
+        return 3;
+    case Kind::Import:
+        return 4;
+    case Kind::Section:
+        return 5;
+    }
+    return 0;
+}
+
+QString NameIndex::kindName(Kind kind)
+{
+    switch (kind) {
+    case Kind::Function:
+        return QCoreApplication::translate("NameIndex", "function");
+    case Kind::Flag:
+        return QCoreApplication::translate("NameIndex", "flag");
+    case Kind::Symbol:
+        return QCoreApplication::translate("NameIndex", "symbol");
+    case Kind::String:
+        return QCoreApplication::translate("NameIndex", "string");
+    case Kind::Import:
+        return QCoreApplication::translate("NameIndex", "import");
+    case Kind::Section:
+        return QCoreApplication::translate("NameIndex", "section");
+    }
+    return QString();
+}
+
+static const NameIndex::Kind allKindsList[] = {
+    NameIndex::Kind::Function, NameIndex::Kind::Flag,   NameIndex::Kind::Symbol,
+    NameIndex::Kind::String,   NameIndex::Kind::Import, NameIndex::Kind::Section,
+};
+
+QString NameIndex::fold(const QString &s)
+{
+    return s.toLower();
+}
+
+quint64 NameIndex::trigramAt(const QString &folded, int pos)
+{
+    return (quint64(folded.at(pos).unicode()) << 32)
+            | (quint64(folded.at(pos + 1).unicode()) << 16) | quint64(folded.at(pos + 2).unicode());
+}
+
+bool NameIndex::isPlainSubstring(const QString &filter)
+{
+    for (const QChar c : filter) {
+        // Wildcard syntax, and non-ASCII characters for which toLower() might not match the
+        // case folding done by QRegularExpression.
+        if (c == QLatin1Char('*') || c == QLatin1Char('?') || c == QLatin1Char('[')
+            || c == QLatin1Char(']') || c == QLatin1Char('\\') || c.unicode() >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NameIndex::addPostings(Segment &segment, int id)
+{
+    const QString &folded = segment.folded.at(id);
+    for (int i = 0; i + 3 <= folded.size(); i++) {
+        QVector<int> &list = segment.postings[trigramAt(folded, i)];
+        auto it = std::lower_bound(list.begin(), list.end(), id);
+        if (it == list.end() || *it != id) {
+            list.insert(it, id);
+        }
+    }
+}
+
+void NameIndex::removePostings(Segment &segment, int id)
+{
+    const QString &folded = segment.folded.at(id);
+    for (int i = 0; i + 3 <= folded.size(); i++) {
+        auto postingIt = segment.postings.find(trigramAt(folded, i));
+        if (postingIt == segment.postings.end()) {
+            continue;
+        }
+        QVector<int> &list = postingIt.value();
+        auto it = std::lower_bound(list.begin(), list.end(), id);
+        if (it != list.end() && *it == id) {
+            list.erase(it);
+        }
+        if (list.isEmpty()) {
+            segment.postings.erase(postingIt);
+        }
+    }
+}
+
+void NameIndex::setEntries(Kind kind, const QVector<Entry> &entries)
+{
+    Segment segment;
+    segment.entries = entries;
+    segment.folded.reserve(entries.size());
+    for (int id = 0; id < entries.size(); id++) {
+        segment.folded.append(fold(entries[id].name));
+        segment.entries[id].kind = kind;
+        segment.byOffset.insert(entries[id].offset, id);
+        addPostings(segment, id);
+    }
+
+    QWriteLocker locker(&lock);
+    segments[kindIndex(kind)] = std::move(segment);
+}
+
+void NameIndex::renameEntry(Kind kind, RVA offset, const QString &newName)
+{
+    QWriteLocker locker(&lock);
+    Segment &segment = segments[kindIndex(kind)];
+    for (int id : segment.byOffset.values(offset)) {
+        removePostings(segment, id);
+        segment.entries[id].name = newName;
+        segment.folded[id] = fold(newName);
+        addPostings(segment, id);
+    }
+}
+
+void NameIndex::clear()
+{
+    QWriteLocker locker(&lock);
+    for (Segment &segment : segments) {
+        segment = Segment();
+    }
+}
+
+int NameIndex::count(Kinds kinds) const
+{
+    QReadLocker locker(&lock);
+    int r = 0;
+    for (Kind kind : allKindsList) {
+        if (kinds.testFlag(kind)) {
+            r += segments[kindIndex(kind)].entries.size();
+        }
+    }
+    return r;
+}
+
+QVector<int> NameIndex::candidates(const Segment &segment, const QString &foldedQuery)
+{
+    QVector<int> result;
+    if (foldedQuery.size() < 3) {
+        // Too short for trigrams, every entry is a candidate
+        result.resize(segment.entries.size());
+        std::iota(result.begin(), result.end(), 0);
+        return result;
+    }
+
+    QVector<const QVector<int> *> lists;
+    for (int i = 0; i + 3 <= foldedQuery.size(); i++) {
+        auto it = segment.postings.constFind(trigramAt(foldedQuery, i));
+        if (it == segment.postings.constEnd()) {
+            return {};
+        }
+        if (!lists.contains(&it.value())) {
+            lists.append(&it.value());
+        }
+    }
+
+    // Start with the rarest trigram to keep the intermediate results small
+    std::sort(lists.begin(), lists.end(),
+              [](const QVector<int> *a, const QVector<int> *b) { return a->size() < b->size(); });
+    result = *lists.first();
+    QVector<int> intersection;
+    for (int i = 1; i < lists.size() && !result.isEmpty(); i++) {
+        intersection.clear();
+        std::set_intersection(result.constBegin(), result.constEnd(), lists[i]->constBegin(),
+                              lists[i]->constEnd(), std::back_inserter(intersection));
+        std::swap(result, intersection);
+    }
+    return result;
+}
+
+QList<NameIndex::Entry> NameIndex::find(const QString &substring, Kinds kinds, int limit) const
+{
+    QList<Entry> result;
+    QString query = fold(substring);
+
+    QReadLocker locker(&lock);
+    for (Kind kind : allKindsList) {
+        if (!kinds.testFlag(kind)) {
+            continue;
+        }
+        const Segment &segment = segments[kindIndex(kind)];
+        for (int id : candidates(segment, query)) {
+            // All trigrams being present doesn't mean they are adjacent
+            if (!segment.folded.at(id).contains(query)) {
+                continue;
+            }
+            result.append(segment.entries.at(id));
+            if (limit >= 0 && result.size() >= limit) {
+                return result;
+            }
+        }
+    }
+    return result;
+}
+
+bool NameIndex::forEachEntry(
+        Kinds kinds,
+        const std::function<bool(const Entry &, const QString &folded)> &callback) const
+{
+    // Shallow copies of the implicitly shared vectors, so that the scan doesn't hold the lock
+    // and a writer doesn't wait for it, nor readers for the writer
+    QVector<QVector<Entry>> entries;
+    QVector<QVector<QString>> folded;
+    {
+        QReadLocker locker(&lock);
+        for (Kind kind : allKindsList) {
+            if (kinds.testFlag(kind)) {
+                const Segment &segment = segments[kindIndex(kind)];
+                entries.append(segment.entries);
+                folded.append(segment.folded);
+            }
+        }
+    }
+    for (int i = 0; i < entries.size(); i++) {
+        const QVector<Entry> &segmentEntries = entries.at(i);
+        const QVector<QString> &segmentFolded = folded.at(i);
+        for (int id = 0; id < segmentEntries.size(); id++) {
+            if (!callback(segmentEntries.at(id), segmentFolded.at(id))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool isWordBoundary(const QString &s, int pos)
+{
+    if (pos == 0) {
+        return true;
+    }
+    QChar prev = s.at(pos - 1);
+    return prev == QLatin1Char('.') || prev == QLatin1Char('_') || prev == QLatin1Char(':')
+            || prev == QLatin1Char(' ') || prev == QLatin1Char('@');
+}
+
+int NameIndex::fuzzyScore(const QString &foldedName, const QString &foldedQuery)
+{
+    const int nameLength = foldedName.size();
+    const int queryLength = foldedQuery.size();
+    if (queryLength == 0 || queryLength > nameLength) {
+        return -1;
+    }
+    // Prefer short names among otherwise equal matches
+    const int lengthPenalty = qMin(nameLength - queryLength, 100);
+
+    int pos = foldedName.indexOf(foldedQuery);
+    if (pos == 0) {
+        return (nameLength == queryLength ? 3000 : 2000) - lengthPenalty;
+    }
+    if (pos > 0) {
+        // Substring, prefer the ones starting at a word, e.g. "sym.imp.malloc" for "malloc"
+        int r = 1000 - lengthPenalty - qMin(pos, 100);
+        if (isWordBoundary(foldedName, pos)) {
+            r += 300;
+            if (pos + queryLength == nameLength) {
+                r += 200;
+            }
+        }
+        return r;
+    }
+
+    // Subsequence match, greedy from left to right
+    int score = 0;
+    int namePos = 0;
+    int lastMatch = -2;
+    for (int queryPos = 0; queryPos < queryLength; queryPos++) {
+        QChar c = foldedQuery.at(queryPos);
+        while (namePos < nameLength && foldedName.at(namePos) != c) {
+            namePos++;
+        }
+        if (namePos == nameLength) {
+            return -1;
+        }
+        if (namePos == lastMatch + 1) {
+            score += 15;
+        } else if (lastMatch >= 0) {
+            score -= qMin(namePos - lastMatch - 1, 10);
+        }
+        if (isWordBoundary(foldedName, namePos)) {
+            score += 20;
+        }
+        score += 10;
+        lastMatch = namePos;
+        namePos++;
+    }
+    return qBound(0, score - lengthPenalty, 999);
+}
@@ -0,0 +1,125 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include "core/CutterCommon.h"
+
+#include <QFlags>
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * @brief Case-insensitive substring index over named addresses (functions, flags, ...)
+ *
+ * Every name is split into overlapping trigrams and each trigram maps to a sorted posting list of
+ * entries containing it. A substring query intersects the posting lists of the query's trigrams
+ * and only verifies the remaining candidates, so lookups stay fast even with millions of names.
+ *
+ * The index is split into one segment per Kind so that a change to one kind of names (e.g.
+ * functionsChanged) only rebuilds that segment. All methods are thread-safe.
+ */
+class CUTTER_EXPORT NameIndex
+{
+public:
+    enum class Kind {
+        Function = 1 << 0,
+        Flag = 1 << 1,
+        Symbol = 1 << 2,
+        String = 1 << 3,
+        Import = 1 << 4,
+        Section = 1 << 5,
+    };
+    Q_DECLARE_FLAGS(Kinds, Kind)
+
+    static constexpr int KindCount = 6;
+    static Kinds allKinds()
+    {
+        return Kinds(Kind::Function) | Kind::Flag | Kind::Symbol | Kind::String | Kind::Import
+                | Kind::Section;
+    }
+
+    struct Entry
+    {
+        RVA offset;
+        QString name;
+        Kind kind;
+    };
+
+    NameIndex() = default;
+
+    /**
+     * @brief Replace all entries of \p kind
+     */
+    void setEntries(Kind kind, const QVector<Entry> &entries);
+
+    /**
+     * @brief Rename all entries of \p kind at \p offset without rebuilding the whole segment
+     */
+    void renameEntry(Kind kind, RVA offset, const QString &newName);
+
+    void clear();
+
+    int count(Kinds kinds = allKinds()) const;
+
+    /**
+     * @brief Find all entries whose name contains \p substring, ignoring case
+     * @param limit maximum number of results, -1 for no limit
+     */
+    QList<Entry> find(const QString &substring, Kinds kinds = allKinds(), int limit = -1) const;
+
+    /**
+     * @return true if find() can answer a filter with the same semantics as
+     * QSortFilterProxyModel::setFilterWildcard(), i.e. it contains no wildcard characters.
+     */
+    static bool isPlainSubstring(const QString &filter);
+
+    /**
+     * @brief Call \p callback for every entry of \p kinds with its lowercase name
+     * The entries are those of the index when the call starts, changes made meanwhile, also by
+     * \p callback, are not seen.
+     * @return false if \p callback returned false to stop the iteration
+     */
+    bool forEachEntry(
+            Kinds kinds,
+            const std::function<bool(const Entry &, const QString &folded)> &callback) const;
+
+    /**
+     * @brief Score how well \p foldedQuery fuzzily matches \p foldedName
+     *
+     * All characters of the query must appear in order in the name. Exact, prefix and substring
+     * matches rank highest, followed by subsequence matches starting at word boundaries or with
+     * consecutive characters. Shorter names rank higher.
+     *
+     * @return the score (higher is better) or -1 if the query doesn't match
+     */
+    static int fuzzyScore(const QString &foldedName, const QString &foldedQuery);
+
+    static QString fold(const QString &s);
+    static QString kindName(Kind kind);
+
+private:
+    struct Segment
+    {
+        QVector<Entry> entries;
+        QVector<QString> folded;
+        QHash<quint64, QVector<int>> postings;
+        QMultiHash<RVA, int> byOffset;
+    };
+
+    static int kindIndex(Kind kind);
+    static quint64 trigramAt(const QString &folded, int pos);
+    static void addPostings(Segment &segment, int id);
+    static void removePostings(Segment &segment, int id);
+    static QVector<int> candidates(const Segment &segment, const QString &foldedQuery);
+
+    mutable QReadWriteLock lock;
+    Segment segments[KindCount];
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(NameIndex::Kinds)
+
+#endif // NAMEINDEX_H
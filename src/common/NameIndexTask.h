@@ -0,0 +1,27 @@
+#ifndef NAMEINDEXTASK_H
+#define NAMEINDEXTASK_H
+
+#include "common/AsyncTask.h"
+#include "core/Cutter.h"
+
+/**
+ * @brief Reindexes the outdated segments of the NameIndex, see CutterCore::requestNameIndex()
+ */
+class NameIndexTask : public AsyncTask
+{
+    Q_OBJECT
+
+public:
+    explicit NameIndexTask(NameIndex::Kinds kinds) : kinds(kinds) {}
+
+    QString getTitle() override { return tr("Indexing Names"); }
+    NameIndex::Kinds getKinds() const { return kinds; }
+
+protected:
+    void runTask() override { Core()->updateNameIndex(kinds); }
+
+private:
+    NameIndex::Kinds kinds;
+};
+
+#endif // NAMEINDEXTASK_H
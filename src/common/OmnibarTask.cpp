@@ -0,0 +1,124 @@
+#include "OmnibarTask.h"
+
+#include <QElapsedTimer>
+#include <QSet>
+
+#include <algorithm>
+
+namespace {
+
+// Check for interruption and publish intermediate results every this many entries
+constexpr int kCheckInterval = 0x4000;
+constexpr qint64 kPublishIntervalMs = 100;
+// Keep more candidates than requested, duplicates at the same address are removed at the end
+constexpr int kCandidatesFactor = 4;
+constexpr int kRecentSeeks = 20;
+
+int kindBonus(NameIndex::Kind kind)
+{
+    switch (kind) {
+    case NameIndex::Kind::Function:
+        return 60;
+    case NameIndex::Kind::Import:
+        return 40;
+    case NameIndex::Kind::Symbol:
+        return 30;
+    case NameIndex::Kind::Flag:
+        return 20;
+    case NameIndex::Kind::Section:
+        return 10;
+    case NameIndex::Kind::String:
+        return 0;
+    }
+    return 0;
+}
+
+// Sorts best first, or makes heap.first() the worst match when used with std::push_heap
+bool scoreGreater(const OmnibarMatch &a, const OmnibarMatch &b)
+{
+    return a.score > b.score;
+}
+
+}
+
+OmnibarTask::OmnibarTask(const QString &query, const QList<RVA> &seekHistory, int maxResults)
+    : query(query), maxResults(maxResults)
+{
+    int bonus = 200;
+    for (int i = seekHistory.size() - 1; i >= 0 && bonus > 0; i--) {
+        if (!recencyBonus.contains(seekHistory[i])) {
+            recencyBonus.insert(seekHistory[i], bonus);
+            bonus -= 200 / kRecentSeeks;
+        }
+    }
+}
+
+QList<OmnibarMatch> OmnibarTask::sortedMatches(const QVector<OmnibarMatch> &heap) const
+{
+    QVector<OmnibarMatch> matches = heap;
+    std::sort(matches.begin(), matches.end(), scoreGreater);
+
+    QList<OmnibarMatch> r;
+    QSet<RVA> offsets;
+    for (const OmnibarMatch &match : matches) {
+        if (offsets.contains(match.offset)) {
+            continue;
+        }
+        offsets.insert(match.offset);
+        r.append(match);
+        if (r.size() >= maxResults) {
+            break;
+        }
+    }
+    return r;
+}
+
+void OmnibarTask::runTask()
+{
+    // Reindex whatever changed since the last lookup, this may take the core lock
+    Core()->updateNameIndex(NameIndex::allKinds());
+    if (isInterrupted()) {
+        return;
+    }
+
+    const QString foldedQuery = NameIndex::fold(query);
+    const int capacity = maxResults * kCandidatesFactor;
+    QVector<OmnibarMatch> heap; // min-heap on score
+    heap.reserve(capacity + 1);
+
+    QElapsedTimer publishTimer;
+    publishTimer.start();
+    int counter = 0;
+
+    bool complete = Core()->getNameIndex().forEachEntry(
+            NameIndex::allKinds(),
+            [&](const NameIndex::Entry &entry, const QString &folded) {
+                int score = NameIndex::fuzzyScore(folded, foldedQuery);
+                if (score >= 0) {
+                    score += kindBonus(entry.kind) + recencyBonus.value(entry.offset, 0);
+                    if (heap.size() < capacity || score > heap.first().score) {
+                        heap.append({ entry.offset, entry.name, entry.kind, score });
+                        std::push_heap(heap.begin(), heap.end(), scoreGreater);
+                        if (heap.size() > capacity) {
+                            std::pop_heap(heap.begin(), heap.end(), scoreGreater);
+                            heap.removeLast();
+                        }
+                    }
+                }
+
+                if (++counter % kCheckInterval == 0) {
+                    if (isInterrupted()) {
+                        return false;
+                    }
+                    if (publishTimer.elapsed() > kPublishIntervalMs) {
+                        emit matchesUpdated(sortedMatches(heap), false);
+                        publishTimer.restart();
+                    }
+                }
+                return true;
+            });
+
+    if (complete && !isInterrupted()) {
+        emit matchesUpdated(sortedMatches(heap), true);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef OMNIBARTASK_H
+#define OMNIBARTASK_H
+
+#include "common/AsyncTask.h"
+#include "core/Cutter.h"
+
+#include <QHash>
+
+struct OmnibarMatch
+{
+    RVA offset;
+    QString name;
+    NameIndex::Kind kind;
+    int score;
+};
+Q_DECLARE_METATYPE(OmnibarMatch)
+
+/**
+ * @brief Fuzzy "go to anything" lookup over the core's NameIndex
+ *
+ * Scans functions, flags, symbols, imports, strings and sections, ranking them by match quality,
+ * kind and how recently their address was visited. The best matches found so far are published
+ * periodically while scanning, so the first results are available before the scan completes.
+ */
+class OmnibarTask : public AsyncTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param seekHistory addresses from CutterCore::getSeekHistory(), oldest first
+     */
+    OmnibarTask(const QString &query, const QList<RVA> &seekHistory, int maxResults);
+
+    QString getTitle() override { return tr("Searching for \"%1\"").arg(query); }
+
+signals:
+    /**
+     * @param matches best matches so far, best first
+     * @param complete true if all names have been scanned
+     */
+    void matchesUpdated(const QList<OmnibarMatch> &matches, bool complete);
+
+protected:
+    void runTask() override;
+
+private:
+    QString query;
+    QHash<RVA, int> recencyBonus;
+    int maxResults;
+
+    QList<OmnibarMatch> sortedMatches(const QVector<OmnibarMatch> &heap) const;
+};
+
+#endif // OMNIBARTASK_H
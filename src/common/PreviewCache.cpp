@@ -0,0 +1,138 @@
+#include "PreviewCache.h"
+#include "PreviewTask.h"
+#include "core/Cutter.h"
+
+namespace {
+
+constexpr int kCacheSize = 512;
+// Previews generated by one task, a hovered row shouldn't wait behind a long batch
+constexpr int kBatchSize = 4;
+// Older prefetch requests are dropped, the rows they were made for were probably left already
+constexpr int kMaxPrefetched = 32;
+
+}
+
+PreviewCache::PreviewCache(CutterCore *core) : QObject(core), cache(kCacheSize)
+{
+    auto invalidateAll = [this]() { invalidate(); };
+    connect(core, &CutterCore::refreshAll, this, invalidateAll);
+    connect(core, &CutterCore::refreshCodeViews, this, invalidateAll);
+    connect(core, &CutterCore::codeRebased, this, invalidateAll);
+    connect(core, &CutterCore::functionsChanged, this, invalidateAll);
+    connect(core, &CutterCore::functionRenamed, this, invalidateAll);
+    connect(core, &CutterCore::flagsChanged, this, invalidateAll);
+    connect(core, &CutterCore::varsChanged, this, invalidateAll);
+    connect(core, &CutterCore::commentsChanged, this, invalidateAll);
+    connect(core, &CutterCore::instructionChanged, this, invalidateAll);
+    connect(core, &CutterCore::asmOptionsChanged, this, invalidateAll);
+    connect(core, &CutterCore::registersChanged, this, invalidateAll);
+    connect(core, &CutterCore::ioCacheChanged, this, invalidateAll);
+}
+
+PreviewCache::~PreviewCache()
+{
+    if (task) {
+        // Not waited for, the task only fills its own results and its finished signal is
+        // disconnected along with this
+        task->interrupt();
+    }
+}
+
+void PreviewCache::shutdown()
+{
+    if (task) {
+        task->interrupt();
+        task->wait();
+    }
+}
+
+bool PreviewCache::lookup(Kind kind, RVA address, QStringList *lines)
+{
+    const Key key = { kind, address };
+    if (QStringList *cached = cache.object(key)) {
+        *lines = *cached;
+        return true;
+    }
+    if (!requested.contains(key)) {
+        // Most recent request first, that is the one the user is looking at
+        requested.prepend(key);
+    }
+    prefetched.removeAll(key);
+    startTask();
+    return false;
+}
+
+void PreviewCache::prefetch(Kind kind, const QList<RVA> &addresses)
+{
+    for (RVA address : addresses) {
+        const Key key = { kind, address };
+        if (address == RVA_INVALID || cache.contains(key) || requested.contains(key)
+            || prefetched.contains(key)) {
+            continue;
+        }
+        prefetched.append(key);
+    }
+    while (prefetched.size() > kMaxPrefetched) {
+        prefetched.removeFirst();
+    }
+    startTask();
+}
+
+void PreviewCache::invalidate()
+{
+    generation++;
+    cache.clear();
+    // Previews of the running task are discarded when it finishes, the pending ones are
+    // generated for the new generation.
+}
+
+void PreviewCache::startTask()
+{
+    if (task || (requested.isEmpty() && prefetched.isEmpty())) {
+        return;
+    }
+
+    QList<Key> keys;
+    while (keys.size() < kBatchSize && !requested.isEmpty()) {
+        keys.append(requested.takeFirst());
+    }
+    bool hasRequested = !keys.isEmpty();
+    while (keys.size() < kBatchSize && !prefetched.isEmpty()) {
+        keys.append(prefetched.takeFirst());
+    }
+
+    task = QSharedPointer<PreviewTask>::create(keys, generation);
+    PreviewTask *newTask = task.data();
+    connect(newTask, &AsyncTask::finished, this,
+            [this, newTask]() { taskFinished(newTask); });
+    // A tooltip waits for the requested previews
+    Core()->getAsyncTaskManager()->start(task,
+                                         hasRequested ? AsyncTaskManager::VisiblePriority
+                                                      : AsyncTaskManager::PrefetchPriority);
+}
+
+void PreviewCache::taskFinished(PreviewTask *finishedTask)
+{
+    if (task.data() != finishedTask) {
+        return;
+    }
+    QSharedPointer<PreviewTask> keepAlive = task;
+    task.clear();
+
+    if (finishedTask->getGeneration() == generation) {
+        for (const PreviewTask::Result &result : finishedTask->getResults()) {
+            cache.insert(result.key, new QStringList(result.lines));
+        }
+        for (const PreviewTask::Result &result : finishedTask->getResults()) {
+            emit previewReady(result.key.kind, result.key.address);
+        }
+    } else {
+        // Generated for an outdated generation, regenerate the ones still wanted
+        for (const PreviewTask::Result &result : finishedTask->getResults()) {
+            if (!requested.contains(result.key)) {
+                requested.append(result.key);
+            }
+        }
+    }
+    startTask();
+}
@@ -0,0 +1,101 @@
+#ifndef PREVIEWCACHE_H
+#define PREVIEWCACHE_H
+
+#include "core/CutterCommon.h"
+
+#include <QCache>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
+
+class CutterCore;
+class PreviewTask;
+
+/**
+ * @brief LRU cache of the disassembly and hexdump previews shown in tooltips
+ *
+ * Previews need the core lock and can take a while during analysis, so they are never computed
+ * in the GUI thread. lookup() returns cached previews right away and queues missing ones for a
+ * background PreviewTask, previewReady() is emitted once they are available.
+ *
+ * Every change that may affect a preview (analysis, renames, comments, patches, debugger state)
+ * starts a new generation which drops all cached previews.
+ */
+class CUTTER_EXPORT PreviewCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Kind {
+        /// Colored disassembly lines, as html
+        Disassembly,
+        /// Strings referenced by the function at the address
+        FunctionStrings,
+        /// Colored hexdump, as html with a single line
+        Hexdump,
+    };
+
+    struct Key
+    {
+        Kind kind;
+        RVA address;
+
+        bool operator==(const Key &other) const
+        {
+            return kind == other.kind && address == other.address;
+        }
+    };
+
+    static constexpr int DisassemblyLines = 10;
+    static constexpr int HexdumpBytes = 64;
+
+    explicit PreviewCache(CutterCore *core);
+    ~PreviewCache() override;
+
+    /**
+     * @brief Interrupt the preview being generated and wait for it, before the core goes away
+     *
+     * Destroying the cache only interrupts it, so that it doesn't block the GUI thread.
+     */
+    void shutdown();
+
+    /**
+     * @brief Get a preview, queuing it for generation if it isn't cached yet
+     * @return true if \p lines was set to the cached preview
+     */
+    bool lookup(Kind kind, RVA address, QStringList *lines);
+
+    /**
+     * @brief Queue previews which are likely to be requested soon, e.g. neighbors of a hovered
+     * row, behind all previews that were requested by lookup()
+     */
+    void prefetch(Kind kind, const QList<RVA> &addresses);
+
+    quint64 getGeneration() const { return generation; }
+
+signals:
+    void previewReady(PreviewCache::Kind kind, RVA address);
+
+private:
+    QCache<Key, QStringList> cache;
+    QList<Key> requested;
+    QList<Key> prefetched;
+    QSharedPointer<PreviewTask> task;
+    quint64 generation = 0;
+
+    void invalidate();
+    void startTask();
+    void taskFinished(PreviewTask *finishedTask);
+};
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+inline uint qHash(const PreviewCache::Key &key, uint seed = 0)
+#else
+inline size_t qHash(const PreviewCache::Key &key, size_t seed = 0)
+#endif
+{
+    return qHash(key.address, seed) ^ static_cast<uint>(key.kind);
+}
+
+#endif // PREVIEWCACHE_H
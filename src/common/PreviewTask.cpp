@@ -0,0 +1,38 @@
+#include "PreviewTask.h"
+#include "common/Helpers.h"
+#include "core/Cutter.h"
+
+PreviewTask::PreviewTask(const QList<PreviewCache::Key> &keys, quint64 generation)
+    : keys(keys), generation(generation)
+{
+}
+
+void PreviewTask::runTask()
+{
+    for (const PreviewCache::Key &key : keys) {
+        if (isInterrupted()) {
+            return;
+        }
+
+        // Previews temporarily change the config and the seek, keep the core locked meanwhile
+        // so that other threads never see those changes.
+        RzCoreLocked core = Core()->core();
+        QStringList lines;
+        switch (key.kind) {
+        case PreviewCache::Kind::Disassembly:
+            lines = Core()->getDisassemblyPreview(key.address, PreviewCache::DisassemblyLines);
+            break;
+        case PreviewCache::Kind::FunctionStrings: {
+            auto seeker = Core()->seekTemp(key.address);
+            auto strings = fromOwnedCharPtr(rz_core_print_disasm_strings(
+                    core, RZ_CORE_DISASM_STRINGS_MODE_FUNCTION, 0, NULL));
+            lines = strings.split('\n', CUTTER_QT_SKIP_EMPTY_PARTS);
+            break;
+        }
+        case PreviewCache::Kind::Hexdump:
+            lines << Core()->getHexdumpPreview(key.address, PreviewCache::HexdumpBytes);
+            break;
+        }
+        results.append({ key, lines });
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef PREVIEWTASK_H
+#define PREVIEWTASK_H
+
+#include "common/AsyncTask.h"
+#include "common/PreviewCache.h"
+
+/**
+ * @brief Computes a batch of PreviewCache entries in the background
+ */
+class PreviewTask : public AsyncTask
+{
+    Q_OBJECT
+
+public:
+    struct Result
+    {
+        PreviewCache::Key key;
+        QStringList lines;
+    };
+
+    /**
+     * @param generation PreviewCache generation the previews are computed for
+     */
+    PreviewTask(const QList<PreviewCache::Key> &keys, quint64 generation);
+
+    QString getTitle() override { return tr("Generating previews"); }
+
+    quint64 getGeneration() const { return generation; }
+
+    /**
+     * @brief Previews computed so far, only to be read after finished() was emitted
+     */
+    const QList<Result> &getResults() const { return results; }
+
+protected:
+    void runTask() override;
+
+private:
+    QList<PreviewCache::Key> keys;
+    quint64 generation;
+    QList<Result> results;
+};
+
+#endif // PREVIEWTASK_H
@@ -0,0 +1,97 @@
+#include "ProcessListModel.h"
+
+#include <QHash>
+#include <QSet>
+
+ProcessListModel::ProcessListModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+void ProcessListModel::setProcesses(const QList<ProcessDescription> &newProcesses)
+{
+    QHash<int, int> newRows;
+    newRows.reserve(newProcesses.size());
+    for (int i = 0; i < newProcesses.size(); i++) {
+        newRows.insert(newProcesses.at(i).pid, i);
+    }
+
+    // Remove the rows of processes which are gone, a run of rows at a time
+    int row = processes.size() - 1;
+    while (row >= 0) {
+        if (newRows.contains(processes.at(row).pid)) {
+            row--;
+            continue;
+        }
+        int last = row;
+        while (row > 0 && !newRows.contains(processes.at(row - 1).pid)) {
+            row--;
+        }
+        beginRemoveRows(QModelIndex(), row, last);
+        processes.erase(processes.begin() + row, processes.begin() + last + 1);
+        endRemoveRows();
+        row--;
+    }
+
+    // Update the remaining rows in place
+    QSet<int> known;
+    int columns = columnCount();
+    for (row = 0; row < processes.size(); row++) {
+        const ProcessDescription &proc = newProcesses.at(newRows.value(processes.at(row).pid));
+        ProcessDescription &old = processes[row];
+        known.insert(proc.pid);
+        int first = -1;
+        int last = -1;
+        for (int column = 0; column < columns; column++) {
+            if (old.current != proc.current
+                || displayData(old, column) != displayData(proc, column)) {
+                if (first < 0) {
+                    first = column;
+                }
+                last = column;
+            }
+        }
+        old = proc;
+        if (first >= 0) {
+            emit dataChanged(index(row, first), index(row, last));
+        }
+    }
+
+    // Append the new processes
+    QList<ProcessDescription> added;
+    for (const ProcessDescription &proc : newProcesses) {
+        if (!known.contains(proc.pid)) {
+            known.insert(proc.pid);
+            added.append(proc);
+        }
+    }
+    if (!added.isEmpty()) {
+        beginInsertRows(QModelIndex(), processes.size(), processes.size() + added.size() - 1);
+        processes.append(added);
+        endInsertRows();
+    }
+}
+
+int ProcessListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : processes.size();
+}
+
+QVariant ProcessListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= processes.size()) {
+        return QVariant();
+    }
+
+    const ProcessDescription &proc = processes.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return displayData(proc, index.column());
+    case ProcDescriptionRole:
+        return QVariant::fromValue(proc);
+    default:
+        return roleData(proc, index.column(), role);
+    }
+}
+
+QVariant ProcessListModel::roleData(const ProcessDescription &, int, int) const
+{
+    return QVariant();
+}
@@ -0,0 +1,45 @@
+#ifndef PROCESSLISTMODEL_H
+#define PROCESSLISTMODEL_H
+
+#include "core/CutterCommon.h"
+#include "core/CutterDescriptions.h"
+
+#include <QAbstractTableModel>
+
+/**
+ * @brief Base of models listing processes or threads, which are updated by diffing
+ *
+ * Rows are keyed by pid. Updating the list only removes the rows of processes which are gone,
+ * appends the new ones and signals the cells which changed, so the views keep their selection
+ * and scroll position. Sorting is left to a proxy model.
+ */
+class CUTTER_EXPORT ProcessListModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Role { ProcDescriptionRole = Qt::UserRole };
+
+    explicit ProcessListModel(QObject *parent = nullptr);
+
+    void setProcesses(const QList<ProcessDescription> &newProcesses);
+    const QList<ProcessDescription> &getProcesses() const { return processes; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+
+protected:
+    /**
+     * @brief Text shown for \p proc in \p column, also used to find the changed cells
+     */
+    virtual QVariant displayData(const ProcessDescription &proc, int column) const = 0;
+    /**
+     * @brief Roles other than Qt::DisplayRole, changes of \p proc.current update the whole row
+     */
+    virtual QVariant roleData(const ProcessDescription &proc, int column, int role) const;
+
+private:
+    QList<ProcessDescription> processes;
+};
+
+#endif // PROCESSLISTMODEL_H
@@ -0,0 +1,198 @@
+#include "common/ProjectLoadTask.h"
+
+#include <QCoreApplication>
+
+ProjectLoadTask::ProjectLoadTask(const QString &file) : AsyncTask(), file(file) {}
+
+void ProjectLoadTask::interrupt()
+{
+    AsyncTask::interrupt();
+    resumed.release();
+}
+
+void ProjectLoadTask::resume()
+{
+    resumed.release();
+}
+
+void ProjectLoadTask::runTask()
+{
+    profiler.activate();
+    load();
+    profiler.deactivate();
+
+    if (loadedFile) {
+        QString summary = profiler.summary();
+        log(summary);
+        Core()->message(summary);
+    }
+}
+
+void ProjectLoadTask::load()
+{
+    QByteArray path = file.toUtf8();
+    RzProject *project;
+    {
+        RzCoreLocked core(Core());
+        AnalysisProfiler::Scope scope(core, tr("Read the project"));
+        project = rz_project_load_file_raw(path.constData());
+    }
+    if (!project) {
+        setError(RZ_PROJECT_ERR_FILE, nullptr);
+        return;
+    }
+    if (isInterrupted()) {
+        rz_project_free(project);
+        return;
+    }
+
+    QList<Deferred> deferred = detach(project);
+    RzSerializeResultInfo *res = rz_list_newf(free);
+    RzProjectErr err;
+    {
+        RzCoreLocked core(Core());
+        AnalysisProfiler::Scope scope(core, tr("Restore the project"));
+        err = rz_project_load(core, project, true, path.constData(), res);
+    }
+    rz_project_free(project);
+    if (err != RZ_PROJECT_ERR_SUCCESS) {
+        setError(err, res);
+        rz_list_free(res);
+        for (const Deferred &d : deferred) {
+            sdb_free(d.sdb);
+        }
+        return;
+    }
+    rz_list_free(res);
+    loadedFile = true;
+
+    if (!deferred.isEmpty()) {
+        resumed.tryAcquire(resumed.available());
+        emit loaded();
+        resumed.tryAcquire(1, ResumeTimeout);
+    }
+
+    bool failed = false;
+    for (int i = 0; i < deferred.size(); i++) {
+        const Deferred &d = deferred.at(i);
+        log(d.description);
+        emit progressChanged(i, deferred.size(), d.description);
+        RzSerializeResultInfo *res = rz_list_newf(free);
+        {
+            // The core is only locked during each part, so the UI can use it in between
+            RzCoreLocked core(Core());
+            AnalysisProfiler::Scope scope(core, d.description);
+            LiveEntries live = LiveEntries::take(core->analysis, d.part);
+            if (!d.load(d.sdb, core->analysis, res)) {
+                failed = true;
+                setError(RZ_PROJECT_ERR_INVALID_CONTENTS, res);
+            }
+            // Edits made since loaded() win over the entries of the project at the same place
+            live.addTo(core->analysis);
+        }
+        rz_list_free(res);
+        sdb_free(d.sdb);
+    }
+    complete = !failed;
+}
+
+ProjectLoadTask::LiveEntries ProjectLoadTask::LiveEntries::take(RzAnalysis *analysis, Part part)
+{
+    LiveEntries live;
+    if (part == Part::Xrefs) {
+        RzList *xrefs = rz_analysis_xrefs_list(analysis);
+        RzListIter *it;
+        RzAnalysisXRef *xref;
+        CutterRzListForeach (xrefs, it, RzAnalysisXRef, xref) {
+            live.xrefs.append(*xref);
+        }
+        rz_list_free(xrefs);
+        return live;
+    }
+
+    RzIntervalTreeIter it;
+    void *pVoid;
+    rz_interval_tree_foreach(&analysis->meta, it, pVoid)
+    {
+        auto item = reinterpret_cast<RzAnalysisMetaItem *>(pVoid);
+        RzIntervalNode *node = rz_interval_tree_iter_get(&it);
+        Meta meta = { item->type, item->subtype, node->start, node->end - node->start + 1,
+                      QByteArray(item->str), QByteArray(item->space ? item->space->name : "") };
+        live.meta.append(meta);
+    }
+    RzSpace *current = rz_spaces_current(&analysis->meta_spaces);
+    live.currentSpace = current ? current->name : "";
+    return live;
+}
+
+void ProjectLoadTask::LiveEntries::addTo(RzAnalysis *analysis) const
+{
+    for (const RzAnalysisXRef &xref : xrefs) {
+        rz_analysis_xrefs_set(analysis, xref.from, xref.to, xref.type);
+    }
+    if (meta.isEmpty()) {
+        return;
+    }
+    // Spaces are looked up by name, the loaders replace them too
+    RzSpaces *spaces = &analysis->meta_spaces;
+    for (const Meta &m : meta) {
+        rz_spaces_set(spaces, m.space.isEmpty() ? nullptr : m.space.constData());
+        rz_meta_set_with_subtype(analysis, m.type, m.subtype, m.addr, m.size,
+                                 m.str.isNull() ? nullptr : m.str.constData());
+    }
+    rz_spaces_set(spaces, currentSpace.isEmpty() ? nullptr : currentSpace.constData());
+}
+
+QList<ProjectLoadTask::Deferred> ProjectLoadTask::detach(RzProject *project)
+{
+    // Older projects are migrated during the load, their namespaces may be laid out differently
+    if (sdb_num_get(project, RZ_PROJECT_KEY_VERSION, nullptr) != RZ_PROJECT_VERSION) {
+        return {};
+    }
+    QList<Deferred> deferred = {
+        { Part::Xrefs, tr("Restore the cross references"), rz_serialize_analysis_xrefs_load,
+          sdb_ns_path(project, "core/analysis/xrefs", false) },
+        { Part::Meta, tr("Restore the metadata"), rz_serialize_analysis_meta_load,
+          sdb_ns_path(project, "core/analysis/meta", false) },
+    };
+    int entries = 0;
+    for (const Deferred &d : deferred) {
+        if (!d.sdb) {
+            return {};
+        }
+        entries += sdb_count(d.sdb);
+    }
+    if (entries < DeferThreshold) {
+        return {};
+    }
+
+    // The namespaces themselves stay in the project, only emptied, so rz_project_load() still
+    // finds them and doesn't report the project as broken. Their loaders clear what the analysis
+    // holds and add the entries of the namespace, which is nothing for an emptied one, so rizin
+    // doesn't touch the cross references and metadata until load() replays the copies into
+    // the same loaders once the rest is shown. What the user added in between is kept by
+    // LiveEntries.
+    for (Deferred &d : deferred) {
+        Sdb *entriesDb = sdb_new0();
+        sdb_copy(d.sdb, entriesDb);
+        // Only the entries, nested namespaces like the meta spaces are still loaded with the
+        // project and then again with the entries
+        sdb_reset(d.sdb);
+        d.sdb = entriesDb;
+    }
+    return deferred;
+}
+
+void ProjectLoadTask::setError(RzProjectErr err, RzSerializeResultInfo *res)
+{
+    const char *s = rz_project_err_message(err);
+    errorMessage = QCoreApplication::translate("MainWindow", "Failed to open project: %1")
+                           .arg(QString::fromUtf8(s));
+    if (res) {
+        RzListIter *it;
+        CutterRzListForeach (res, it, const char, s) {
+            errorMessage += "\n" + QString::fromUtf8(s);
+        }
+    }
+    log(errorMessage);
+}
@@ -0,0 +1,108 @@
+#ifndef PROJECTLOADTASK_H
+#define PROJECTLOADTASK_H
+
+#include "common/AsyncTask.h"
+#include "common/AnalysisProfiler.h"
+#include "core/Cutter.h"
+
+#include <QSemaphore>
+
+/**
+ * @brief Opens a project in two steps, so it can be browsed before it is restored completely
+ *
+ * The cross references and the metadata, like comments and strings, make up most of large
+ * projects but are not needed to show the functions, flags and disassembly. They are set aside
+ * while the rest of the project is loaded, and restored after loaded() one after another, with
+ * the core unlocked in between. Small projects and projects which need to be migrated from an
+ * older version are loaded in one step.
+ */
+class ProjectLoadTask : public AsyncTask
+{
+    Q_OBJECT
+
+public:
+    explicit ProjectLoadTask(const QString &file);
+
+    QString getTitle() override { return tr("Opening Project"); }
+
+    /**
+     * @brief Stop before the project is loaded, a restoration in progress is finished
+     */
+    void interrupt() override;
+
+    /**
+     * @brief Continue restoring the project after loaded()
+     */
+    void resume();
+
+    bool isLoaded() const { return loadedFile; }
+    /// Everything was restored, otherwise saving the project would lose data
+    bool isComplete() const { return complete; }
+    const QString &getErrorMessage() const { return errorMessage; }
+
+protected:
+    void runTask() override;
+
+signals:
+    /**
+     * @brief The project can be browsed, the restoration waits until resume() or at most
+     * ResumeTimeout
+     */
+    void loaded();
+    void progressChanged(int step, int steps, const QString &description);
+
+private:
+    static constexpr int ResumeTimeout = 5000;
+    /// Number of cross references and metadata entries from which they are restored later
+    static constexpr int DeferThreshold = 50000;
+
+    enum class Part { Xrefs, Meta };
+
+    struct Deferred
+    {
+        Part part;
+        QString description;
+        bool (*load)(Sdb *db, RzAnalysis *analysis, RzSerializeResultInfo *res);
+        Sdb *sdb;
+    };
+
+    /**
+     * @brief Entries the user added while the project was restored
+     *
+     * The loaders of rizin replace all cross references or metadata of the analysis, so the
+     * entries of a part are taken before and added again after it is restored.
+     */
+    struct LiveEntries
+    {
+        struct Meta
+        {
+            RzAnalysisMetaType type;
+            int subtype;
+            ut64 addr;
+            ut64 size;
+            QByteArray str;
+            QByteArray space;
+        };
+
+        QList<RzAnalysisXRef> xrefs;
+        QList<Meta> meta;
+        QByteArray currentSpace;
+
+        static LiveEntries take(RzAnalysis *analysis, Part part);
+        void addTo(RzAnalysis *analysis) const;
+    };
+
+    void load();
+    QList<Deferred> detach(RzProject *project);
+    void setError(RzProjectErr err, RzSerializeResultInfo *res);
+
+    QString file;
+    AnalysisProfiler profiler;
+
+    bool loadedFile = false;
+    bool complete = false;
+    QString errorMessage;
+    QSemaphore resumed;
+};
+
+#endif // PROJECTLOADTASK_H
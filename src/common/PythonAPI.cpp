@@ -49,12 +49,59 @@ PyObject *api_message(PyObject *self, PyObject *args, PyObject *kwargs)
     Py_RETURN_NONE;
 }
 
+PyObject *api_search_bytes(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    Q_UNUSED(self);
+    char *patterns;
+    char *in = (char *)"io.maps";
+    int limit = 0;
+    static const char *kwlist[] = { "", "in", "limit", NULL };
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|si", const_cast<char **>(kwlist), &patterns,
+                                     &in, &limit)) {
+        return NULL;
+    }
+
+    QList<SearchDescription> results;
+    QString error;
+    // The search doesn't touch Python objects, let other Python threads run meanwhile
+    Py_BEGIN_ALLOW_THREADS
+    results = Core()->searchBytePatterns(QString(patterns), QString(in), limit, &error);
+    Py_END_ALLOW_THREADS
+
+    if (!error.isEmpty()) {
+        PyErr_SetString(PyExc_ValueError, error.toUtf8().constData());
+        return NULL;
+    }
+
+    PyObject *list = PyList_New(results.size());
+    if (!list) {
+        return NULL;
+    }
+    for (int i = 0; i < results.size(); i++) {
+        const SearchDescription &result = results.at(i);
+        PyObject *item = Py_BuildValue(
+                "{s:K,s:i,s:s}", "offset", static_cast<unsigned long long>(result.offset), "size",
+                result.size, "data", result.data.toUtf8().constData());
+        if (!item) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
 PyMethodDef CutterMethods[] = {
     { "version", api_version, METH_NOARGS, "Returns Cutter current version" },
     { "cmd", api_cmd, METH_VARARGS, "Execute a command inside Cutter" },
     { "refresh", api_refresh, METH_NOARGS, "Refresh Cutter widgets" },
     { "message", (PyCFunction)(void *)/* don't remove this double cast! */ api_message,
       METH_VARARGS | METH_KEYWORDS, "Print message" },
+    { "search_bytes", (PyCFunction)(void *)/* don't remove this double cast! */ api_search_bytes,
+      METH_VARARGS | METH_KEYWORDS,
+      "Search for hex patterns with wildcards and masks, e.g. search_bytes(\"e8????????, "
+      "4?8b:f0ff\", in=\"io.maps\", limit=0). Returns a list of dicts with offset, size and "
+      "data." },
     { NULL, NULL, 0, NULL }
 };
 
@@ -0,0 +1,121 @@
+#include "RefreshScheduler.h"
+#include "core/Cutter.h"
+#include "widgets/CutterDockWidget.h"
+
+#include <QApplication>
+
+#include <climits>
+
+RefreshScheduler::RefreshScheduler(CutterCore *core) : QObject(core)
+{
+    timer.setSingleShot(true);
+    timer.setInterval(0);
+    connect(&timer, &QTimer::timeout, this, &RefreshScheduler::runNext);
+    connect(core, &CutterCore::refreshAll, this, &RefreshScheduler::refreshAll);
+}
+
+void RefreshScheduler::add(QWidget *widget, const std::function<void()> &refresh,
+                           Priority priority)
+{
+    // Widgets created later, e.g. docks constructed on first use, have missed refreshAll
+    entries.append({ widget, refresh, priority, refreshed });
+    if (refreshed) {
+        timer.start();
+    }
+}
+
+void RefreshScheduler::refreshAll()
+{
+    refreshed = true;
+    for (Entry &entry : entries) {
+        entry.dirty = true;
+    }
+    // Visibility is only checked once the event loop runs, so that docks hidden or shown by
+    // whoever emitted refreshAll, e.g. while restoring the layout, are not refreshed in vain
+    timer.start();
+}
+
+void RefreshScheduler::runNext()
+{
+    QWidget *focus = QApplication::focusWidget();
+    int best = -1;
+    int bestRank = INT_MAX;
+    for (int i = 0; i < entries.size(); i++) {
+        if (!entries.at(i).widget) {
+            entries.removeAt(i--);
+            continue;
+        }
+        int entryRank = rank(entries.at(i), focus);
+        if (entryRank >= 0 && entryRank < bestRank) {
+            best = i;
+            bestRank = entryRank;
+        }
+    }
+    if (best < 0) {
+        return;
+    }
+
+    // Copied since the refresh may register new entries
+    std::function<void()> refresh = entries.at(best).refresh;
+    CoreLockScope scope(entries.at(best).widget->metaObject()->className());
+    entries[best].dirty = false;
+    // One refresh per iteration, input and painting are handled in between
+    timer.start();
+    refresh();
+}
+
+void RefreshScheduler::runPending(Priority priority)
+{
+    for (int i = 0; i < entries.size(); i++) {
+        Entry &entry = entries[i];
+        if (entry.widget && entry.priority <= priority && rank(entry, nullptr) >= 0) {
+            entry.dirty = false;
+            std::function<void()> refresh = entry.refresh;
+            CoreLockScope scope(entry.widget->metaObject()->className());
+            refresh();
+        }
+    }
+}
+
+void RefreshScheduler::dockBecameVisible()
+{
+    timer.start();
+}
+
+CutterDockWidget *RefreshScheduler::dockOf(QWidget *widget)
+{
+    for (QWidget *parent = widget; parent; parent = parent->parentWidget()) {
+        if (auto dock = qobject_cast<CutterDockWidget *>(parent)) {
+            return dock;
+        }
+    }
+    return nullptr;
+}
+
+bool RefreshScheduler::isVisible(QWidget *widget)
+{
+    CutterDockWidget *dock = dockOf(widget);
+    if (!dock) {
+        return true;
+    }
+    if (!watchedDocks.contains(dock)) {
+        watchedDocks.insert(dock);
+        connect(dock, &CutterDockWidget::becameVisibleToUser, this,
+                &RefreshScheduler::dockBecameVisible);
+        connect(dock, &QObject::destroyed, this,
+                [this](QObject *object) { watchedDocks.remove(object); });
+    }
+    return dock->isVisibleToUser();
+}
+
+int RefreshScheduler::rank(const Entry &entry, QWidget *focus)
+{
+    if (!entry.dirty || !isVisible(entry.widget)) {
+        return -1;
+    }
+    CutterDockWidget *dock = dockOf(entry.widget);
+    if (focus && dock && (dock == focus || dock->isAncestorOf(focus))) {
+        return 0;
+    }
+    return 1 + static_cast<int>(entry.priority);
+}
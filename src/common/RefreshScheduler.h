@@ -0,0 +1,83 @@
+#ifndef REFRESHSCHEDULER_H
+#define REFRESHSCHEDULER_H
+
+#include "core/CutterCommon.h"
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+
+#include <functional>
+
+class CutterCore;
+class CutterDockWidget;
+
+/**
+ * @brief Runs the refreshes of the widgets after CutterCore::refreshAll
+ *
+ * Connecting every widget to refreshAll directly makes all of them fetch their data at once,
+ * including the ones which are hidden and may never be shown, which blocks the GUI right after
+ * the analysis. Widgets register their refresh here instead. After refreshAll, the widgets
+ * visible to the user are refreshed one per event loop iteration, the one with the focus first,
+ * then by priority. Hidden widgets are only refreshed once their dock becomes visible.
+ */
+class CUTTER_EXPORT RefreshScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Priority {
+        /// Code views, which the user looks at first
+        High,
+        Normal,
+        /// Widgets which are expensive to refresh and rarely looked at right away
+        Low
+    };
+
+    explicit RefreshScheduler(CutterCore *core);
+
+    /**
+     * @brief Call \p refresh after each CutterCore::refreshAll, once \p widget is visible
+     *
+     * Widgets outside of any dock, e.g. in a toolbar, are always refreshed. Widgets added after
+     * the first refreshAll are refreshed once as well. The entry is dropped when \p widget is
+     * destroyed.
+     */
+    void add(QWidget *widget, const std::function<void()> &refresh,
+             Priority priority = Priority::Normal);
+
+    /**
+     * @brief Run the pending refreshes of the visible widgets with at least \p priority now
+     *
+     * For callers which need the result right away, e.g. to decide which view gets the focus.
+     */
+    void runPending(Priority priority);
+
+private:
+    struct Entry
+    {
+        QPointer<QWidget> widget;
+        std::function<void()> refresh;
+        Priority priority;
+        bool dirty;
+    };
+
+    void refreshAll();
+    void runNext();
+    void dockBecameVisible();
+    CutterDockWidget *dockOf(QWidget *widget);
+    bool isVisible(QWidget *widget);
+    /// Lower is refreshed earlier, negative if the entry can't be refreshed now
+    int rank(const Entry &entry, QWidget *focus);
+
+    QList<Entry> entries;
+    /// Docks whose becameVisibleToUser is connected
+    QSet<QObject *> watchedDocks;
+    QTimer timer;
+    /// Whether refreshAll was emitted at least once
+    bool refreshed = false;
+};
+
+#endif // REFRESHSCHEDULER_H
@@ -1,9 +1,12 @@
 
 #include "RizinTask.h"
+#include "common/StallWatchdog.h"
+#include "core/CoreLockProfiler.h"
 #include <rz_core.h>
 
 RizinTask::~RizinTask()
 {
+    StallWatchdog::taskFinished(this);
     if (task) {
         rz_core_task_decref(task);
     }
@@ -11,6 +14,8 @@ RizinTask::~RizinTask()
 
 void RizinTask::startTask()
 {
+    const char *name = CoreLockProfiler::internName(title, metaObject()->className());
+    StallWatchdog::taskStarted(this, name);
     rz_core_task_enqueue(&Core()->core_->tasks, task);
 }
 
@@ -26,6 +31,7 @@ void RizinTask::joinTask()
 
 void RizinTask::taskFinished()
 {
+    StallWatchdog::taskFinished(this);
     emit finished();
 }
 
@@ -33,6 +39,7 @@ void RizinTask::taskFinished()
 
 RizinCmdTask::RizinCmdTask(const QString &cmd, bool transient)
 {
+    title = cmd;
     task = rz_core_cmd_task_new(
             Core()->core(), cmd.toLocal8Bit().constData(),
             static_cast<RzCoreCmdTaskFinished>(&RizinCmdTask::taskFinishedCallback), this);
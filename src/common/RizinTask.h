@@ -10,6 +10,8 @@ class CUTTER_EXPORT RizinTask : public QObject
 
 protected:
     RzCoreTask *task;
+    /// Identifies the task in the stall reports, the class name is used if it is empty
+    QString title;
 
     RizinTask() {}
     void taskFinished();
@@ -0,0 +1,111 @@
+#include "SearchTask.h"
+#include "core/BytePatternSearch.h"
+
+namespace {
+
+constexpr ut64 kChunkSize = 8 * 1024 * 1024;
+// Each chunk is extended by this many bytes to find matches crossing the chunk end.
+// Only matches starting inside the chunk itself are kept, so none are reported twice.
+constexpr ut64 kChunkOverlap = 0x1000;
+
+}
+
+const QString SearchTask::BytePatternSpace = QStringLiteral("bytepattern");
+
+SearchTask::SearchTask(const QString &searchFor, const QString &space, const QString &in,
+                       int maxResults)
+    : searchFor(searchFor), space(space), in(in), maxResults(maxResults)
+{
+}
+
+void SearchTask::runTask()
+{
+    const QList<AddressRangeDescription> ranges = Core()->getSearchBoundaries(in);
+    ut64 total = 0;
+    for (const AddressRangeDescription &range : ranges) {
+        total += range.end - range.begin;
+    }
+    log(tr("Searching %1 bytes in %2 ranges").arg(total).arg(ranges.size()));
+
+    if (space == BytePatternSpace) {
+        runBytePatternSearch(ranges, total);
+        return;
+    }
+
+    ut64 searched = 0;
+    int found = 0;
+    emit searchProgress(0);
+    for (const AddressRangeDescription &range : ranges) {
+        RVA chunkBegin = range.begin;
+        while (chunkBegin < range.end) {
+            if (isInterrupted()) {
+                log(tr("Interrupted"));
+                return;
+            }
+            RVA chunkEnd = chunkBegin + qMin(kChunkSize, range.end - chunkBegin);
+            RVA searchEnd = chunkEnd + qMin(kChunkOverlap, range.end - chunkEnd);
+
+            QList<SearchDescription> results;
+            for (const SearchDescription &result :
+                 Core()->getAllSearchInRange(searchFor, space, chunkBegin, searchEnd)) {
+                if (result.offset < chunkBegin || result.offset >= chunkEnd) {
+                    continue;
+                }
+                results.append(result);
+                if (maxResults > 0 && found + results.size() >= maxResults) {
+                    limitReached = true;
+                    break;
+                }
+            }
+
+            searched += chunkEnd - chunkBegin;
+            found += results.size();
+            if (!results.isEmpty()) {
+                emit resultsFound(results);
+            }
+            emit searchProgress(total ? static_cast<int>(searched * 100 / total) : 100);
+
+            if (limitReached) {
+                log(tr("Stopped after %1 results").arg(found));
+                return;
+            }
+            chunkBegin = chunkEnd;
+        }
+    }
+    log(tr("Found %1 results").arg(found));
+}
+
+void SearchTask::runBytePatternSearch(const QList<AddressRangeDescription> &ranges, ut64 total)
+{
+    QVector<BytePattern> patterns;
+    QString error;
+    if (!BytePattern::parseList(searchFor, &patterns, &error)) {
+        log(error);
+        return;
+    }
+
+    // Results are emitted from the matching threads, the connections are queued anyway
+    int found = 0;
+    emit searchProgress(0);
+    BytePatternSearch search(patterns);
+    bool complete = search.run(
+            ranges, maxResults,
+            [this, &found](const QList<SearchDescription> &results) {
+                found += results.size();
+                emit resultsFound(results);
+                return !isInterrupted();
+            },
+            [this, total](ut64 searched, ut64) {
+                emit searchProgress(total ? static_cast<int>(searched * 100 / total) : 100);
+                return !isInterrupted();
+            });
+
+    if (isInterrupted()) {
+        log(tr("Interrupted"));
+    } else if (!complete && maxResults > 0 && found >= maxResults) {
+        limitReached = true;
+        log(tr("Stopped after %1 results").arg(found));
+    } else {
+        log(tr("Found %1 results").arg(found));
+    }
+}
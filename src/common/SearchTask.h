@@ -0,0 +1,55 @@
+#ifndef SEARCHTASK_H
+#define SEARCHTASK_H
+
+#include "common/AsyncTask.h"
+#include "core/Cutter.h"
+
+/**
+ * @brief Runs a search over the search boundaries in chunks
+ *
+ * The core is only locked for one chunk at a time, so the rest of the UI stays usable, results
+ * are published after every chunk and the search can be interrupted between chunks.
+ */
+class SearchTask : public AsyncTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param searchFor search argument
+     * @param space search command, e.g. "/xj"
+     * @param in search boundaries, same as the search.in config
+     * @param maxResults stop after finding this many results, 0 for no limit
+     */
+    SearchTask(const QString &searchFor, const QString &space, const QString &in, int maxResults);
+
+    /**
+     * @brief Search space for hex patterns matched natively by BytePatternSearch
+     */
+    static const QString BytePatternSpace;
+
+    QString getTitle() override { return tr("Searching for \"%1\"").arg(searchFor); }
+
+    bool isLimitReached() const { return limitReached; }
+
+signals:
+    void resultsFound(const QList<SearchDescription> &results);
+    /**
+     * @param percent share of the bytes in the search boundaries searched so far
+     */
+    void searchProgress(int percent);
+
+protected:
+    void runTask() override;
+
+private:
+    QString searchFor;
+    QString space;
+    QString in;
+    int maxResults;
+    bool limitReached = false;
+
+    void runBytePatternSearch(const QList<AddressRangeDescription> &ranges, ut64 total);
+};
+
+#endif // SEARCHTASK_H
@@ -0,0 +1,284 @@
+#include "common/StallWatchdog.h"
+#include "core/CoreLockProfiler.h"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QFile>
+#include <QMetaEnum>
+#include <QMutexLocker>
+#include <QThread>
+
+namespace {
+
+struct RunningTask
+{
+    const void *task;
+    const char *name;
+    qint64 startNs;
+};
+
+// Not members, so that tasks and events don't depend on the lifetime of the watchdog
+QAtomicInt watching;
+QAtomicPointer<QThread> guiThread;
+QAtomicPointer<const char> eventReceiver;
+QAtomicInt eventType;
+
+QMutex &tasksMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+QList<RunningTask> &runningTasks()
+{
+    static QList<RunningTask> tasks;
+    return tasks;
+}
+
+}
+
+class StallWatchdog::Monitor : public QThread
+{
+public:
+    explicit Monitor(StallWatchdog *watchdog) : watchdog(watchdog) {}
+
+    void stop()
+    {
+        stopping.storeRelease(1);
+        wait();
+    }
+
+protected:
+    void run() override
+    {
+        while (!stopping.loadAcquire()) {
+            msleep(CheckInterval);
+            watchdog->check();
+        }
+    }
+
+private:
+    StallWatchdog *watchdog;
+    QAtomicInt stopping;
+};
+
+QString StallWatchdog::Stall::toText() const
+{
+    QStringList lines;
+    QString duration = CoreLockProfiler::formatDuration(durationMs * 1000);
+    lines << QStringLiteral("%1: %2%3")
+                     .arg(time.toString(Qt::ISODateWithMs), duration,
+                          ongoing ? QStringLiteral(" ") + tr("(ongoing)") : QString());
+    if (!activity.isEmpty()) {
+        lines << tr("    Event: %1").arg(activity);
+    }
+    if (!scope.isEmpty()) {
+        lines << tr("    Scope: %1").arg(scope);
+    }
+    if (lockWaitMs >= 0) {
+        lines << tr("    Waiting for the core lock for %1")
+                         .arg(CoreLockProfiler::formatDuration(lockWaitMs * 1000));
+    }
+    if (!lockHolder.isEmpty()) {
+        lines << tr("    Core lock held by %1").arg(lockHolder);
+    }
+    if (!tasks.isEmpty()) {
+        lines << tr("    Tasks: %1").arg(tasks.join(QStringLiteral(", ")));
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+StallWatchdog::EventScope::EventScope(QObject *receiver, QEvent *event)
+    : active(watching.loadAcquire() && QThread::currentThread() == guiThread.loadAcquire())
+{
+    if (!active) {
+        return;
+    }
+    previousReceiver = eventReceiver.loadAcquire();
+    previousType = eventType.loadAcquire();
+    eventReceiver.storeRelease(receiver->metaObject()->className());
+    eventType.storeRelease(event->type());
+}
+
+StallWatchdog::EventScope::~EventScope()
+{
+    if (active) {
+        eventReceiver.storeRelease(previousReceiver);
+        eventType.storeRelease(previousType);
+    }
+}
+
+StallWatchdog::StallWatchdog(QObject *parent) : QObject(parent)
+{
+    qRegisterMetaType<StallWatchdog::Stall>("StallWatchdog::Stall");
+    heartbeat.setInterval(HeartbeatInterval);
+    connect(&heartbeat, &QTimer::timeout, this,
+            [this]() { lastBeatNs.storeRelease(CoreLockProfiler::nowNs()); });
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    setThreshold(0);
+}
+
+StallWatchdog *StallWatchdog::instance()
+{
+    static StallWatchdog *watchdog = new StallWatchdog(QCoreApplication::instance());
+    return watchdog;
+}
+
+void StallWatchdog::setThreshold(int thresholdMs)
+{
+    threshold.storeRelease(thresholdMs);
+    if (thresholdMs > 0 && !monitor) {
+        guiThread.storeRelease(QThread::currentThread());
+        lastBeatNs.storeRelease(CoreLockProfiler::nowNs());
+        heartbeat.start();
+        watching.storeRelease(1);
+        monitor = new Monitor(this);
+        monitor->start();
+    } else if (thresholdMs <= 0 && monitor) {
+        watching.storeRelease(0);
+        heartbeat.stop();
+        monitor->stop();
+        delete monitor;
+        monitor = nullptr;
+        stalled = false;
+    }
+}
+
+QList<StallWatchdog::Stall> StallWatchdog::getStalls() const
+{
+    QMutexLocker locker(&mutex);
+    return stalls;
+}
+
+void StallWatchdog::clear()
+{
+    QMutexLocker locker(&mutex);
+    stalls.clear();
+}
+
+QString StallWatchdog::toText(int maxStalls) const
+{
+    QList<Stall> stalls = getStalls();
+    QStringList text;
+    for (int i = stalls.size() - 1; i >= 0 && text.size() < maxStalls; i--) {
+        text << stalls.at(i).toText();
+    }
+    return text.join(QLatin1Char('\n'));
+}
+
+bool StallWatchdog::save(const QString &file, QString *error) const
+{
+    QFile output(file);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        *error = output.errorString();
+        return false;
+    }
+    QByteArray text = toText().toUtf8() + '\n';
+    if (output.write(text) != text.size()) {
+        *error = output.errorString();
+        return false;
+    }
+    return true;
+}
+
+void StallWatchdog::taskStarted(const void *task, const char *name)
+{
+    QMutexLocker locker(&tasksMutex());
+    runningTasks().append({ task, name, CoreLockProfiler::nowNs() });
+}
+
+void StallWatchdog::taskFinished(const void *task)
+{
+    QMutexLocker locker(&tasksMutex());
+    QList<RunningTask> &tasks = runningTasks();
+    for (int i = 0; i < tasks.size(); i++) {
+        if (tasks.at(i).task == task) {
+            tasks.removeAt(i);
+            return;
+        }
+    }
+}
+
+void StallWatchdog::check()
+{
+    qint64 beat = lastBeatNs.loadAcquire();
+    qint64 now = CoreLockProfiler::nowNs();
+    // The stall started when the beat after the last one was due
+    qint64 intervalNs = HeartbeatInterval * qint64(1000000);
+
+    if (stalled) {
+        QMutexLocker locker(&mutex);
+        if (stalls.isEmpty()) {
+            // Cleared meanwhile
+            stalled = beat == stallBeatNs;
+            return;
+        }
+        Stall &stall = stalls.last();
+        if (beat == stallBeatNs) {
+            stall.durationMs = (now - stallBeatNs - intervalNs) / 1000000;
+            return;
+        }
+        stall.durationMs = (beat - stallBeatNs - intervalNs) / 1000000;
+        stall.ongoing = false;
+        Stall ended = stall;
+        locker.unlock();
+        stalled = false;
+        emit stallEnded(ended);
+        return;
+    }
+
+    int thresholdMs = threshold.loadAcquire();
+    if (thresholdMs > 0 && now - beat - intervalNs > thresholdMs * qint64(1000000)) {
+        stalled = true;
+        stallBeatNs = beat;
+        Stall stall = snapshot(beat + intervalNs);
+        QMutexLocker locker(&mutex);
+        stalls.append(stall);
+        while (stalls.size() > MaxStalls) {
+            stalls.removeFirst();
+        }
+    }
+}
+
+StallWatchdog::Stall StallWatchdog::snapshot(qint64 startNs)
+{
+    Stall stall;
+    qint64 now = CoreLockProfiler::nowNs();
+    stall.durationMs = (now - startNs) / 1000000;
+    stall.time = QDateTime::currentDateTime().addMSecs(-stall.durationMs);
+
+    const char *receiver = eventReceiver.loadAcquire();
+    if (receiver) {
+        int type = eventType.loadAcquire();
+        const char *typeName = QMetaEnum::fromType<QEvent::Type>().valueToKey(type);
+        stall.activity = tr("%1 to %2").arg(
+                typeName ? QString::fromLatin1(typeName) : QString::number(type),
+                QString::fromLatin1(receiver));
+    }
+    stall.scope = CoreLockProfiler::getGuiScope();
+
+    // Read while the GUI thread keeps running, so the values are approximate
+    CoreLockProfiler::Holder holder = CoreLockProfiler::getHolder();
+    if (holder.heldUs >= 0) {
+        QString caller = holder.scope.isEmpty()
+                ? holder.function
+                : QStringLiteral("%1 > %2").arg(holder.scope, holder.function);
+        stall.lockHolder = tr("%1 on the %2 for %3")
+                                   .arg(caller,
+                                        holder.guiThread ? tr("GUI thread") : tr("worker thread"),
+                                        CoreLockProfiler::formatDuration(holder.heldUs));
+    }
+    qint64 waitUs = CoreLockProfiler::getGuiWaitUs();
+    stall.lockWaitMs = waitUs >= 0 ? waitUs / 1000 : -1;
+
+    QMutexLocker locker(&tasksMutex());
+    for (const RunningTask &task : runningTasks()) {
+        stall.tasks << tr("%1 for %2").arg(
+                QString::fromUtf8(task.name),
+                CoreLockProfiler::formatDuration((now - task.startNs) / 1000));
+    }
+    return stall;
+}
@@ -0,0 +1,119 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include "core/CutterCommon.h"
+
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+class QEvent;
+
+/**
+ * @brief Logs the stalls of the event loop of the GUI thread and what was going on meanwhile
+ *
+ * A timer on the GUI thread beats while the event loop runs, a thread of the watchdog checks the
+ * beats. Once they are late by more than the threshold, it records the event the GUI thread is
+ * handling, the CoreLockScope it is in, who holds the core lock and whether the GUI thread
+ * waits for it, and the tasks running in the background. The recent stalls are kept in memory
+ * only, they are shown and saved on request of the user.
+ */
+class CUTTER_EXPORT StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stall
+    {
+        QDateTime time;
+        qint64 durationMs = 0;
+        /// Still blocked when the log was read
+        bool ongoing = true;
+        /// Event handled by the GUI thread, with its receiver
+        QString activity;
+        QString scope;
+        QString lockHolder;
+        /// How long the GUI thread was waiting for the core lock, negative if it wasn't
+        qint64 lockWaitMs = -1;
+        QStringList tasks;
+
+        QString toText() const;
+    };
+
+    /**
+     * @brief Attributes the events delivered to the GUI thread, see CutterApplication::notify()
+     */
+    class EventScope
+    {
+    public:
+        EventScope(QObject *receiver, QEvent *event);
+        ~EventScope();
+        EventScope(const EventScope &) = delete;
+        EventScope &operator=(const EventScope &) = delete;
+
+    private:
+        bool active;
+        const char *previousReceiver;
+        int previousType;
+    };
+
+    static constexpr int MaxStalls = 100;
+
+    static StallWatchdog *instance();
+
+    /**
+     * @brief Start watching the GUI thread, must be called from it
+     * @param thresholdMs shortest stall which is logged, 0 to stop watching
+     */
+    void setThreshold(int thresholdMs);
+    int getThreshold() const { return threshold.loadAcquire(); }
+
+    QList<Stall> getStalls() const;
+    void clear();
+    /// Most recent stalls first
+    QString toText(int maxStalls = MaxStalls) const;
+    bool save(const QString &file, QString *error) const;
+
+    /**
+     * Called by the tasks running outside of the GUI thread, \p name must outlive the task, e.g.
+     * from CoreLockProfiler::internName()
+     */
+    static void taskStarted(const void *task, const char *name);
+    static void taskFinished(const void *task);
+
+signals:
+    /// Emitted on the GUI thread once it responds again
+    void stallEnded(const StallWatchdog::Stall &stall);
+
+private:
+    static constexpr int HeartbeatInterval = 100;
+    static constexpr int CheckInterval = 50;
+
+    class Monitor;
+
+    explicit StallWatchdog(QObject *parent);
+    ~StallWatchdog();
+
+    void check();
+    Stall snapshot(qint64 startNs);
+
+    QTimer heartbeat;
+    QAtomicInteger<qint64> lastBeatNs;
+    QAtomicInt threshold;
+    Monitor *monitor = nullptr;
+
+    /// Set while the beat is late, only used by the monitor thread
+    bool stalled = false;
+    qint64 stallBeatNs = 0;
+
+    mutable QMutex mutex;
+    QList<Stall> stalls;
+};
+
+Q_DECLARE_METATYPE(StallWatchdog::Stall)
+
+#endif // STALLWATCHDOG_H
@@ -19,7 +19,10 @@ protected:
     void runTask() override
     {
         auto strings = Core()->getAllStrings();
-        emit stringSearchFinished(strings);
+        // Superseded by a newer search meanwhile
+        if (!isInterrupted()) {
+            emit stringSearchFinished(strings);
+        }
     }
 };
 
@@ -0,0 +1,419 @@
+#include "BreakpointCondition.h"
+#include "DebugSnapshot.h"
+
+#include <cctype>
+#include <cstring>
+
+static const struct
+{
+    const char *name;
+    RzRegisterId role;
+} registerRoles[] = { { "pc", RZ_REG_NAME_PC },
+                      { "sp", RZ_REG_NAME_SP },
+                      { "bp", RZ_REG_NAME_BP } };
+
+/// Register name \p alias stands for, if it is one of pc, sp, bp
+static const char *aliasedRegisterName(RzReg *reg, const QByteArray &alias)
+{
+    for (const auto &role : registerRoles) {
+        if (alias == role.name) {
+            return rz_reg_get_name(reg, role.role);
+        }
+    }
+    return nullptr;
+}
+
+class BreakpointCondition::Parser
+{
+public:
+    Parser(const QByteArray &text, RzReg *reg, int pointerSize, BreakpointCondition *condition)
+        : text(text), reg(reg), pointerSize(pointerSize), condition(condition)
+    {
+    }
+
+    /// Parse against register names and sizes only, without any register items
+    Parser(const QByteArray &text, const QHash<QString, int> *registers,
+           BreakpointCondition *condition)
+        : text(text), registers(registers), condition(condition)
+    {
+    }
+
+    void parse()
+    {
+        skipSpaces();
+        if (pos >= text.size()) {
+            fail(tr("The condition is empty"));
+            return;
+        }
+        if (parseBinary(1)) {
+            skipSpaces();
+            if (pos < text.size()) {
+                fail(tr("Unexpected \"%1\"").arg(QString::fromUtf8(text.mid(pos))));
+            }
+        }
+    }
+
+private:
+    bool fail(const QString &message)
+    {
+        if (condition->error.isEmpty()) {
+            condition->error = message;
+        }
+        condition->code.clear();
+        return false;
+    }
+
+    bool append(Op op, int depthChange, ut64 value = 0, RzRegItem *item = nullptr,
+                quint8 size = 0)
+    {
+        depth += depthChange;
+        if (depth > MaxDepth) {
+            return fail(tr("The condition is too complex"));
+        }
+        condition->code.append({ op, size, value, item });
+        return true;
+    }
+
+    void skipSpaces()
+    {
+        while (pos < text.size() && isspace(static_cast<unsigned char>(text.at(pos)))) {
+            pos++;
+        }
+    }
+
+    bool accept(const char *token)
+    {
+        skipSpaces();
+        int length = static_cast<int>(strlen(token));
+        if (text.mid(pos, length) != token) {
+            return false;
+        }
+        pos += length;
+        return true;
+    }
+
+    /// Binary operator at the current position, longest tokens first
+    bool peekBinary(Op *op, int *precedence, int *length)
+    {
+        static const struct
+        {
+            const char *token;
+            Op op;
+            int precedence;
+        } operators[] = {
+            { "||", Op::LogicalOr, 1 }, { "&&", Op::LogicalAnd, 2 }, { "==", Op::Eq, 6 },
+            { "!=", Op::Ne, 6 },        { "<=", Op::Le, 7 },         { ">=", Op::Ge, 7 },
+            { "<<", Op::Shl, 8 },       { ">>", Op::Shr, 8 },        { "|", Op::Or, 3 },
+            { "^", Op::Xor, 4 },        { "&", Op::And, 5 },         { "<", Op::Lt, 7 },
+            { ">", Op::Gt, 7 },         { "+", Op::Add, 9 },         { "-", Op::Sub, 9 },
+            { "*", Op::Mul, 10 },       { "/", Op::Div, 10 },        { "%", Op::Mod, 10 },
+        };
+        skipSpaces();
+        for (const auto &candidate : operators) {
+            int tokenLength = static_cast<int>(strlen(candidate.token));
+            if (text.mid(pos, tokenLength) == candidate.token) {
+                *op = candidate.op;
+                *precedence = candidate.precedence;
+                *length = tokenLength;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseBinary(int minPrecedence)
+    {
+        if (!parseUnary()) {
+            return false;
+        }
+        Op op;
+        int precedence;
+        int length;
+        while (peekBinary(&op, &precedence, &length) && precedence >= minPrecedence) {
+            pos += length;
+            if (!parseBinary(precedence + 1) || !append(op, -1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool parseUnary()
+    {
+        if (accept("-")) {
+            return parseUnary() && append(Op::Neg, 0);
+        }
+        if (accept("~")) {
+            return parseUnary() && append(Op::BitNot, 0);
+        }
+        // Not to be confused with !=, which can't start an operand anyway
+        if (accept("!")) {
+            return parseUnary() && append(Op::Not, 0);
+        }
+        return parsePrimary();
+    }
+
+    bool parseLoad(int size)
+    {
+        if (!parseBinary(1)) {
+            return false;
+        }
+        if (!accept("]")) {
+            return fail(tr("Missing \"]\""));
+        }
+        return append(Op::Load, 0, 0, nullptr, static_cast<quint8>(size));
+    }
+
+    bool parsePrimary()
+    {
+        skipSpaces();
+        if (pos >= text.size()) {
+            return fail(tr("Unexpected end of the condition"));
+        }
+        if (accept("(")) {
+            if (!parseBinary(1)) {
+                return false;
+            }
+            return accept(")") || fail(tr("Missing \")\""));
+        }
+        if (accept("[")) {
+            return parseLoad(pointerSize);
+        }
+
+        int begin = pos;
+        char c = text.at(pos);
+        if (isdigit(static_cast<unsigned char>(c))) {
+            while (pos < text.size() && isalnum(static_cast<unsigned char>(text.at(pos)))) {
+                pos++;
+            }
+            QByteArray number = text.mid(begin, pos - begin);
+            bool ok;
+            ut64 value = number.startsWith("0x") || number.startsWith("0X")
+                    ? number.mid(2).toULongLong(&ok, 16)
+                    : number.toULongLong(&ok, 10);
+            if (!ok) {
+                return fail(tr("Invalid number \"%1\"").arg(QString::fromUtf8(number)));
+            }
+            return append(Op::Push, 1, value);
+        }
+        if (!isalpha(static_cast<unsigned char>(c)) && c != '_') {
+            return fail(tr("Unexpected \"%1\"").arg(QString::fromUtf8(text.mid(pos))));
+        }
+        while (pos < text.size()
+               && (isalnum(static_cast<unsigned char>(text.at(pos))) || text.at(pos) == '_'
+                   || text.at(pos) == '.')) {
+            pos++;
+        }
+        QByteArray name = text.mid(begin, pos - begin);
+
+        static const struct
+        {
+            const char *name;
+            int size;
+        } sizes[] = { { "byte", 1 }, { "word", 2 }, { "dword", 4 }, { "qword", 8 } };
+        for (const auto &size : sizes) {
+            if (name == size.name && accept("[")) {
+                return parseLoad(size.size);
+            }
+        }
+        if (name == "hits") {
+            return append(Op::Hits, 1);
+        }
+
+        if (registers) {
+            auto it = registers->constFind(QString::fromUtf8(name));
+            if (it == registers->constEnd()) {
+                return fail(tr("Unknown register \"%1\"").arg(QString::fromUtf8(name)));
+            }
+            if (it.value() > 64) {
+                return fail(
+                        tr("Register \"%1\" is wider than 64 bits").arg(QString::fromUtf8(name)));
+            }
+            return append(Op::Register, 1);
+        }
+
+        RzRegItem *item = rz_reg_get(reg, name.constData(), -1);
+        if (!item) {
+            const char *roleName = aliasedRegisterName(reg, name);
+            if (roleName) {
+                item = rz_reg_get(reg, roleName, -1);
+            }
+        }
+        if (!item) {
+            return fail(tr("Unknown register \"%1\"").arg(QString::fromUtf8(name)));
+        }
+        if (item->size > 64) {
+            return fail(tr("Register \"%1\" is wider than 64 bits").arg(QString::fromUtf8(name)));
+        }
+        return append(Op::Register, 1, 0, item);
+    }
+
+    QByteArray text;
+    RzReg *reg = nullptr;
+    const QHash<QString, int> *registers = nullptr;
+    int pointerSize = 8;
+    BreakpointCondition *condition;
+    int pos = 0;
+    int depth = 0;
+};
+
+BreakpointCondition BreakpointCondition::compile(const QString &expression, RzCore *core)
+{
+    BreakpointCondition condition;
+    RzReg *reg = DebugSnapshot::getReg(core);
+    int pointerSize = qBound<int>(1, rz_config_get_i(core->config, "asm.bits") / 8, 8);
+    condition.bigEndian = rz_config_get_b(core->config, "cfg.bigendian");
+    if (!reg) {
+        condition.error = tr("No registers");
+        return condition;
+    }
+    Parser(expression.toUtf8(), reg, pointerSize, &condition).parse();
+    return condition;
+}
+
+QHash<QString, int> BreakpointCondition::registerSizes(RzCore *core)
+{
+    QHash<QString, int> sizes;
+    RzReg *reg = DebugSnapshot::getReg(core);
+    if (!reg) {
+        return sizes;
+    }
+    for (int type = 0; type < RZ_REG_TYPE_LAST; type++) {
+        RzListIter *it;
+        RzRegItem *item;
+        CutterRzListForeach (reg->regset[type].regs, it, RzRegItem, item) {
+            sizes.insert(QString::fromUtf8(item->name), item->size);
+        }
+    }
+    for (const auto &role : registerRoles) {
+        const char *roleName = rz_reg_get_name(reg, role.role);
+        RzRegItem *item = roleName ? rz_reg_get(reg, roleName, -1) : nullptr;
+        if (item && !sizes.contains(QString::fromUtf8(role.name))) {
+            sizes.insert(QString::fromUtf8(role.name), item->size);
+        }
+    }
+    return sizes;
+}
+
+QString BreakpointCondition::check(const QString &expression,
+                                   const QHash<QString, int> &registers)
+{
+    BreakpointCondition condition;
+    if (registers.isEmpty()) {
+        return tr("No registers");
+    }
+    Parser(expression.toUtf8(), &registers, &condition).parse();
+    return condition.error;
+}
+
+bool BreakpointCondition::evaluate(RzCore *core, quint64 hits) const
+{
+    if (code.isEmpty()) {
+        // Better to stop too often than to miss a hit because of a broken condition
+        return true;
+    }
+
+    RzReg *reg = DebugSnapshot::getReg(core);
+    ut64 stack[MaxDepth];
+    int top = 0;
+    for (const Instruction &instruction : code) {
+        ut64 &a = stack[qMax(top - 1, 0)];
+        switch (instruction.op) {
+        case Op::Push:
+            stack[top++] = instruction.value;
+            continue;
+        case Op::Register:
+            stack[top++] = rz_reg_get_value(reg, instruction.reg);
+            continue;
+        case Op::Hits:
+            stack[top++] = hits;
+            continue;
+        case Op::Load: {
+            ut8 buf[8];
+            ut64 value = 0;
+            if (rz_io_read_at(core->io, a, buf, instruction.size)) {
+                for (int i = 0; i < instruction.size; i++) {
+                    int shift = bigEndian ? (instruction.size - 1 - i) * 8 : i * 8;
+                    value |= static_cast<ut64>(buf[i]) << shift;
+                }
+            }
+            a = value;
+            continue;
+        }
+        case Op::Neg:
+            a = 0 - a;
+            continue;
+        case Op::Not:
+            a = !a;
+            continue;
+        case Op::BitNot:
+            a = ~a;
+            continue;
+        default:
+            break;
+        }
+
+        // Binary operators, all unsigned
+        ut64 b = stack[--top];
+        ut64 &left = stack[top - 1];
+        switch (instruction.op) {
+        case Op::Add:
+            left += b;
+            break;
+        case Op::Sub:
+            left -= b;
+            break;
+        case Op::Mul:
+            left *= b;
+            break;
+        case Op::Div:
+            left = b ? left / b : 0;
+            break;
+        case Op::Mod:
+            left = b ? left % b : 0;
+            break;
+        case Op::And:
+            left &= b;
+            break;
+        case Op::Or:
+            left |= b;
+            break;
+        case Op::Xor:
+            left ^= b;
+            break;
+        case Op::Shl:
+            left = b < 64 ? left << b : 0;
+            break;
+        case Op::Shr:
+            left = b < 64 ? left >> b : 0;
+            break;
+        case Op::Eq:
+            left = left == b;
+            break;
+        case Op::Ne:
+            left = left != b;
+            break;
+        case Op::Lt:
+            left = left < b;
+            break;
+        case Op::Le:
+            left = left <= b;
+            break;
+        case Op::Gt:
+            left = left > b;
+            break;
+        case Op::Ge:
+            left = left >= b;
+            break;
+        case Op::LogicalAnd:
+            left = left && b;
+            break;
+        case Op::LogicalOr:
+            left = left || b;
+            break;
+        default:
+            break;
+        }
+    }
+    return top > 0 && stack[top - 1] != 0;
+}
@@ -0,0 +1,113 @@
+#ifndef CUTTER_BREAKPOINTCONDITION_H
+#define CUTTER_BREAKPOINTCONDITION_H
+
+#include "CutterCommon.h"
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Breakpoint condition compiled once and evaluated by the debug task at each hit
+ *
+ * Unlike the rizin condition of a breakpoint, which is a command run at each hit, this is a
+ * C-like expression compiled into postfix code, so a hit which doesn't match costs a register
+ * sync and maybe a few memory reads before the debuggee continues, without any round trip
+ * through the UI. The expression may use:
+ * - numbers, decimal or with a 0x prefix
+ * - register names, and pc, sp, bp as their aliases
+ * - hits, the number of hits of the breakpoint including the current one
+ * - memory reads as [expr] of pointer size, or byte[expr], word[expr], dword[expr], qword[expr]
+ * - the operators + - * / % & | ^ << >> == != < <= > >= && || ! ~ and parentheses
+ *
+ * The condition matches if the expression is not zero.
+ */
+class CUTTER_EXPORT BreakpointCondition
+{
+    Q_DECLARE_TR_FUNCTIONS(BreakpointCondition)
+
+public:
+    BreakpointCondition() = default;
+
+    /**
+     * @brief Compile \p expression for the registers and architecture \p core currently has
+     *
+     * The register items are looked up once, so the condition must not outlive the register
+     * profile. Requires exclusive access to \p core.
+     */
+    static BreakpointCondition compile(const QString &expression, RzCore *core);
+
+    /**
+     * @brief Size in bits of each register a condition may use, including the aliases
+     *
+     * Requires exclusive access to \p core.
+     */
+    static QHash<QString, int> registerSizes(RzCore *core);
+
+    /**
+     * @brief Error compiling \p expression would give, found without touching the core
+     * @param registers register sizes from registerSizes()
+     * @return empty string if the expression is valid
+     */
+    static QString check(const QString &expression, const QHash<QString, int> &registers);
+
+    bool isValid() const { return error.isEmpty(); }
+    QString getError() const { return error; }
+
+    /**
+     * @brief Evaluate the condition for the current registers, which must be synced
+     *
+     * An invalid condition always matches.
+     */
+    bool evaluate(RzCore *core, quint64 hits) const;
+
+private:
+    enum class Op : quint8 {
+        Push,
+        Register,
+        Hits,
+        Load,
+        Neg,
+        Not,
+        BitNot,
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Mod,
+        And,
+        Or,
+        Xor,
+        Shl,
+        Shr,
+        Eq,
+        Ne,
+        Lt,
+        Le,
+        Gt,
+        Ge,
+        LogicalAnd,
+        LogicalOr
+    };
+
+    struct Instruction
+    {
+        Op op;
+        /// Size of a Load
+        quint8 size;
+        ut64 value;
+        RzRegItem *reg;
+    };
+
+    /// Deepest stack the evaluation may need
+    static constexpr int MaxDepth = 32;
+
+    class Parser;
+
+    QVector<Instruction> code;
+    QString error;
+    bool bigEndian = false;
+};
+
+#endif // CUTTER_BREAKPOINTCONDITION_H
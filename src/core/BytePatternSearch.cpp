@@ -0,0 +1,461 @@
+#include "BytePatternSearch.h"
+
+#include "Cutter.h"
+#include "common/Helpers.h"
+
+#include <QCoreApplication>
+#include <QMap>
+#include <QMutex>
+#include <QQueue>
+#include <QRegularExpression>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kChunkSize = 4 * 1024 * 1024;
+// Chunks read ahead of the matching threads per thread, bounds the memory used
+constexpr int kQueuedChunksPerThread = 2;
+
+int hexDigit(QChar c)
+{
+    if (c >= QLatin1Char('0') && c <= QLatin1Char('9')) {
+        return c.unicode() - '0';
+    }
+    if (c >= QLatin1Char('a') && c <= QLatin1Char('f')) {
+        return c.unicode() - 'a' + 10;
+    }
+    if (c >= QLatin1Char('A') && c <= QLatin1Char('F')) {
+        return c.unicode() - 'A' + 10;
+    }
+    return -1;
+}
+
+bool isWildcard(QChar c)
+{
+    return c == QLatin1Char('?') || c == QLatin1Char('.');
+}
+
+QString stripWhitespace(const QString &s)
+{
+    QString r;
+    r.reserve(s.size());
+    for (const QChar c : s) {
+        if (!c.isSpace()) {
+            r.append(c);
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief Parse hex digits and wildcard nibbles into values and masks
+ */
+bool parseHex(const QString &hex, bool allowWildcards, QByteArray *value, QByteArray *mask,
+              QString *error)
+{
+    if (hex.size() % 2 != 0) {
+        if (error) {
+            *error = QCoreApplication::translate("BytePattern", "Odd number of hex digits in %1")
+                             .arg(hex);
+        }
+        return false;
+    }
+    value->resize(hex.size() / 2);
+    mask->resize(hex.size() / 2);
+    for (int i = 0; i < hex.size(); i += 2) {
+        uchar byteValue = 0;
+        uchar byteMask = 0;
+        for (int j = 0; j < 2; j++) {
+            QChar c = hex.at(i + j);
+            int digit = hexDigit(c);
+            byteValue <<= 4;
+            byteMask <<= 4;
+            if (digit >= 0) {
+                byteValue |= digit;
+                byteMask |= 0xf;
+            } else if (!allowWildcards || !isWildcard(c)) {
+                if (error) {
+                    *error = QCoreApplication::translate("BytePattern", "Invalid character '%1'")
+                                     .arg(c);
+                }
+                return false;
+            }
+        }
+        (*value)[i / 2] = static_cast<char>(byteValue);
+        (*mask)[i / 2] = static_cast<char>(byteMask);
+    }
+    return true;
+}
+
+}
+
+bool BytePattern::parse(const QString &text, BytePattern *pattern, QString *error)
+{
+    const QString stripped = stripWhitespace(text);
+    const int maskSeparator = stripped.indexOf(QLatin1Char(':'));
+    const QString hex = maskSeparator >= 0 ? stripped.left(maskSeparator) : stripped;
+
+    BytePattern r;
+    if (!parseHex(hex, true, &r.value, &r.mask, error)) {
+        return false;
+    }
+    if (r.value.isEmpty()) {
+        if (error) {
+            *error = QCoreApplication::translate("BytePattern", "Empty pattern");
+        }
+        return false;
+    }
+
+    if (maskSeparator >= 0) {
+        QByteArray explicitMask;
+        QByteArray unused;
+        if (!parseHex(stripped.mid(maskSeparator + 1), false, &explicitMask, &unused, error)) {
+            return false;
+        }
+        // Like "/x", a shorter mask leaves the remaining bytes unmasked
+        for (int i = 0; i < explicitMask.size() && i < r.mask.size(); i++) {
+            r.mask[i] = static_cast<char>(r.mask.at(i) & explicitMask.at(i));
+        }
+    }
+
+    bool hasFixedByte = false;
+    for (int i = 0; i < r.value.size(); i++) {
+        r.value[i] = static_cast<char>(r.value.at(i) & r.mask.at(i));
+        hasFixedByte = hasFixedByte || static_cast<uchar>(r.mask.at(i)) == 0xff;
+    }
+    if (!hasFixedByte) {
+        if (error) {
+            *error = QCoreApplication::translate("BytePattern",
+                                                 "Pattern %1 needs at least one byte without "
+                                                 "wildcards")
+                             .arg(text);
+        }
+        return false;
+    }
+
+    *pattern = r;
+    return true;
+}
+
+bool BytePattern::parseList(const QString &text, QVector<BytePattern> *patterns, QString *error)
+{
+    QVector<BytePattern> r;
+    const QStringList parts = text.split(QRegularExpression("[,;]"), CUTTER_QT_SKIP_EMPTY_PARTS);
+    for (const QString &part : parts) {
+        if (part.trimmed().isEmpty()) {
+            continue;
+        }
+        BytePattern pattern;
+        if (!parse(part, &pattern, error)) {
+            return false;
+        }
+        r.append(pattern);
+    }
+    if (r.isEmpty()) {
+        if (error) {
+            *error = QCoreApplication::translate("BytePattern", "Empty pattern");
+        }
+        return false;
+    }
+    *patterns = r;
+    return true;
+}
+
+BytePatternMatcher::BytePatternMatcher(const QVector<BytePattern> &patterns) : patterns(patterns)
+{
+    for (const BytePattern &pattern : patterns) {
+        maxSize = qMax(maxSize, pattern.size());
+
+        // Longest run of bytes without wildcards
+        Anchor anchor = { 0, 0 };
+        int runStart = 0;
+        for (int i = 0; i <= pattern.size(); i++) {
+            if (i < pattern.size() && static_cast<uchar>(pattern.mask.at(i)) == 0xff) {
+                continue;
+            }
+            if (i - runStart > anchor.size) {
+                anchor = { runStart, i - runStart };
+            }
+            runStart = i + 1;
+        }
+        anchors.append(anchor);
+    }
+    if (patterns.size() > 1) {
+        buildAutomaton();
+    }
+}
+
+void BytePatternMatcher::buildAutomaton()
+{
+    std::array<int, 256> empty;
+    empty.fill(-1);
+
+    // Trie of all anchors
+    transitions.append(empty);
+    outputs.append(QVector<int>());
+    for (int p = 0; p < patterns.size(); p++) {
+        const Anchor &anchor = anchors[p];
+        int state = 0;
+        for (int i = 0; i < anchor.size; i++) {
+            uchar c = static_cast<uchar>(patterns[p].value.at(anchor.offset + i));
+            if (transitions[state][c] < 0) {
+                transitions[state][c] = transitions.size();
+                transitions.append(empty);
+                outputs.append(QVector<int>());
+            }
+            state = transitions[state][c];
+        }
+        outputs[state].append(p);
+    }
+
+    // Breadth-first, complete the transitions with the failure links and merge the outputs of
+    // the failure state, so that scanning needs a single table lookup per byte.
+    QVector<int> failure(transitions.size(), 0);
+    QQueue<int> queue;
+    for (int c = 0; c < 256; c++) {
+        int next = transitions[0][c];
+        if (next < 0) {
+            transitions[0][c] = 0;
+        } else {
+            failure[next] = 0;
+            queue.enqueue(next);
+        }
+    }
+    while (!queue.isEmpty()) {
+        int state = queue.dequeue();
+        outputs[state] += outputs[failure[state]];
+        for (int c = 0; c < 256; c++) {
+            int next = transitions[state][c];
+            if (next < 0) {
+                transitions[state][c] = transitions[failure[state]][c];
+            } else {
+                failure[next] = transitions[failure[state]][c];
+                queue.enqueue(next);
+            }
+        }
+    }
+}
+
+bool BytePatternMatcher::verify(const uchar *data, size_t size, size_t start, int pattern) const
+{
+    const BytePattern &p = patterns[pattern];
+    if (start + p.size() > size) {
+        return false;
+    }
+    const uchar *value = reinterpret_cast<const uchar *>(p.value.constData());
+    const uchar *mask = reinterpret_cast<const uchar *>(p.mask.constData());
+    for (int i = 0; i < p.size(); i++) {
+        if ((data[start + i] & mask[i]) != value[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BytePatternMatcher::scan(const uchar *data, size_t size, size_t reportSize,
+                              const std::function<bool(size_t, int)> &callback) const
+{
+    if (patterns.size() == 1) {
+        const Anchor &anchor = anchors.first();
+        const uchar first = static_cast<uchar>(patterns.first().value.at(anchor.offset));
+        // Anchor positions of matches starting before reportSize
+        const size_t anchorEnd = qMin(size, reportSize + anchor.offset);
+        size_t pos = anchor.offset;
+        while (pos < anchorEnd) {
+            const void *hit = memchr(data + pos, first, anchorEnd - pos);
+            if (!hit) {
+                break;
+            }
+            pos = static_cast<const uchar *>(hit) - data;
+            size_t start = pos - anchor.offset;
+            if (verify(data, size, start, 0) && !callback(start, 0)) {
+                return false;
+            }
+            pos++;
+        }
+        return true;
+    }
+
+    int state = 0;
+    for (size_t pos = 0; pos < size; pos++) {
+        state = transitions[state][data[pos]];
+        for (int p : outputs[state]) {
+            const Anchor &anchor = anchors[p];
+            // pos is the last byte of the anchor
+            size_t anchorStart = pos + 1 - anchor.size;
+            if (anchorStart < static_cast<size_t>(anchor.offset)) {
+                continue;
+            }
+            size_t start = anchorStart - anchor.offset;
+            if (start >= reportSize) {
+                continue;
+            }
+            if (verify(data, size, start, p) && !callback(start, p)) {
+                return false;
+            }
+        }
+        if (pos >= reportSize + maxSize) {
+            break;
+        }
+    }
+    return true;
+}
+
+BytePatternSearch::BytePatternSearch(const QVector<BytePattern> &patterns) : matcher(patterns) {}
+
+bool BytePatternSearch::run(const QList<AddressRangeDescription> &ranges, int maxResults,
+                            const ResultsCallback &resultsCallback,
+                            const ProgressCallback &progressCallback, int threads)
+{
+    struct Chunk
+    {
+        /// Position in the searched ranges, results are reported in this order
+        int sequence;
+        RVA address;
+        int reportSize;
+        QByteArray data;
+    };
+
+    if (threads <= 0) {
+        threads = qMax(1, QThread::idealThreadCount());
+    }
+
+    QMutex queueMutex;
+    QWaitCondition chunkQueued;
+    QWaitCondition chunkTaken;
+    QQueue<Chunk> queue;
+    bool readingDone = false;
+    std::atomic<bool> stopped(false);
+
+    QMutex resultsMutex;
+    int found = 0;
+    /// Results of the chunks matched before all earlier chunks were
+    QMap<int, QList<SearchDescription>> pendingResults;
+    int nextSequence = 0;
+
+    auto stop = [&]() {
+        QMutexLocker locker(&queueMutex);
+        stopped = true;
+        chunkQueued.wakeAll();
+        chunkTaken.wakeAll();
+    };
+
+    auto matchChunks = [&]() {
+        const QVector<BytePattern> &patterns = matcher.getPatterns();
+        while (true) {
+            Chunk chunk;
+            {
+                QMutexLocker locker(&queueMutex);
+                while (queue.isEmpty() && !readingDone && !stopped) {
+                    chunkQueued.wait(&queueMutex);
+                }
+                if (queue.isEmpty() || stopped) {
+                    return;
+                }
+                chunk = queue.dequeue();
+                chunkTaken.wakeOne();
+            }
+
+            const uchar *data = reinterpret_cast<const uchar *>(chunk.data.constData());
+            QList<SearchDescription> results;
+            bool complete = matcher.scan(
+                    data, chunk.data.size(), chunk.reportSize, [&](size_t offset, int pattern) {
+                        SearchDescription result;
+                        result.offset = chunk.address + offset;
+                        result.size = patterns[pattern].size();
+                        result.data = chunk.data.mid(static_cast<int>(offset), result.size).toHex();
+                        results.append(result);
+                        return !stopped;
+                    });
+            if (!complete) {
+                return;
+            }
+            std::sort(results.begin(), results.end(),
+                      [](const SearchDescription &a, const SearchDescription &b) {
+                          return a.offset < b.offset;
+                      });
+
+            // Chunks finish in any order, so the results are reported in the order of the
+            // chunks and the limit keeps the first ones
+            QMutexLocker locker(&resultsMutex);
+            if (stopped) {
+                return;
+            }
+            pendingResults.insert(chunk.sequence, results);
+            while (pendingResults.contains(nextSequence)) {
+                QList<SearchDescription> next = pendingResults.take(nextSequence++);
+                if (next.isEmpty()) {
+                    continue;
+                }
+                bool limitReached = false;
+                if (maxResults > 0 && found + next.size() >= maxResults) {
+                    next = next.mid(0, maxResults - found);
+                    limitReached = true;
+                }
+                found += next.size();
+                if (!resultsCallback(next) || limitReached) {
+                    stop();
+                    return;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(matchChunks);
+    }
+
+    ut64 total = 0;
+    for (const AddressRangeDescription &range : ranges) {
+        total += range.end - range.begin;
+    }
+    ut64 searched = 0;
+    const ut64 overlap = matcher.maxPatternSize() - 1;
+    int sequence = 0;
+    for (const AddressRangeDescription &range : ranges) {
+        RVA chunkBegin = range.begin;
+        while (chunkBegin < range.end && !stopped) {
+            RVA chunkEnd = chunkBegin + qMin<ut64>(kChunkSize, range.end - chunkBegin);
+            RVA readEnd = chunkEnd + qMin(overlap, range.end - chunkEnd);
+
+            // Reading takes the core lock, matching happens without it
+            Chunk chunk;
+            chunk.sequence = sequence++;
+            chunk.address = chunkBegin;
+            chunk.reportSize = static_cast<int>(chunkEnd - chunkBegin);
+            chunk.data = Core()->ioRead(chunkBegin, static_cast<int>(readEnd - chunkBegin));
+            {
+                QMutexLocker locker(&queueMutex);
+                while (queue.size() >= threads * kQueuedChunksPerThread && !stopped) {
+                    chunkTaken.wait(&queueMutex);
+                }
+                queue.enqueue(chunk);
+                chunkQueued.wakeOne();
+            }
+
+            searched += chunkEnd - chunkBegin;
+            if (progressCallback && !progressCallback(searched, total)) {
+                stop();
+            }
+            chunkBegin = chunkEnd;
+        }
+    }
+
+    {
+        QMutexLocker locker(&queueMutex);
+        readingDone = true;
+        chunkQueued.wakeAll();
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    return !stopped;
+}
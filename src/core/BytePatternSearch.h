@@ -0,0 +1,124 @@
+#ifndef CUTTER_BYTEPATTERNSEARCH_H
+#define CUTTER_BYTEPATTERNSEARCH_H
+
+#include "CutterCommon.h"
+#include "CutterDescriptions.h"
+
+#include <QByteArray>
+#include <QVector>
+
+#include <array>
+#include <functional>
+
+/**
+ * @brief Byte pattern with a per-byte mask, a byte matches if (byte & mask) == value
+ */
+struct CUTTER_EXPORT BytePattern
+{
+    QByteArray value;
+    QByteArray mask;
+
+    int size() const { return value.size(); }
+
+    /**
+     * @brief Parse a hex pattern
+     *
+     * Nibbles may be replaced by '?' or '.' to match anything, e.g. "e8????????" or "4?8b".
+     * An explicit mask can be appended after ':', like in "/x", e.g. "9090ff:ff00ff".
+     * Whitespace is ignored.
+     *
+     * @param error set to a description of the problem if parsing fails
+     */
+    static bool parse(const QString &text, BytePattern *pattern, QString *error = nullptr);
+
+    /**
+     * @brief Parse a list of patterns separated by ',' or ';'
+     */
+    static bool parseList(const QString &text, QVector<BytePattern> *patterns,
+                          QString *error = nullptr);
+};
+
+/**
+ * @brief Matches a set of BytePatterns in one pass over a buffer
+ *
+ * Each pattern is anchored at its longest run of unmasked bytes. With a single pattern the first
+ * anchor byte is located with memchr(), which is vectorized by the C library; with several
+ * patterns all anchors are located at once by an Aho-Corasick automaton. Anchor hits are then
+ * verified against the full masked pattern.
+ */
+class CUTTER_EXPORT BytePatternMatcher
+{
+public:
+    explicit BytePatternMatcher(const QVector<BytePattern> &patterns);
+
+    int maxPatternSize() const { return maxSize; }
+    const QVector<BytePattern> &getPatterns() const { return patterns; }
+
+    /**
+     * @brief Find all matches starting before \p reportSize in \p data
+     * @param callback called with the offset and pattern index of every match in increasing
+     * offset order for each pattern, return false to stop
+     * @return false if stopped by \p callback
+     */
+    bool scan(const uchar *data, size_t size, size_t reportSize,
+              const std::function<bool(size_t offset, int pattern)> &callback) const;
+
+private:
+    struct Anchor
+    {
+        int offset;
+        int size;
+    };
+
+    QVector<BytePattern> patterns;
+    QVector<Anchor> anchors;
+    int maxSize = 0;
+
+    // Aho-Corasick automaton over the anchors, as a complete DFA
+    QVector<std::array<int, 256>> transitions;
+    QVector<QVector<int>> outputs;
+
+    void buildAutomaton();
+    bool verify(const uchar *data, size_t size, size_t start, int pattern) const;
+};
+
+/**
+ * @brief Multi-threaded native search for byte patterns in memory
+ *
+ * The calling thread reads the searched ranges chunk by chunk through CutterCore::ioRead() and
+ * hands them to a pool of worker threads which match them. Reading stays in the calling thread,
+ * so it is safe to start a search while holding the core lock.
+ */
+class CUTTER_EXPORT BytePatternSearch
+{
+public:
+    /**
+     * @brief Called from worker threads with the matches of one chunk, never concurrently
+     *
+     * The matches are reported in the order of the searched ranges and by address within them.
+     * @return false to stop the search
+     */
+    using ResultsCallback = std::function<bool(const QList<SearchDescription> &results)>;
+
+    /**
+     * @brief Called from the calling thread after each chunk is read
+     * @return false to stop the search
+     */
+    using ProgressCallback = std::function<bool(ut64 searched, ut64 total)>;
+
+    explicit BytePatternSearch(const QVector<BytePattern> &patterns);
+
+    /**
+     * @param maxResults stop after the first this many results, 0 for no limit
+     * @param threads number of matching threads, 0 for one per core
+     * @return false if the search was stopped before searching all ranges
+     */
+    bool run(const QList<AddressRangeDescription> &ranges, int maxResults,
+             const ResultsCallback &resultsCallback,
+             const ProgressCallback &progressCallback = nullptr, int threads = 0);
+
+private:
+    BytePatternMatcher matcher;
+};
+
+#endif // CUTTER_BYTEPATTERNSEARCH_H
@@ -0,0 +1,313 @@
+#include "core/CoreLockProfiler.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QSet>
+#include <QStringList>
+#include <QThread>
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+/// Number of RzCoreLocked of the current thread, including the ones not measured
+thread_local int lockDepth = 0;
+thread_local const char *currentScope = nullptr;
+
+bool isGuiThread()
+{
+    QCoreApplication *app = QCoreApplication::instance();
+    return app && QThread::currentThread() == app->thread();
+}
+
+/// Names of tasks given to CoreLockScope and the stall watchdog, never freed
+QMutex internedNamesMutex;
+QSet<QByteArray> internedNames;
+
+}
+
+void CoreLockProfiler::Histogram::add(qint64 us)
+{
+    int bucket = 0;
+    while (bucket + 1 < BucketCount && (qint64(1) << bucket) <= us) {
+        bucket++;
+    }
+    buckets[bucket]++;
+    count++;
+    totalUs += us;
+    maxUs = qMax(maxUs, us);
+}
+
+qint64 CoreLockProfiler::Histogram::percentileUs(double percentile) const
+{
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; i++) {
+        seen += buckets[i];
+        if (seen && seen >= percentile * count) {
+            return qMin(qint64(1) << i, maxUs);
+        }
+    }
+    return maxUs;
+}
+
+QString CoreLockProfiler::Histogram::bucketsText() const
+{
+    QStringList text;
+    for (int i = 0; i < BucketCount; i++) {
+        if (!buckets[i]) {
+            continue;
+        }
+        QString bound = i + 1 < BucketCount
+                ? QStringLiteral("<%1").arg(formatDuration(qint64(1) << i))
+                : QStringLiteral(">=%1").arg(formatDuration(qint64(1) << (i - 1)));
+        text << QStringLiteral("%1: %2").arg(bound).arg(buckets[i]);
+    }
+    return text.join(QStringLiteral(", "));
+}
+
+QString CoreLockProfiler::formatDuration(qint64 us)
+{
+    if (us < 1000) {
+        return QStringLiteral("%1 us").arg(us);
+    }
+    if (us < 1000000) {
+        return QStringLiteral("%1 ms").arg(us / 1000.0, 0, 'f', 1);
+    }
+    return QStringLiteral("%1 s").arg(us / 1000000.0, 0, 'f', 2);
+}
+
+CoreLockProfiler *CoreLockProfiler::instance()
+{
+    static CoreLockProfiler profiler;
+    return &profiler;
+}
+
+void CoreLockProfiler::setEnabled(bool enabled)
+{
+    this->enabled.storeRelease(enabled ? 1 : 0);
+}
+
+void CoreLockProfiler::reset()
+{
+    QMutexLocker locker(&mutex);
+    entries.clear();
+}
+
+QList<CoreLockProfiler::Entry> CoreLockProfiler::getEntries() const
+{
+    QList<Entry> result;
+    {
+        QMutexLocker locker(&mutex);
+        result = entries.values();
+    }
+    std::sort(result.begin(), result.end(), [](const Entry &a, const Entry &b) {
+        return a.wait.totalUs > b.wait.totalUs;
+    });
+    return result;
+}
+
+QString CoreLockProfiler::toText() const
+{
+    QStringList lines;
+    for (const Entry &entry : getEntries()) {
+        QString caller = entry.scope.isEmpty() ? entry.function
+                                               : QStringLiteral("%1 > %2").arg(entry.scope,
+                                                                               entry.function);
+        lines << QStringLiteral("%1 [%2] %3 times")
+                         .arg(caller, entry.guiThread ? tr("GUI thread") : tr("worker thread"))
+                         .arg(entry.hold.count);
+        auto summary = [](const Histogram &histogram) {
+            return tr("total %1, p50 %2, p99 %3, max %4")
+                    .arg(formatDuration(histogram.totalUs),
+                         formatDuration(histogram.percentileUs(0.5)),
+                         formatDuration(histogram.percentileUs(0.99)),
+                         formatDuration(histogram.maxUs));
+        };
+        lines << QStringLiteral("    %1 %2").arg(tr("wait:"), summary(entry.wait));
+        lines << QStringLiteral("        %1").arg(entry.wait.bucketsText());
+        lines << QStringLiteral("    %1 %2").arg(tr("hold:"), summary(entry.hold));
+        lines << QStringLiteral("        %1").arg(entry.hold.bucketsText());
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+bool CoreLockProfiler::save(const QString &file, QString *error) const
+{
+    QFile output(file);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        *error = output.errorString();
+        return false;
+    }
+    QByteArray text = toText().toUtf8() + '\n';
+    if (output.write(text) != text.size()) {
+        *error = output.errorString();
+        return false;
+    }
+    return true;
+}
+
+qint64 CoreLockProfiler::lockRequested()
+{
+    if (lockDepth++ > 0) {
+        return -1;
+    }
+    qint64 now = nowNs();
+    if (isGuiThread()) {
+        instance()->guiWaitSinceNs.storeRelease(now);
+    }
+    return now;
+}
+
+CoreLockProfiler::Hold CoreLockProfiler::lockAcquired(qint64 requestedNs, const char *function)
+{
+    Hold hold;
+    if (requestedNs < 0) {
+        return hold;
+    }
+    CoreLockProfiler *profiler = instance();
+    bool gui = isGuiThread();
+    if (gui) {
+        profiler->guiWaitSinceNs.storeRelease(0);
+    }
+    hold.acquiredNs = nowNs();
+    hold.waitNs = hold.acquiredNs - requestedNs;
+    hold.scope = currentScope;
+    hold.function = function;
+    hold.recorded = profiler->isEnabled();
+
+    profiler->holderScope.storeRelease(hold.scope);
+    profiler->holderFunction.storeRelease(hold.function);
+    profiler->holderGuiThread.storeRelease(gui ? 1 : 0);
+    profiler->holderSinceNs.storeRelease(hold.acquiredNs);
+    return hold;
+}
+
+void CoreLockProfiler::lockReleased(const Hold &hold)
+{
+    lockDepth--;
+    if (hold.acquiredNs < 0) {
+        return;
+    }
+    CoreLockProfiler *profiler = instance();
+    profiler->holderSinceNs.storeRelease(0);
+    if (hold.recorded) {
+        profiler->record(hold, nowNs());
+    }
+}
+
+CoreLockProfiler::Holder CoreLockProfiler::getHolder()
+{
+    CoreLockProfiler *profiler = instance();
+    Holder holder;
+    qint64 since = profiler->holderSinceNs.loadAcquire();
+    if (!since) {
+        return holder;
+    }
+    holder.scope = scopeName(profiler->holderScope.loadAcquire());
+    const char *function = profiler->holderFunction.loadAcquire();
+    holder.function = function ? functionName(function) : tr("(unknown)");
+    holder.guiThread = profiler->holderGuiThread.loadAcquire() != 0;
+    holder.heldUs = (nowNs() - since) / 1000;
+    return holder;
+}
+
+qint64 CoreLockProfiler::getGuiWaitUs()
+{
+    qint64 since = instance()->guiWaitSinceNs.loadAcquire();
+    return since ? (nowNs() - since) / 1000 : -1;
+}
+
+QString CoreLockProfiler::getGuiScope()
+{
+    return scopeName(instance()->guiScope.loadAcquire());
+}
+
+qint64 CoreLockProfiler::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+QString CoreLockProfiler::functionName(const char *signature)
+{
+    if (!signature) {
+        return QString();
+    }
+    // "QList<Foo> CutterCore::getFoo(int)" to "CutterCore::getFoo"
+    QString name = QString::fromLatin1(signature);
+    int arguments = name.indexOf(QLatin1Char('('));
+    if (arguments >= 0) {
+        name.truncate(arguments);
+        name = name.mid(name.lastIndexOf(QLatin1Char(' ')) + 1);
+    }
+    return name;
+}
+
+const char *CoreLockProfiler::internName(const QString &name, const char *fallback)
+{
+    if (name.isEmpty()) {
+        return fallback;
+    }
+    QByteArray utf8 = name.left(MaxNameLength).toUtf8();
+    QMutexLocker locker(&internedNamesMutex);
+    auto it = internedNames.constFind(utf8);
+    if (it != internedNames.constEnd()) {
+        return it->constData();
+    }
+    // Commands with addresses in them are all different, don't keep an unbounded number
+    if (internedNames.size() >= MaxInternedNames) {
+        return fallback;
+    }
+    return internedNames.insert(utf8)->constData();
+}
+
+QString CoreLockProfiler::scopeName(const char *scope)
+{
+    if (!scope) {
+        return QString();
+    }
+    {
+        QMutexLocker locker(&internedNamesMutex);
+        auto it = internedNames.constFind(QByteArray::fromRawData(scope, qstrlen(scope)));
+        if (it != internedNames.constEnd() && it->constData() == scope) {
+            // Titles and commands are shown as they are, they aren't signatures
+            return QString::fromUtf8(scope);
+        }
+    }
+    return functionName(scope);
+}
+
+void CoreLockProfiler::record(const Hold &hold, qint64 releasedNs)
+{
+    Key key = { hold.scope, hold.function, isGuiThread() };
+
+    QMutexLocker locker(&mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        Entry entry;
+        entry.scope = scopeName(hold.scope);
+        entry.function = hold.function ? functionName(hold.function) : tr("(unknown)");
+        entry.guiThread = key.guiThread;
+        it = entries.insert(key, entry);
+    }
+    it->wait.add(hold.waitNs / 1000);
+    it->hold.add((releasedNs - hold.acquiredNs) / 1000);
+}
+
+CoreLockScope::CoreLockScope(const char *scope) : previous(currentScope)
+{
+    currentScope = scope;
+    if (isGuiThread()) {
+        CoreLockProfiler::instance()->guiScope.storeRelease(scope);
+    }
+}
+
+CoreLockScope::~CoreLockScope()
+{
+    currentScope = previous;
+    if (isGuiThread()) {
+        CoreLockProfiler::instance()->guiScope.storeRelease(previous);
+    }
+}
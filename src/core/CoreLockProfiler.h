@@ -0,0 +1,173 @@
+#ifndef CORELOCKPROFILER_H
+#define CORELOCKPROFILER_H
+
+#include "core/CutterCommon.h"
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+/**
+ * @brief Wait and hold times of the core lock, by caller and thread
+ *
+ * Only the outermost RzCoreLocked of a thread is measured, nested ones don't wait and are part
+ * of its hold time. The caller is the innermost CoreLockScope of the thread, e.g. the widget
+ * whose refresh is running, followed by the CutterCore function which took the lock with
+ * CORE_LOCK(). While disabled, only the current holder of the lock is kept, for the
+ * StallWatchdog.
+ */
+class CUTTER_EXPORT CoreLockProfiler
+{
+    Q_DECLARE_TR_FUNCTIONS(CoreLockProfiler)
+
+public:
+    /// Bucket i counts the times from 2^(i-1) up to 2^i us, the last one everything longer
+    static constexpr int BucketCount = 24;
+
+    struct Histogram
+    {
+        quint64 count = 0;
+        qint64 totalUs = 0;
+        qint64 maxUs = 0;
+        quint64 buckets[BucketCount] = {};
+
+        void add(qint64 us);
+        /// Upper bound of the bucket containing the \p percentile
+        qint64 percentileUs(double percentile) const;
+        /// Counts of the buckets which are not empty
+        QString bucketsText() const;
+    };
+
+    struct Entry
+    {
+        QString scope;
+        QString function;
+        bool guiThread = false;
+        Histogram wait;
+        Histogram hold;
+    };
+
+    /// Measurement of an outermost acquisition, kept by the RzCoreLocked until it is released
+    struct Hold
+    {
+        qint64 acquiredNs = -1;
+        qint64 waitNs = 0;
+        const char *scope = nullptr;
+        const char *function = nullptr;
+        bool recorded = false;
+    };
+
+    /// Outermost RzCoreLocked alive right now, read without synchronizing its fields
+    struct Holder
+    {
+        QString scope;
+        QString function;
+        bool guiThread = false;
+        qint64 heldUs = -1;
+    };
+
+    static CoreLockProfiler *instance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled.loadAcquire() != 0; }
+    void reset();
+    /// Entries by decreasing total wait time
+    QList<Entry> getEntries() const;
+
+    QString toText() const;
+    bool save(const QString &file, QString *error) const;
+
+    /// Start of the wait, negative if this acquisition is nested
+    static qint64 lockRequested();
+    static Hold lockAcquired(qint64 requestedNs, const char *function);
+    /// Must be called before the lock is released, so the next holder is not overwritten
+    static void lockReleased(const Hold &hold);
+
+    /// heldUs is negative if nobody holds the lock
+    static Holder getHolder();
+    /// How long the GUI thread is waiting for the lock, negative if it isn't
+    static qint64 getGuiWaitUs();
+    /// Innermost CoreLockScope of the GUI thread
+    static QString getGuiScope();
+    static qint64 nowNs();
+
+    static QString formatDuration(qint64 us);
+    /// Readable name of a function signature from Q_FUNC_INFO
+    static QString functionName(const char *signature);
+    /**
+     * @brief Copy of \p name which lives until the end of the program, for CoreLockScope and
+     * StallWatchdog::taskStarted()
+     *
+     * Returns \p fallback if \p name is empty or too many names were already interned.
+     */
+    static const char *internName(const QString &name, const char *fallback);
+
+private:
+    friend class CoreLockScope;
+
+    struct Key
+    {
+        const char *scope;
+        const char *function;
+        bool guiThread;
+
+        bool operator==(const Key &other) const
+        {
+            return scope == other.scope && function == other.function
+                    && guiThread == other.guiThread;
+        }
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+        friend uint qHash(const Key &key, uint seed = 0)
+#else
+        friend size_t qHash(const Key &key, size_t seed = 0)
+#endif
+        {
+            return qHash(reinterpret_cast<quintptr>(key.scope), seed)
+                    ^ qHash(reinterpret_cast<quintptr>(key.function), seed)
+                    ^ static_cast<uint>(key.guiThread);
+        }
+    };
+
+    static constexpr int MaxNameLength = 120;
+    static constexpr int MaxInternedNames = 1024;
+
+    /// functionName() of \p scope, or \p scope itself if it comes from internName()
+    static QString scopeName(const char *scope);
+    void record(const Hold &hold, qint64 releasedNs);
+
+    QAtomicInt enabled;
+    QAtomicPointer<const char> holderScope;
+    QAtomicPointer<const char> holderFunction;
+    QAtomicInt holderGuiThread;
+    QAtomicInteger<qint64> holderSinceNs;
+    QAtomicInteger<qint64> guiWaitSinceNs;
+    QAtomicPointer<const char> guiScope;
+    mutable QMutex mutex;
+    QHash<Key, Entry> entries;
+};
+
+/**
+ * @brief Attributes the core lock acquisitions of the current thread to \p scope until the end of
+ * the scope
+ *
+ * \p scope must outlive the profiler, e.g. a string literal, a class name from a meta object or a
+ * name from CoreLockProfiler::internName().
+ */
+class CUTTER_EXPORT CoreLockScope
+{
+public:
+    explicit CoreLockScope(const char *scope);
+    ~CoreLockScope();
+    CoreLockScope(const CoreLockScope &) = delete;
+    CoreLockScope &operator=(const CoreLockScope &) = delete;
+
+private:
+    const char *previous;
+};
+
+#define CORE_LOCK_SCOPE() CoreLockScope coreLockScope(Q_FUNC_INFO)
+
+#endif // CORELOCKPROFILER_H
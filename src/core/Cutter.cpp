@@ -6,7 +6,9 @@
 #include <QVector>
 #include <QStringList>
 #include <QStandardPaths>
+#include <QElapsedTimer>
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 
@@ -14,10 +16,16 @@
 #include "common/BasicInstructionHighlighter.h"
 #include "common/Configuration.h"
 #include "common/AsyncTask.h"
+#include "common/AnalysisProfiler.h"
+#include "common/PreviewCache.h"
 #include "common/RizinTask.h"
 #include "dialogs/RizinTaskDialog.h"
 #include "common/Json.h"
 #include "core/Cutter.h"
+#include "core/BreakpointCondition.h"
+#include "core/BytePatternSearch.h"
+#include "core/DebugSnapshot.h"
+#include "common/NameIndexTask.h"
 #include "Decompiler.h"
 
 #include <rz_asm.h>
@@ -120,17 +128,11 @@ static void updateOwnedCharPtr(char *&variable, const QString &newValue)
     variable = strdup(data.data());
 }
 
-static bool reg_sync(RzCore *core, RzRegisterType type, bool write)
-{
-    if (rz_core_is_debug(core)) {
-        return rz_debug_reg_sync(core->dbg, type, write);
-    }
-    return true;
-}
-
-RzCoreLocked::RzCoreLocked(CutterCore *core) : core(core)
+RzCoreLocked::RzCoreLocked(CutterCore *core, const char *function) : core(core)
 {
+    qint64 requested = CoreLockProfiler::lockRequested();
     core->coreMutex.lock();
+    hold = CoreLockProfiler::lockAcquired(requested, function);
     assert(core->coreLockDepth >= 0);
     core->coreLockDepth++;
     if (core->coreLockDepth == 1) {
@@ -147,6 +149,7 @@ RzCoreLocked::~RzCoreLocked()
     if (core->coreLockDepth == 0) {
         core->coreBed = rz_cons_sleep_begin();
     }
+    CoreLockProfiler::lockReleased(hold);
     core->coreMutex.unlock();
 }
 
@@ -160,7 +163,7 @@ RzCore *RzCoreLocked::operator->() const
     return core->core_;
 }
 
-#define CORE_LOCK() RzCoreLocked core(this)
+#define CORE_LOCK() RzCoreLocked core(this, Q_FUNC_INFO)
 
 static void cutterREventCallback(RzEvent *, int type, void *user, void *data)
 {
@@ -226,10 +229,59 @@ void CutterCore::initialize(bool loadPlugins)
 
     // Initialize Async tasks manager
     asyncTaskManager = new AsyncTaskManager(this);
+
+    // Tooltip previews, generated in the background
+    previewCache = new PreviewCache(this);
+
+    // Widgets refresh after refreshAll through it, hidden ones only once they are shown
+    refreshScheduler = new RefreshScheduler(this);
+
+    // Keep the name index in sync, segments are rebuilt lazily on the next query
+    invalidateNameIndex(NameIndex::allKinds());
+    connect(this, &CutterCore::refreshAll, this,
+            [this]() { invalidateNameIndex(NameIndex::allKinds()); });
+    connect(this, &CutterCore::codeRebased, this,
+            [this]() { invalidateNameIndex(NameIndex::allKinds()); });
+    connect(this, &CutterCore::functionsChanged, this, [this]() {
+        invalidateNameIndex(NameIndex::Kind::Function | NameIndex::Kind::Flag);
+    });
+    connect(this, &CutterCore::flagsChanged, this,
+            [this]() { invalidateNameIndex(NameIndex::Kind::Flag); });
+    connect(this, &CutterCore::functionRenamed, this,
+            [this](const RVA offset, const QString &newName) {
+                nameIndex.renameEntry(NameIndex::Kind::Function, offset, newName);
+                // Renaming a function also renames its flag
+                invalidateNameIndex(NameIndex::Kind::Flag);
+            });
+
+    // Memory written by the user is read again instead of being served from the tracked pages.
+    // The length of an edited instruction isn't known here, so the rest of its page and the
+    // next one are read again, as an assembled instruction may cross into it.
+    connect(this, &CutterCore::instructionChanged, this, [this](RVA offset) {
+        RVA end = (offset / MemoryChangeTracker::PageSize + 2) * MemoryChangeTracker::PageSize;
+        memoryWritten(offset, end - offset);
+    });
+    connect(this, &CutterCore::refreshAll, this, [this]() {
+        memoryChanges.invalidateAll();
+        invalidateHeapChunks();
+    });
+    connect(this, &CutterCore::ioCacheChanged, this, [this]() { memoryChanges.invalidateAll(); });
+
+    // Addresses of named and module breakpoints are resolved again when the code moves
+    connect(this, &CutterCore::breakpointsChanged, this,
+            &CutterCore::invalidateBreakpointAddresses);
+    connect(this, &CutterCore::refreshAll, this, &CutterCore::invalidateBreakpointAddresses);
+    connect(this, &CutterCore::codeRebased, this, &CutterCore::invalidateBreakpointAddresses);
+    // Module breakpoints resolve once their module is loaded, which happens during a run
+    connect(this, &CutterCore::debugTaskStateChanged, this,
+            &CutterCore::resolveBreakpointAddresses);
 }
 
 CutterCore::~CutterCore()
 {
+    // The preview being generated still needs the core
+    previewCache->shutdown();
+    delete previewCache;
     delete bbHighlighter;
     rz_cons_sleep_end(coreBed);
     rz_core_task_sync_end(&core_->tasks);
@@ -419,6 +471,31 @@ bool CutterCore::isRedirectableDebugee()
     return false;
 }
 
+DebugSnapshot::Ptr CutterCore::getDebugSnapshot(DebugSnapshot::Parts parts)
+{
+    if (!currentlyDebugging) {
+        return DebugSnapshot::Ptr::create();
+    }
+    if (isDebugTaskInProgress()) {
+        // Collecting now would have to wait for the task
+        QMutexLocker locker(&publishedSnapshotMutex);
+        if (publishedSnapshot) {
+            return publishedSnapshot;
+        }
+    }
+    debugSnapshotParts |= parts;
+    if (!debugSnapshot || (debugSnapshot->parts & parts) != parts) {
+        CORE_LOCK();
+        debugSnapshot = DebugSnapshot::collect(core, parts, debugSnapshot, &memoryChanges);
+    }
+    return debugSnapshot;
+}
+
+void CutterCore::invalidateDebugSnapshot()
+{
+    debugSnapshot.clear();
+}
+
 bool CutterCore::isDebugTaskInProgress()
 {
     if (!debugTask.isNull()) {
@@ -448,6 +525,42 @@ bool CutterCore::asyncTask(std::function<void *(RzCore *)> fcn, QSharedPointer<R
     return true;
 }
 
+bool CutterCore::asyncDebugTask(std::function<void(RzCore *)> fcn,
+                                QSharedPointer<RizinTask> &task)
+{
+    auto snapshot = QSharedPointer<DebugSnapshot::Ptr>::create();
+    DebugSnapshot::Parts parts = debugSnapshotParts;
+    MemoryChangeTracker *memory = &memoryChanges;
+    // Scanned for this stop only, whoever wants the modified memory of the next one asks again
+    bool scanMemory = modifiedMemoryRequested;
+    modifiedMemoryRequested = false;
+    // Every read is a round trip to a remote debugger, read the likely ones ahead in batches
+    bool remote = currentlyRemoteDebugging;
+    if (!asyncTask(
+                [fcn, snapshot, parts, memory, scanMemory, remote](RzCore *core) {
+                    fcn(core);
+                    memory->newStop(core, scanMemory, remote);
+                    // Collect everything the debug widgets showed at the previous stop now,
+                    // instead of letting each of them query the debugger separately.
+                    *snapshot = DebugSnapshot::collect(core, parts, DebugSnapshot::Ptr(), memory);
+                    return nullptr;
+                },
+                task)) {
+        return false;
+    }
+
+    invalidateDebugSnapshot();
+    // Connected before the caller's handlers, which notify the widgets
+    connect(task.data(), &RizinTask::finished, this, [this, snapshot]() {
+        debugSnapshot = *snapshot;
+        // Only the parts requested again for this stop are collected at the next one
+        debugSnapshotParts = {};
+        // Walked again on the next request, unless the heap was not written
+        heapChunks.stale = true;
+    });
+    return true;
+}
+
 void CutterCore::functionTask(std::function<void *(RzCore *)> fcn)
 {
     auto task = std::unique_ptr<RizinTask>(new RizinFunctionTask(std::move(fcn), true));
@@ -566,6 +679,7 @@ bool CutterCore::loadFile(QString path, ut64 baddr, ut64 mapaddr, int perms, int
     }
 
     if (loadbin && va) {
+        AnalysisProfiler::Scope scope(core, tr("Load the bin info"));
         if (!rz_core_bin_load(core, path.toUtf8().constData(), baddr)) {
             eprintf("CANNOT GET RBIN INFO\n");
         }
@@ -751,7 +865,8 @@ void CutterCore::jmpReverse(RVA addr)
 void CutterCore::editBytes(RVA addr, const QString &bytes)
 {
     CORE_LOCK();
-    rz_core_write_hexpair(core, addr, bytes.toUtf8().constData());
+    int written = rz_core_write_hexpair(core, addr, bytes.toUtf8().constData());
+    memoryWritten(addr, static_cast<RVA>(qMax(written, 1)));
     emit instructionChanged(addr);
 }
 
@@ -763,6 +878,8 @@ void CutterCore::editBytesEndian(RVA addr, const QString &bytes)
         return;
     }
     rz_core_write_value_at(core, addr, value, 0);
+    invalidateDebugSnapshot();
+    memoryWritten(addr, sizeof(ut64));
     emit stackChanged();
 }
 
@@ -1459,173 +1576,36 @@ RzReg *CutterCore::getReg()
 
 QList<RegisterRef> CutterCore::getRegisterRefs(int depth)
 {
-    QList<RegisterRef> ret;
     if (!currentlyDebugging) {
-        return ret;
+        return {};
     }
-
     CORE_LOCK();
-    RzList *ritems = rz_core_reg_filter_items_sync(core, getReg(), reg_sync, nullptr);
-    if (!ritems) {
-        return ret;
-    }
-    RzListIter *it;
-    RzRegItem *ri;
-    CutterRzListForeach (ritems, it, RzRegItem, ri) {
-        RegisterRef reg;
-        reg.value = rz_reg_get_value(getReg(), ri);
-        reg.ref = getAddrRefs(reg.value, depth);
-        reg.name = ri->name;
-        ret.append(reg);
-    }
-    rz_list_free(ritems);
-    return ret;
+    return DebugSnapshot::collectRegisterRefs(core, depth);
 }
 
 QList<AddrRefs> CutterCore::getStack(int size, int depth)
 {
-    QList<AddrRefs> stack;
     if (!currentlyDebugging) {
-        return stack;
+        return {};
     }
-
     CORE_LOCK();
-    RVA addr = rz_core_reg_getv_by_role_or_name(core, "SP");
-    if (addr == RVA_INVALID) {
-        return stack;
-    }
-
-    int base = core->analysis->bits;
-    for (int i = 0; i < size; i += base / 8) {
-        if ((base == 32 && addr + i >= UT32_MAX) || (base == 16 && addr + i >= UT16_MAX)) {
-            break;
-        }
-
-        stack.append(getAddrRefs(addr + i, depth));
-    }
-
-    return stack;
+    return DebugSnapshot::collectStack(core, size, depth);
 }
 
 AddrRefs CutterCore::getAddrRefs(RVA addr, int depth)
 {
-    AddrRefs refs;
-    if (depth < 1 || addr == UT64_MAX) {
-        refs.addr = RVA_INVALID;
-        return refs;
-    }
-
     CORE_LOCK();
-    int bits = core->rasm->bits;
-    QByteArray buf = QByteArray();
-    ut64 type = rz_core_analysis_address(core, addr);
-
-    refs.addr = addr;
-
-    // Search for the section the addr is in, avoid duplication for heap/stack with type
-    if (!(type & RZ_ANALYSIS_ADDR_TYPE_HEAP || type & RZ_ANALYSIS_ADDR_TYPE_STACK)) {
-        // Attempt to find the address within a map
-        RzDebugMap *map = rz_debug_map_get(core->dbg, addr);
-        if (map && map->name && map->name[0]) {
-            refs.mapname = map->name;
-        }
-
-        RzBinSection *sect = rz_bin_get_section_at(rz_bin_cur_object(core->bin), addr, true);
-        if (sect && sect->name[0]) {
-            refs.section = sect->name;
-        }
-    }
-
-    // Check if the address points to a register
-    RzFlagItem *fi = rz_flag_get_i(core->flags, addr);
-    if (fi) {
-        RzRegItem *r = rz_reg_get(getReg(), fi->name, -1);
-        if (r) {
-            refs.reg = r->name;
-        }
-    }
-
-    // Attempt to find the address within a function
-    RzAnalysisFunction *fcn = rz_analysis_get_fcn_in(core->analysis, addr, 0);
-    if (fcn) {
-        refs.fcn = fcn->name;
-    }
-
-    // Update type and permission information
-    if (type != 0) {
-        if (type & RZ_ANALYSIS_ADDR_TYPE_HEAP) {
-            refs.type = "heap";
-        } else if (type & RZ_ANALYSIS_ADDR_TYPE_STACK) {
-            refs.type = "stack";
-        } else if (type & RZ_ANALYSIS_ADDR_TYPE_PROGRAM) {
-            refs.type = "program";
-        } else if (type & RZ_ANALYSIS_ADDR_TYPE_LIBRARY) {
-            refs.type = "library";
-        } else if (type & RZ_ANALYSIS_ADDR_TYPE_ASCII) {
-            refs.type = "ascii";
-        } else if (type & RZ_ANALYSIS_ADDR_TYPE_SEQUENCE) {
-            refs.type = "sequence";
-        }
-
-        QString perms = "";
-        if (type & RZ_ANALYSIS_ADDR_TYPE_READ) {
-            perms += "r";
-        }
-        if (type & RZ_ANALYSIS_ADDR_TYPE_WRITE) {
-            perms += "w";
-        }
-        if (type & RZ_ANALYSIS_ADDR_TYPE_EXEC) {
-            RzAsmOp op;
-            buf.resize(32);
-            perms += "x";
-            // Instruction disassembly
-            rz_io_read_at(core->io, addr, (unsigned char *)buf.data(), buf.size());
-            rz_asm_set_pc(core->rasm, addr);
-            rz_asm_disassemble(core->rasm, &op, (unsigned char *)buf.data(), buf.size());
-            refs.asm_op = rz_asm_op_get_asm(&op);
-        }
-
-        if (!perms.isEmpty()) {
-            refs.perms = perms;
-        }
-    }
-
-    // Try to telescope further if depth permits it
-    if ((type & RZ_ANALYSIS_ADDR_TYPE_READ)) {
-        buf.resize(64);
-        ut32 *n32 = (ut32 *)buf.data();
-        ut64 *n64 = (ut64 *)buf.data();
-        rz_io_read_at(core->io, addr, (unsigned char *)buf.data(), buf.size());
-        ut64 n = (bits == 64) ? *n64 : *n32;
-        // The value of the next address will serve as an indication that there's more to
-        // telescope if we have reached the depth limit
-        refs.value = n;
-        refs.has_value = true;
-        if (depth && n != addr && !(type & RZ_ANALYSIS_ADDR_TYPE_EXEC)) {
-            // Make sure we aren't telescoping the same address
-            AddrRefs ref = getAddrRefs(n, depth - 1);
-            if (!ref.type.isNull()) {
-                // If the dereference of the current pointer is an ascii character we
-                // might have a string in this address
-                if (ref.type.contains("ascii")) {
-                    buf.resize(128);
-                    rz_io_read_at(core->io, addr, (unsigned char *)buf.data(), buf.size());
-                    QString strVal = QString(buf);
-                    // Indicate that the string is longer than the printed value
-                    if (strVal.size() == buf.size()) {
-                        strVal += "...";
-                    }
-                    refs.string = strVal;
-                }
-                refs.ref = QSharedPointer<AddrRefs>::create(ref);
-            }
-        }
-    }
-    return refs;
+    return DebugSnapshot::collectAddrRefs(core, addr, depth);
 }
 
 QVector<Chunk> CutterCore::getHeapChunks(RVA arena_addr)
 {
+    if (currentlyDebugging && heapChunks.requestedArena == arena_addr
+        && (!heapChunks.stale || !isHeapModified())) {
+        heapChunks.stale = false;
+        return heapChunks.chunks;
+    }
+
     CORE_LOCK();
     QVector<Chunk> chunks_vector;
     ut64 m_arena;
@@ -1645,20 +1625,61 @@ QVector<Chunk> CutterCore::getHeapChunks(RVA arena_addr)
 
     // Get chunks using api and store them in a chunks_vector
     RzList *chunks = rz_heap_chunks_list(core, m_arena);
+    chunks_vector.reserve(rz_list_length(chunks));
+    // There are only a few different states, share their strings between the chunks
+    QList<QString> statuses;
     RzListIter *iter;
     RzHeapChunkListItem *data;
     CutterRzListForeach (chunks, iter, RzHeapChunkListItem, data) {
         Chunk chunk;
         chunk.offset = data->addr;
         chunk.size = (int)data->size;
-        chunk.status = QString(data->status);
+        auto status = std::find(statuses.begin(), statuses.end(), QLatin1String(data->status));
+        if (status == statuses.end()) {
+            statuses.append(QString(data->status));
+            status = statuses.end() - 1;
+        }
+        chunk.status = *status;
         chunks_vector.append(chunk);
     }
-
     rz_list_free(chunks);
+
+    if (currentlyDebugging) {
+        heapChunks.requestedArena = arena_addr;
+        heapChunks.arena = m_arena;
+        heapChunks.chunks = chunks_vector;
+        heapChunks.stale = false;
+    }
     return chunks_vector;
 }
 
+bool CutterCore::isHeapModified()
+{
+    bool complete;
+    const QList<QPair<RVA, RVA>> modified = getModifiedMemory(&complete);
+    if (!complete) {
+        return true;
+    }
+    RVA heapBegin = heapChunks.chunks.isEmpty() ? 0 : heapChunks.chunks.first().offset;
+    RVA heapEnd = heapChunks.chunks.isEmpty()
+            ? 0
+            : heapChunks.chunks.last().offset + heapChunks.chunks.last().size;
+    // The arena state is smaller than two pages
+    RVA arenaEnd = heapChunks.arena + 2 * MemoryChangeTracker::PageSize;
+    for (const auto &range : modified) {
+        if ((range.first < heapEnd && range.second > heapBegin)
+            || (range.first < arenaEnd && range.second > heapChunks.arena)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CutterCore::invalidateHeapChunks()
+{
+    heapChunks = HeapChunksCache();
+}
+
 int CutterCore::getArchBits()
 {
     CORE_LOCK();
@@ -1814,24 +1835,8 @@ QList<GlobalDescription> CutterCore::getAllGlobals()
 
 QVector<RegisterRefValueDescription> CutterCore::getRegisterRefValues()
 {
-    QVector<RegisterRefValueDescription> result;
     CORE_LOCK();
-    RzList *ritems = rz_core_reg_filter_items_sync(core, getReg(), reg_sync, nullptr);
-    if (!ritems) {
-        return result;
-    }
-    RzListIter *it;
-    RzRegItem *ri;
-    CutterRzListForeach (ritems, it, RzRegItem, ri) {
-        RegisterRefValueDescription desc;
-        desc.name = ri->name;
-        ut64 value = rz_reg_get_value(getReg(), ri);
-        desc.value = "0x" + QString::number(value, 16);
-        desc.ref = rz_core_analysis_hasrefs(core, value, true);
-        result.push_back(desc);
-    }
-    rz_list_free(ritems);
-    return result;
+    return DebugSnapshot::collectRegisterValues(core);
 }
 
 QString CutterCore::getRegisterName(QString registerRole)
@@ -1859,14 +1864,16 @@ void CutterCore::setRegister(QString regName, QString regValue)
     }
     CORE_LOCK();
     ut64 val = rz_num_math(core->num, regValue.toUtf8().constData());
-    rz_core_reg_assign_sync(core, getReg(), reg_sync, regName.toUtf8().constData(), val);
+    rz_core_reg_assign_sync(core, getReg(), DebugSnapshot::syncRegisters,
+                            regName.toUtf8().constData(), val);
+    invalidateDebugSnapshot();
     emit registersChanged();
     emit refreshCodeViews();
 }
 
 void CutterCore::setCurrentDebugThread(int tid)
 {
-    if (!asyncTask(
+    if (!asyncDebugTask(
                 [=](RzCore *core) {
                     rz_debug_select(core->dbg, core->dbg->pid, tid);
                     return (void *)NULL;
@@ -1892,7 +1899,7 @@ void CutterCore::setCurrentDebugThread(int tid)
 void CutterCore::setCurrentDebugProcess(int pid)
 {
     if (!currentlyDebugging
-        || !asyncTask(
+        || !asyncDebugTask(
                 [=](RzCore *core) {
                     rz_debug_select(core->dbg, pid, core->dbg->tid);
                     core->dbg->main_pid = pid;
@@ -1924,7 +1931,7 @@ void CutterCore::startDebug()
     }
     currentlyOpenFile = getConfig("file.path");
 
-    if (!asyncTask(
+    if (!asyncDebugTask(
                 [](RzCore *core) {
                     rz_core_file_reopen_debug(core, "");
                     return nullptr;
@@ -1968,7 +1975,7 @@ void CutterCore::startEmulation()
     }
 
     // clear registers, init esil state, stack, progcounter at current seek
-    asyncTask(
+    asyncDebugTask(
             [&](RzCore *core) {
                 rz_core_analysis_esil_reinit(core);
                 rz_core_analysis_esil_init_mem(core, NULL, UT64_MAX, UT32_MAX);
@@ -2016,7 +2023,7 @@ void CutterCore::attachRemote(const QString &uri)
     }
 
     // connect to a debugger with the given plugin
-    if (!asyncTask(
+    if (!asyncDebugTask(
                 [&](RzCore *core) {
                     setConfig("cfg.debug", true);
                     rz_core_file_reopen_remote_debug(core, uri.toStdString().c_str(), 0);
@@ -2078,7 +2085,7 @@ void CutterCore::attachDebug(int pid)
         offsetPriorDebugging = getOffset();
     }
 
-    if (!asyncTask(
+    if (!asyncDebugTask(
                 [&](RzCore *core) {
                     // cannot use setConfig because core is
                     // already locked, which causes a deadlock
@@ -2143,6 +2150,14 @@ void CutterCore::stopDebug()
     currentlyDebugging = false;
     currentlyTracing = false;
     currentlyRemoteDebugging = false;
+    invalidateDebugSnapshot();
+    memoryChanges.clear();
+    for (BreakpointState &state : breakpointStates) {
+        state.hits = 0;
+    }
+    breakpointsGeneration++;
+    modifiedMemoryRequested = false;
+    invalidateHeapChunks();
     emit debugTaskStateChanged();
 
     CORE_LOCK();
@@ -2176,6 +2191,41 @@ void CutterCore::syncAndSeekProgramCounter()
     emit registersChanged();
 }
 
+/**
+ * @brief Continue until a breakpoint without condition is hit, or one whose condition matches
+ *
+ * The conditions of \p expressions are compiled once and evaluated right here in the debug task,
+ * so hits which don't match never reach the UI.
+ * @param hits hit counts by breakpoint address, incremented for each hit
+ */
+static void continueUntilCondition(RzCore *core, const QHash<RVA, QString> &expressions,
+                                   QHash<RVA, quint64> *hits)
+{
+    QHash<RVA, BreakpointCondition> conditions;
+    for (auto it = expressions.constBegin(); it != expressions.constEnd(); ++it) {
+        conditions.insert(it.key(), BreakpointCondition::compile(it.value(), core));
+    }
+    while (true) {
+        rz_debug_continue(core->dbg);
+        if (rz_cons_is_breaked() || rz_debug_is_dead(core->dbg)
+            || core->dbg->reason.type != RZ_DEBUG_REASON_BREAKPOINT) {
+            return;
+        }
+        RVA addr = core->dbg->reason.bp_addr;
+        if (!addr) {
+            addr = rz_debug_reg_get(core->dbg, "PC");
+        }
+        quint64 &count = (*hits)[addr];
+        count++;
+        auto it = conditions.constFind(addr);
+        if (it == conditions.constEnd()
+            || !DebugSnapshot::syncRegisters(core, RZ_REG_TYPE_GPR, false)
+            || it->evaluate(core, count)) {
+            return;
+        }
+    }
+}
+
 void CutterCore::continueDebug()
 {
     if (!currentlyDebugging) {
@@ -2183,7 +2233,7 @@ void CutterCore::continueDebug()
     }
 
     if (currentlyEmulating) {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_core_esil_step(core, UT64_MAX, "0", NULL, false);
                         rz_core_reg_update_flags(core);
@@ -2193,14 +2243,32 @@ void CutterCore::continueDebug()
             return;
         }
     } else {
-        if (!asyncTask(
-                    [](RzCore *core) {
-                        rz_debug_continue(core->dbg);
+        QHash<RVA, QString> expressions;
+        for (auto it = breakpointStates.constBegin(); it != breakpointStates.constEnd(); ++it) {
+            if (!it->breakIf.isEmpty()) {
+                expressions.insert(it.key(), it->breakIf);
+            }
+        }
+        auto hits = QSharedPointer<QHash<RVA, quint64>>::create();
+        if (!asyncDebugTask(
+                    [expressions, hits](RzCore *core) {
+                        continueUntilCondition(core, expressions, hits.data());
                         return nullptr;
                     },
                     debugTask)) {
             return;
         }
+        connect(debugTask.data(), &RizinTask::finished, this, [this, hits]() {
+            CORE_LOCK();
+            for (auto it = hits->constBegin(); it != hits->constEnd(); ++it) {
+                if (rz_bp_get_at(core->dbg->bp, it.key())) {
+                    breakpointStates[it.key()].hits += it.value();
+                }
+            }
+            if (!hits->isEmpty()) {
+                breakpointsGeneration++;
+            }
+        });
     }
 
     emit debugTaskStateChanged();
@@ -2221,7 +2289,7 @@ void CutterCore::continueBackDebug()
     }
 
     if (currentlyEmulating) {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_core_esil_continue_back(core);
                         rz_core_reg_update_flags(core);
@@ -2231,7 +2299,7 @@ void CutterCore::continueBackDebug()
             return;
         }
     } else {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_debug_continue_back(core->dbg);
                         return nullptr;
@@ -2259,7 +2327,7 @@ void CutterCore::continueUntilDebug(ut64 offset)
     }
 
     if (currentlyEmulating) {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [=](RzCore *core) {
                         rz_core_esil_step(core, offset, NULL, NULL, false);
                         rz_core_reg_update_flags(core);
@@ -2269,7 +2337,7 @@ void CutterCore::continueUntilDebug(ut64 offset)
             return;
         }
     } else {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [=](RzCore *core) {
                         rz_core_debug_continue_until(core, offset, offset);
                         return nullptr;
@@ -2295,7 +2363,7 @@ void CutterCore::continueUntilCall()
     }
 
     if (currentlyEmulating) {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_core_analysis_continue_until_call(core);
                         return nullptr;
@@ -2304,7 +2372,7 @@ void CutterCore::continueUntilCall()
             return;
         }
     } else {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_core_debug_step_one(core, 0);
                         return nullptr;
@@ -2332,7 +2400,7 @@ void CutterCore::continueUntilSyscall()
     }
 
     if (currentlyEmulating) {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_core_analysis_continue_until_syscall(core);
                         return nullptr;
@@ -2341,7 +2409,7 @@ void CutterCore::continueUntilSyscall()
             return;
         }
     } else {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_cons_break_push(
                                 [](void *x) { rz_debug_stop(reinterpret_cast<RzDebug *>(x)); },
@@ -2375,7 +2443,7 @@ void CutterCore::stepDebug()
     }
 
     if (currentlyEmulating) {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_core_esil_step(core, UT64_MAX, NULL, NULL, false);
                         rz_core_reg_update_flags(core);
@@ -2385,7 +2453,7 @@ void CutterCore::stepDebug()
             return;
         }
     } else {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_core_debug_step_one(core, 1);
                         return nullptr;
@@ -2413,7 +2481,7 @@ void CutterCore::stepOverDebug()
     }
 
     if (currentlyEmulating) {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [&](RzCore *core) {
                         rz_core_analysis_esil_step_over(core);
                         return nullptr;
@@ -2423,7 +2491,7 @@ void CutterCore::stepOverDebug()
         }
     } else {
         bool ret;
-        asyncTask(
+        asyncDebugTask(
                 [&](RzCore *core) {
                     ret = rz_core_debug_step_over(core, 1);
                     rz_core_dbg_follow_seek_register(core);
@@ -2454,7 +2522,7 @@ void CutterCore::stepOutDebug()
 
     emit debugTaskStateChanged();
     bool ret;
-    asyncTask(
+    asyncDebugTask(
             [&](RzCore *core) {
                 ret = rz_core_debug_step_until_frame(core);
                 rz_core_dbg_follow_seek_register(core);
@@ -2482,7 +2550,7 @@ void CutterCore::stepBackDebug()
     }
 
     if (currentlyEmulating) {
-        if (!asyncTask(
+        if (!asyncDebugTask(
                     [](RzCore *core) {
                         rz_core_esil_step_back(core);
                         rz_core_reg_update_flags(core);
@@ -2493,7 +2561,7 @@ void CutterCore::stepBackDebug()
         }
     } else {
         bool ret;
-        asyncTask(
+        asyncDebugTask(
                 [&](RzCore *core) {
                     ret = rz_core_debug_step_back(core, 1);
                     rz_core_dbg_follow_seek_register(core);
@@ -2538,6 +2606,57 @@ void CutterCore::setDebugPlugin(QString plugin)
     setConfig("dbg.backend", plugin);
 }
 
+void CutterCore::continueEmulation(const TraceOptions &options)
+{
+    if (!currentlyDebugging || !currentlyEmulating) {
+        return;
+    }
+
+    // Only the registers are worth collecting repeatedly while running
+    DebugSnapshot::Parts parts = debugSnapshotParts & DebugSnapshot::Part::RegisterValues;
+    auto result = QSharedPointer<TraceRecorder::Result>::create();
+    auto stepsPerSecond = QSharedPointer<quint64>::create(0);
+    if (!asyncDebugTask(
+                [this, options, parts, result, stepsPerSecond](RzCore *core) {
+                    QElapsedTimer timer;
+                    timer.start();
+                    auto progress = [this, core, parts, &timer, stepsPerSecond](quint64 steps,
+                                                                                RVA pc) {
+                        qint64 elapsed = timer.elapsed();
+                        *stepsPerSecond = elapsed > 0 ? steps * 1000 / elapsed : 0;
+                        if (parts) {
+                            auto snapshot = DebugSnapshot::collect(core, parts);
+                            QMutexLocker locker(&publishedSnapshotMutex);
+                            publishedSnapshot = snapshot;
+                        }
+                        emit emulationProgress(steps, pc, *stepsPerSecond);
+                        if (parts) {
+                            emit debugSnapshotPublished();
+                        }
+                    };
+                    *result = TraceRecorder::record(core, options, nullptr, progress);
+                },
+                debugTask)) {
+        return;
+    }
+    emit debugTaskStateChanged();
+
+    connect(debugTask.data(), &RizinTask::finished, this, [this, result, stepsPerSecond]() {
+        debugTask.clear();
+        {
+            QMutexLocker locker(&publishedSnapshotMutex);
+            publishedSnapshot.clear();
+        }
+        syncAndSeekProgramCounter();
+        emit refreshCodeViews();
+        emit debugTaskStateChanged();
+        emit emulationFinished(result->steps, *stepsPerSecond,
+                               TraceRecorder::stopReasonDescription(result->reason));
+    });
+
+    debugTask->startTask();
+}
+
 void CutterCore::startTraceSession()
 {
     if (!currentlyDebugging || currentlyTracing) {
@@ -2628,10 +2747,50 @@ void CutterCore::stopTraceSession()
     debugTask->startTask();
 }
 
+void CutterCore::recordTrace(const TraceOptions &options)
+{
+    if (!currentlyDebugging || !debugTask.isNull()) {
+        return;
+    }
+
+    QSharedPointer<TraceBuffer> buffer;
+    {
+        CORE_LOCK();
+        buffer.reset(TraceRecorder::createBuffer(core, options.capacity));
+    }
+    if (!asyncDebugTask(
+                [this, options, buffer](RzCore *core) {
+                    TraceRecorder::record(core, options, buffer.data(),
+                                          [this](quint64 steps, RVA pc) {
+                                              emit traceRecordingProgress(steps, pc);
+                                          });
+                },
+                debugTask)) {
+        return;
+    }
+    recordedTrace.clear();
+    emit traceRecordingStarted();
+    emit debugTaskStateChanged();
+
+    connect(debugTask.data(), &RizinTask::finished, this, [this, buffer]() {
+        debugTask.clear();
+        recordedTrace = buffer;
+        syncAndSeekProgramCounter();
+        emit refreshCodeViews();
+        emit debugTaskStateChanged();
+        emit traceRecorded();
+    });
+
+    debugTask->startTask();
+}
+
 void CutterCore::toggleBreakpoint(RVA addr)
 {
     CORE_LOCK();
     rz_core_debug_breakpoint_toggle(core, addr);
+    if (!rz_bp_get_at(core->dbg->bp, addr)) {
+        breakpointStates.remove(addr);
+    }
     emit breakpointsChanged(addr);
 }
 
@@ -2685,6 +2844,11 @@ void CutterCore::addBreakpoint(const BreakpointDescription &config)
     if (!config.command.isEmpty()) {
         updateOwnedCharPtr(breakpoint->data, config.command);
     }
+    if (config.breakIf.isEmpty()) {
+        breakpointStates.remove(breakpoint->addr);
+    } else {
+        breakpointStates[breakpoint->addr].breakIf = config.breakIf;
+    }
     emit breakpointsChanged(breakpoint->addr);
 }
 
@@ -2692,6 +2856,7 @@ void CutterCore::updateBreakpoint(int index, const BreakpointDescription &config
 {
     CORE_LOCK();
     if (auto bp = rz_bp_get_index(core->dbg->bp, index)) {
+        breakpointStates.remove(bp->addr);
         rz_bp_del(core->dbg->bp, bp->addr);
     }
     // Delete by index currently buggy,
@@ -2704,6 +2869,7 @@ void CutterCore::delBreakpoint(RVA addr)
 {
     CORE_LOCK();
     rz_bp_del(core->dbg->bp, addr);
+    breakpointStates.remove(addr);
     emit breakpointsChanged(addr);
 }
 
@@ -2711,6 +2877,8 @@ void CutterCore::delAllBreakpoints()
 {
     CORE_LOCK();
     rz_bp_del_all(core->dbg->bp);
+    breakpointStates.clear();
+    invalidateBreakpointAddresses();
     emit refreshCodeViews();
 }
 
@@ -2755,6 +2923,21 @@ static BreakpointDescription breakpointDescriptionFromRizin(int index, rz_bp_ite
     return bp;
 }
 
+void CutterCore::fillBreakpointState(BreakpointDescription *bp) const
+{
+    auto it = breakpointStates.constFind(bp->addr);
+    if (it != breakpointStates.constEnd()) {
+        bp->breakIf = it->breakIf;
+        bp->hits = it->hits;
+    }
+}
+
+QHash<QString, int> CutterCore::getBreakpointConditionRegisters()
+{
+    CORE_LOCK();
+    return BreakpointCondition::registerSizes(core);
+}
+
 int CutterCore::breakpointIndexAt(RVA addr)
 {
     CORE_LOCK();
@@ -2767,7 +2950,9 @@ BreakpointDescription CutterCore::getBreakpointAt(RVA addr)
     int index = rz_bp_get_index_at(core->dbg->bp, addr);
     auto bp = rz_bp_get_index(core->dbg->bp, index);
     if (bp) {
-        return breakpointDescriptionFromRizin(index, bp);
+        BreakpointDescription description = breakpointDescriptionFromRizin(index, bp);
+        fillBreakpointState(&description);
+        return description;
     }
     return BreakpointDescription();
 }
@@ -2780,35 +2965,100 @@ QList<BreakpointDescription> CutterCore::getBreakpoints()
     for (int i = 0; i < core->dbg->bp->bps_idx_count; i++) {
         if (auto bpi = core->dbg->bp->bps_idx[i]) {
             ret.push_back(breakpointDescriptionFromRizin(i, bpi));
+            fillBreakpointState(&ret.last());
         }
     }
 
     return ret;
 }
 
-QList<RVA> CutterCore::getBreakpointsAddresses()
+const CutterCore::BreakpointAddressCache &CutterCore::getBreakpointAddressCache()
+{
+    if (!breakpointAddresses.valid) {
+        CORE_LOCK();
+        BreakpointAddressCache cache;
+        RzListIter *it;
+        RzBreakpointItem *bpi;
+        CutterRzListForeach (core->dbg->bp->bps, it, RzBreakpointItem, bpi) {
+            cache.sorted.append(bpi->addr);
+        }
+        std::sort(cache.sorted.begin(), cache.sorted.end());
+        cache.set.reserve(cache.sorted.size());
+        for (RVA addr : cache.sorted) {
+            cache.set.insert(addr);
+        }
+        cache.valid = true;
+        breakpointAddresses = cache;
+    }
+    return breakpointAddresses;
+}
+
+void CutterCore::invalidateBreakpointAddresses()
+{
+    breakpointAddresses.valid = false;
+    breakpointsGeneration++;
+}
+
+void CutterCore::resolveBreakpointAddresses()
 {
-    QList<RVA> bpAddresses;
-    for (const BreakpointDescription &bp : getBreakpoints()) {
-        bpAddresses << bp.addr;
+    if (isDebugTaskInProgress()) {
+        // The debug task has the core, this is called again when it finishes
+        return;
+    }
+    // Only a change of the addresses counts as a new generation, not every debug step
+    QList<RVA> previous = breakpointAddresses.sorted;
+    breakpointAddresses.valid = false;
+    if (getBreakpointAddressCache().sorted != previous) {
+        breakpointsGeneration++;
     }
+}
+
+QList<RVA> CutterCore::getBreakpointsAddresses()
+{
+    return getBreakpointAddressCache().sorted;
+}
 
-    return bpAddresses;
+QSet<RVA> CutterCore::getBreakpointAddressSet()
+{
+    return getBreakpointAddressCache().set;
+}
+
+QList<RVA> CutterCore::getBreakpointsInRange(RVA begin, RVA end)
+{
+    const QList<RVA> &sorted = getBreakpointAddressCache().sorted;
+    QList<RVA> result;
+    for (auto it = std::lower_bound(sorted.begin(), sorted.end(), begin);
+         it != sorted.end() && *it < end; ++it) {
+        result.append(*it);
+    }
+    return result;
 }
 
 QList<RVA> CutterCore::getBreakpointsInFunction(RVA funcAddr)
 {
-    QList<RVA> allBreakpoints = getBreakpointsAddresses();
     QList<RVA> functionBreakpoints;
+    RVA begin;
+    RVA end;
+    {
+        CORE_LOCK();
+        RzAnalysisFunction *fcn = rz_analysis_get_function_at(core->analysis, funcAddr);
+        if (!fcn) {
+            return functionBreakpoints;
+        }
+        begin = rz_analysis_function_min_addr(fcn);
+        end = rz_analysis_function_max_addr(fcn);
+    }
 
-    // Use std manipulations to take only the breakpoints that belong to this function
-    std::copy_if(allBreakpoints.begin(), allBreakpoints.end(),
-                 std::back_inserter(functionBreakpoints),
-                 [this, funcAddr](RVA BPadd) { return getFunctionStart(BPadd) == funcAddr; });
+    // Only the breakpoints within the function's bounds can belong to it
+    for (RVA addr : getBreakpointsInRange(begin, end)) {
+        if (getFunctionStart(addr) == funcAddr) {
+            functionBreakpoints.append(addr);
+        }
+    }
     return functionBreakpoints;
 }
 
-bool CutterCore::isBreakpoint(const QList<RVA> &breakpoints, RVA addr)
+bool CutterCore::isBreakpoint(const QSet<RVA> &breakpoints, RVA addr)
 {
     return breakpoints.contains(addr);
 }
@@ -2816,25 +3066,7 @@ bool CutterCore::isBreakpoint(const QList<RVA> &breakpoints, RVA addr)
 QList<ProcessDescription> CutterCore::getProcessThreads(int pid = -1)
 {
     CORE_LOCK();
-    RzList *list = rz_debug_pids(core->dbg, pid != -1 ? pid : core->dbg->pid);
-    RzListIter *iter;
-    RzDebugPid *p;
-    QList<ProcessDescription> ret;
-
-    CutterRzListForeach (list, iter, RzDebugPid, p) {
-        ProcessDescription proc;
-
-        proc.current = core->dbg->pid == p->pid;
-        proc.ppid = p->ppid;
-        proc.pid = p->pid;
-        proc.uid = p->uid;
-        proc.status = static_cast<RzDebugPidState>(p->status);
-        proc.path = p->path;
-
-        ret << proc;
-    }
-    rz_list_free(list);
-    return ret;
+    return DebugSnapshot::collectThreads(core, pid);
 }
 
 QList<ProcessDescription> CutterCore::getAllProcesses()
@@ -2845,26 +3077,7 @@ QList<ProcessDescription> CutterCore::getAllProcesses()
 QList<MemoryMapDescription> CutterCore::getMemoryMap()
 {
     CORE_LOCK();
-    RzList *list0 = rz_debug_map_list(core->dbg, false);
-    RzList *list1 = rz_debug_map_list(core->dbg, true);
-    rz_list_join(list0, list1);
-    QList<MemoryMapDescription> ret;
-    RzListIter *it;
-    RzDebugMap *map;
-    CutterRzListForeach (list0, it, RzDebugMap, map) {
-        MemoryMapDescription memMap;
-
-        memMap.name = map->name;
-        memMap.fileName = map->file;
-        memMap.addrStart = map->addr;
-        memMap.addrEnd = map->addr_end;
-        memMap.type = map->user ? "u" : "s";
-        memMap.permission = rz_str_rwx_i(map->perm);
-
-        ret << memMap;
-    }
-
-    return ret;
+    return DebugSnapshot::collectMemoryMaps(core);
 }
 
 void CutterCore::setGraphEmpty(bool empty)
@@ -3894,18 +4107,10 @@ bool CutterCore::isAddressMapped(RVA addr)
     return rz_io_map_get(core->io, addr);
 }
 
-QList<SearchDescription> CutterCore::getAllSearch(QString searchFor, QString space, QString in)
+static QList<SearchDescription> searchDescriptionsFromJson(const QString &space,
+                                                          CutterJson searchArray)
 {
-    CORE_LOCK();
     QList<SearchDescription> searchRef;
-
-    CutterJson searchArray;
-    {
-        TempConfig cfg;
-        cfg.set("search.in", in);
-        searchArray = cmdj(QString("%1 %2").arg(space, searchFor));
-    }
-
     if (space == "/Rj") {
         for (CutterJson searchObject : searchArray) {
             SearchDescription exp;
@@ -3935,6 +4140,72 @@ QList<SearchDescription> CutterCore::getAllSearch(QString searchFor, QString spa
     return searchRef;
 }
 
+QList<SearchDescription> CutterCore::getAllSearch(QString searchFor, QString space, QString in)
+{
+    CORE_LOCK();
+    CutterJson searchArray;
+    {
+        TempConfig cfg;
+        cfg.set("search.in", in);
+        searchArray = cmdj(QString("%1 %2").arg(space, searchFor));
+    }
+    return searchDescriptionsFromJson(space, searchArray);
+}
+
+QList<SearchDescription> CutterCore::getAllSearchInRange(QString searchFor, QString space,
+                                                         RVA from, RVA to)
+{
+    CORE_LOCK();
+    CutterJson searchArray;
+    {
+        TempConfig cfg;
+        cfg.set("search.in", "range")
+                .set("search.from", RzAddressString(from))
+                .set("search.to", RzAddressString(to));
+        searchArray = cmdj(QString("%1 %2").arg(space, searchFor));
+    }
+    return searchDescriptionsFromJson(space, searchArray);
+}
+
+QList<AddressRangeDescription> CutterCore::getSearchBoundaries(const QString &in)
+{
+    CORE_LOCK();
+    QList<AddressRangeDescription> ranges;
+    auto list = fromOwned(
+            rz_core_get_boundaries_prot(core, -1, in.toUtf8().constData(), "search"));
+    if (!list) {
+        return ranges;
+    }
+    RzListIter *iter;
+    RzIOMap *map;
+    CutterRzListForeach (list.get(), iter, RzIOMap, map) {
+        ranges.append({ rz_itv_begin(map->itv), rz_itv_end(map->itv) });
+    }
+    return ranges;
+}
+
+QList<SearchDescription> CutterCore::searchBytePatterns(const QString &patterns,
+                                                       const QString &in, int maxResults,
+                                                       QString *error)
+{
+    QVector<BytePattern> parsed;
+    if (!BytePattern::parseList(patterns, &parsed, error)) {
+        return {};
+    }
+    QList<SearchDescription> results;
+    BytePatternSearch search(parsed);
+    search.run(getSearchBoundaries(in), maxResults,
+               [&results](const QList<SearchDescription> &found) {
+                   results.append(found);
+                   return true;
+               });
+    std::sort(results.begin(), results.end(),
+              [](const SearchDescription &a, const SearchDescription &b) {
+                  return a.offset < b.offset;
+              });
+    return results;
+}
+
 QList<XrefDescription> CutterCore::getXRefsForVariable(QString variableName, bool findWrites,
                                                        RVA offset)
 {
@@ -4184,6 +4455,146 @@ void CutterCore::triggerFlagsChanged()
     emit flagsChanged();
 }
 
+void CutterCore::invalidateNameIndex(NameIndex::Kinds kinds)
+{
+    nameIndexDirtyKinds.fetchAndOrOrdered(int(kinds));
+    nameIndexGeneration.ref();
+}
+
+int CutterCore::staleNameIndexKinds() const
+{
+    return nameIndexDirtyKinds.loadAcquire() | nameIndexBuildingKinds.loadAcquire();
+}
+
+void CutterCore::updateNameIndex(NameIndex::Kinds kinds)
+{
+    if (!(staleNameIndexKinds() & int(kinds))) {
+        return;
+    }
+    // Rebuilds are serialized by the core lock, which is held until the new segments are
+    // published. A caller finding its kinds being rebuilt waits here for that rebuild.
+    CORE_LOCK();
+    // Marked as being rebuilt before the dirty bits are cleared, so that the kinds never look
+    // up to date to other threads before the rebuild is published. The dirty bits are cleared
+    // before fetching, so that changes happening meanwhile are not lost.
+    nameIndexBuildingKinds.fetchAndOrOrdered(int(kinds));
+    int dirty = nameIndexDirtyKinds.fetchAndAndOrdered(~int(kinds)) & int(kinds);
+    rebuildNameIndex(dirty);
+    nameIndexBuildingKinds.fetchAndAndOrdered(~int(kinds));
+}
+
+void CutterCore::rebuildNameIndex(int dirty)
+{
+    if (dirty & int(NameIndex::Kind::Function)) {
+        CORE_LOCK();
+        QVector<NameIndex::Entry> entries;
+        entries.reserve(rz_list_length(core->analysis->fcns));
+        RzListIter *iter;
+        RzAnalysisFunction *fcn;
+        CutterRzListForeach (core->analysis->fcns, iter, RzAnalysisFunction, fcn) {
+            entries.append({ fcn->addr, QString::fromUtf8(fcn->name),
+                             NameIndex::Kind::Function });
+        }
+        nameIndex.setEntries(NameIndex::Kind::Function, entries);
+    }
+    if (dirty & int(NameIndex::Kind::Flag)) {
+        CORE_LOCK();
+        QVector<NameIndex::Entry> entries;
+        rz_flag_foreach_space(
+                core->flags, nullptr,
+                [](RzFlagItem *item, void *user) {
+                    reinterpret_cast<QVector<NameIndex::Entry> *>(user)->append(
+                            { item->offset, QString::fromUtf8(item->name),
+                              NameIndex::Kind::Flag });
+                    return true;
+                },
+                &entries);
+        nameIndex.setEntries(NameIndex::Kind::Flag, entries);
+    }
+    if (dirty & int(NameIndex::Kind::Symbol)) {
+        QVector<NameIndex::Entry> entries;
+        for (const SymbolDescription &symbol : getAllSymbols()) {
+            entries.append({ symbol.vaddr, symbol.name, NameIndex::Kind::Symbol });
+        }
+        nameIndex.setEntries(NameIndex::Kind::Symbol, entries);
+    }
+    if (dirty & int(NameIndex::Kind::String)) {
+        // Use the same escaped representation as the strings widget
+        QVector<NameIndex::Entry> entries;
+        for (const StringDescription &string : getAllStrings()) {
+            entries.append({ string.vaddr, string.string, NameIndex::Kind::String });
+        }
+        nameIndex.setEntries(NameIndex::Kind::String, entries);
+    }
+    if (dirty & int(NameIndex::Kind::Import)) {
+        QVector<NameIndex::Entry> entries;
+        for (const ImportDescription &import : getAllImports()) {
+            entries.append({ import.plt, import.name, NameIndex::Kind::Import });
+        }
+        nameIndex.setEntries(NameIndex::Kind::Import, entries);
+    }
+    if (dirty & int(NameIndex::Kind::Section)) {
+        QVector<NameIndex::Entry> entries;
+        for (const SectionDescription &section : getAllSections()) {
+            entries.append({ section.vaddr, section.name, NameIndex::Kind::Section });
+        }
+        nameIndex.setEntries(NameIndex::Kind::Section, entries);
+    }
+}
+
+bool CutterCore::requestNameIndex(NameIndex::Kinds kinds)
+{
+    // Kinds rebuilt by another thread aren't ready either, findNames() would wait for them
+    bool dirty = staleNameIndexKinds() & int(kinds);
+    if (nameIndexTask) {
+        // Its segments are only replaced once it finishes
+        if (nameIndexTask->getKinds() & kinds) {
+            nameIndexPendingKinds |= kinds;
+            return false;
+        }
+        if (dirty) {
+            nameIndexPendingKinds |= kinds;
+        }
+        return !dirty;
+    }
+    if (dirty) {
+        startNameIndexTask(kinds);
+    }
+    return !dirty;
+}
+
+void CutterCore::startNameIndexTask(NameIndex::Kinds kinds)
+{
+    nameIndexTask = QSharedPointer<NameIndexTask>::create(kinds);
+    connect(nameIndexTask.data(), &AsyncTask::finished, this, [this]() {
+        nameIndexTask.clear();
+        NameIndex::Kinds pending = nameIndexPendingKinds;
+        nameIndexPendingKinds = {};
+        // Invalidated again while the task ran
+        if (staleNameIndexKinds() & int(pending)) {
+            startNameIndexTask(pending);
+        }
+        emit nameIndexUpdated();
+    });
+    asyncTaskManager->start(nameIndexTask);
+}
+
+QList<NameIndex::Entry> CutterCore::findNames(const QString &substring, NameIndex::Kinds kinds,
+                                              int limit)
+{
+    updateNameIndex(kinds);
+    return nameIndex.find(substring, kinds, limit);
+}
+
+QSet<RVA> CutterCore::findNameAddresses(const QString &substring, NameIndex::Kinds kinds)
+{
+    QSet<RVA> r;
+    for (const NameIndex::Entry &entry : findNames(substring, kinds)) {
+        r.insert(entry.offset);
+    }
+    return r;
+}
+
 void CutterCore::triggerVarsChanged()
 {
     emit varsChanged();
@@ -4595,6 +5006,44 @@ QByteArray CutterCore::ioRead(RVA addr, int len)
     return array;
 }
 
+QByteArray CutterCore::ioReadTracked(RVA addr, int len)
+{
+    if (!currentlyDebugging || isDebugTaskInProgress()) {
+        return ioRead(addr, len);
+    }
+    CORE_LOCK();
+    return memoryChanges.read(core, addr, len);
+}
+
+bool CutterCore::isMemoryModified(RVA addr, RVA size) const
+{
+    return currentlyDebugging && memoryChanges.isModified(addr, size);
+}
+
+void CutterCore::memoryWritten(RVA addr, RVA size)
+{
+    memoryChanges.invalidate(addr, size);
+    invalidateHeapChunks();
+}
+
+QList<QPair<RVA, RVA>> CutterCore::getModifiedMemory(bool *complete)
+{
+    if (complete) {
+        *complete = currentlyDebugging && memoryChanges.isProcessScanned();
+    }
+    if (!currentlyDebugging) {
+        return {};
+    }
+    // The whole process is only scanned at the next stop if someone looks at it at this one
+    modifiedMemoryRequested = true;
+    return memoryChanges.getModifiedRanges();
+}
+
+MemoryChangeTracker::Statistics CutterCore::getMemoryStatistics() const
+{
+    return memoryChanges.getStatistics();
+}
+
 QStringList CutterCore::getConfigVariableSpaces(const QString &key)
 {
     CORE_LOCK();
@@ -5,9 +5,17 @@
 #include "core/CutterDescriptions.h"
 #include "core/CutterJson.h"
 #include "core/Basefind.h"
+#include "core/DebugSnapshot.h"
+#include "core/TraceRecorder.h"
+#include "core/MemoryChangeTracker.h"
+#include "core/CoreLockProfiler.h"
 #include "common/BasicInstructionHighlighter.h"
+#include "common/NameIndex.h"
+#include "common/RefreshScheduler.h"
 
+#include <QHash>
 #include <QMap>
+#include <QSet>
 #include <QMenu>
 #include <QDebug>
 #include <QObject>
@@ -21,6 +29,7 @@
 #include <memory>
 
 class AsyncTaskManager;
+class PreviewCache;
 class BasicInstructionHighlighter;
 class CutterCore;
 class Decompiler;
@@ -28,6 +37,7 @@ class RizinTask;
 class RizinCmdTask;
 class RizinFunctionTask;
 class RizinTaskDialog;
+class NameIndexTask;
 
 #include "common/BasicBlockHighlighter.h"
 #include "common/Helpers.h"
@@ -39,29 +49,6 @@ class RizinTaskDialog;
 
 class RzCoreLocked;
 
-struct CUTTER_EXPORT AddrRefs
-{
-    RVA addr;
-    QString mapname;
-    QString section;
-    QString reg;
-    QString fcn;
-    QString type;
-    QString asm_op;
-    QString perms;
-    ut64 value;
-    bool has_value;
-    QString string;
-    QSharedPointer<AddrRefs> ref;
-};
-
-struct CUTTER_EXPORT RegisterRef
-{
-    ut64 value;
-    AddrRefs ref;
-    QString name;
-};
-
 class CUTTER_EXPORT CutterCore : public QObject
 {
     Q_OBJECT
@@ -81,6 +68,8 @@ public:
     QDir getCutterRCDefaultDirectory() const;
 
     AsyncTaskManager *getAsyncTaskManager() { return asyncTaskManager; }
+    PreviewCache *getPreviewCache() { return previewCache; }
+    RefreshScheduler *getRefreshScheduler() { return refreshScheduler; }
 
     RVA getOffset() const { return core_->offset; }
 
@@ -237,6 +226,45 @@ public:
     QString nearestFlag(RVA offset, RVA *flagOffsetOut);
     void triggerFlagsChanged();
 
+    /* Name index */
+    /**
+     * @brief Find functions, flags, symbols or strings whose name contains \p substring
+     * (case-insensitive) using the trigram index.
+     * Kinds that changed since the last query are reindexed first.
+     * @param limit maximum number of results, -1 for no limit
+     */
+    QList<NameIndex::Entry> findNames(const QString &substring,
+                                      NameIndex::Kinds kinds = NameIndex::allKinds(),
+                                      int limit = -1);
+    /**
+     * @brief Addresses of all names of \p kinds containing \p substring
+     */
+    QSet<RVA> findNameAddresses(const QString &substring, NameIndex::Kinds kinds);
+    /**
+     * @brief Mark \p kinds as outdated, they will be reindexed on the next query
+     */
+    void invalidateNameIndex(NameIndex::Kinds kinds);
+    /**
+     * @brief Reindex the outdated segments among \p kinds. Safe to call from worker threads.
+     *
+     * Holds the core lock until the segments are published, a concurrent call for kinds which
+     * are being reindexed waits for them.
+     */
+    void updateNameIndex(NameIndex::Kinds kinds);
+    /**
+     * @brief Reindex the outdated segments among \p kinds in a NameIndexTask
+     *
+     * Reindexing takes the core lock, so the GUI thread should call this instead of
+     * findNames() and wait for nameIndexUpdated().
+     * @return true if \p kinds are up to date, so findNames() returns right away
+     */
+    bool requestNameIndex(NameIndex::Kinds kinds);
+    const NameIndex &getNameIndex() const { return nameIndex; }
+    /**
+     * @brief Counter incremented every time the indexed names change
+     */
+    int getNameIndexGeneration() const { return nameIndexGeneration.loadAcquire(); }
+
     /* Global Variables */
     void addGlobalVariable(RVA offset, QString name, QString typ);
     void delGlobalVariable(QString name);
@@ -448,6 +476,9 @@ public:
      * @brief Get a list of heap chunks
      * Uses RZ_API rz_heap_chunks_list to get vector of chunks
      * If arena_addr is zero return the chunks for main arena
+     *
+     * While debugging, the chunks are walked at most once per stop and not at all if neither the
+     * heap nor the arena were written since the previous walk, see getModifiedMemory().
      * @param arena_addr base address for the arena
      * @return Vector of heap chunks for the given arena
      */
@@ -501,9 +532,28 @@ public:
     void stepOverDebug();
     void stepOutDebug();
     void stepBackDebug();
+    /**
+     * @brief Run the emulation in the debug task until one of \p options is met
+     *
+     * Unlike continueUntilDebug() this checks every condition after each instruction and
+     * publishes the registers a few times per second, see emulationProgress(). suspendDebug()
+     * stops the run.
+     */
+    void continueEmulation(const TraceOptions &options);
 
     void startTraceSession();
     void stopTraceSession();
+    /**
+     * @brief Step or emulate in the debug task without refreshing the UI after every instruction
+     *
+     * The executed instructions are recorded into a ring buffer available from getRecordedTrace()
+     * once traceRecorded() is emitted. suspendDebug() stops the recording.
+     */
+    void recordTrace(const TraceOptions &options);
+    /**
+     * @brief Trace of the last finished recordTrace(), or null
+     */
+    QSharedPointer<const TraceBuffer> getRecordedTrace() const { return recordedTrace; }
 
     void addBreakpoint(const BreakpointDescription &config);
     void updateBreakpoint(int index, const BreakpointDescription &config);
@@ -518,11 +568,32 @@ public:
      * @param enabled - true if tracing should be enabled
      */
     void setBreakpointTrace(int index, bool enabled);
+    /**
+     * @brief Registers BreakpointDescription::breakIf may use, for BreakpointCondition::check()
+     */
+    QHash<QString, int> getBreakpointConditionRegisters();
     int breakpointIndexAt(RVA addr);
     BreakpointDescription getBreakpointAt(RVA addr);
 
-    bool isBreakpoint(const QList<RVA> &breakpoints, RVA addr);
+    bool isBreakpoint(const QSet<RVA> &breakpoints, RVA addr);
+    /**
+     * @brief Sorted addresses of all breakpoints
+     */
     QList<RVA> getBreakpointsAddresses();
+    /**
+     * @brief Addresses of all breakpoints for lookups from the code views
+     *
+     * The set is cached until the breakpoints change, so getting it is cheap.
+     */
+    QSet<RVA> getBreakpointAddressSet();
+    /**
+     * @brief Sorted addresses of the breakpoints in [begin, end)
+     */
+    QList<RVA> getBreakpointsInRange(RVA begin, RVA end);
+    /**
+     * @brief Incremented whenever the breakpoints or their hit counts may have changed
+     */
+    quint64 getBreakpointsGeneration() const { return breakpointsGeneration; }
 
     /**
      * @brief Get all breakpoinst that are belong to a functions at this address
@@ -532,6 +603,16 @@ public:
     QStringList getDebugPlugins();
     void setDebugPlugin(QString plugin);
     bool isDebugTaskInProgress();
+    /**
+     * @brief Debugger state at the current stop, shared by all debug widgets
+     *
+     * Parts of \p parts which were not collected by the debug task are collected now. They are
+     * also collected by the debug task at the next stop.
+     *
+     * While a long running debug task publishes intermediate state, that state is returned as is
+     * instead, so it may lack some of \p parts.
+     */
+    DebugSnapshot::Ptr getDebugSnapshot(DebugSnapshot::Parts parts);
     /**
      * @brief Check if we can use output/input redirection with the currently debugged process
      */
@@ -573,6 +654,33 @@ public:
     void loadPDB(const QString &file);
 
     QByteArray ioRead(RVA addr, int len);
+    /**
+     * @brief Like ioRead(), but while debugging the pages are kept until the next stop, see
+     * isMemoryModified()
+     */
+    QByteArray ioReadTracked(RVA addr, int len);
+    /**
+     * @brief Check if memory read with ioReadTracked() changed since the previous debugger stop
+     */
+    bool isMemoryModified(RVA addr, RVA size) const;
+    /**
+     * @brief Read [addr, addr + size) again with ioReadTracked() after it was written through
+     * rizin directly rather than through the edit methods of CutterCore
+     */
+    void memoryWritten(RVA addr, RVA size);
+    /**
+     * @brief Memory ranges modified since the previous debugger stop
+     *
+     * Contains the pages read with ioReadTracked() and, when debugging a local process on Linux,
+     * all written pages of the process at the next stop. The process is only scanned at stops
+     * following a call.
+     * @param complete set to whether the ranges contain all written pages of the process
+     */
+    QList<QPair<RVA, RVA>> getModifiedMemory(bool *complete = nullptr);
+    /**
+     * @brief Reads of the debuggee memory since the last debugger stop
+     */
+    MemoryChangeTracker::Statistics getMemoryStatistics() const;
 
     QList<RVA> getSeekHistory();
 
@@ -651,6 +759,25 @@ public:
 
     QList<MemoryMapDescription> getMemoryMap();
     QList<SearchDescription> getAllSearch(QString searchFor, QString space, QString in);
+    /**
+     * @brief Search only within [from, to), otherwise the same as getAllSearch()
+     */
+    QList<SearchDescription> getAllSearchInRange(QString searchFor, QString space, RVA from,
+                                                 RVA to);
+    /**
+     * @brief Get the address ranges a search covers
+     * @param in search boundaries, same as the search.in config
+     */
+    QList<AddressRangeDescription> getSearchBoundaries(const QString &in);
+    /**
+     * @brief Search for hex patterns with wildcards and masks using the native multi-threaded
+     * matcher, see BytePattern::parseList() for the syntax
+     * @param in search boundaries, same as the search.in config
+     * @param maxResults stop after this many results, 0 for no limit
+     * @param error set if the patterns can't be parsed
+     */
+    QList<SearchDescription> searchBytePatterns(const QString &patterns, const QString &in,
+                                                int maxResults = 0, QString *error = nullptr);
     QList<BreakpointDescription> getBreakpoints();
     QList<ProcessDescription> getAllProcesses();
     /**
@@ -760,6 +887,8 @@ signals:
     void globalVarsChanged();
     void functionsChanged();
     void flagsChanged();
+    /// A NameIndexTask started by requestNameIndex() finished
+    void nameIndexUpdated();
     void commentsChanged(RVA addr);
     void registersChanged();
     void instructionChanged(RVA offset);
@@ -795,6 +924,32 @@ signals:
      */
     void debugTaskStateChanged();
 
+    /**
+     * @brief A file was analyzed in batch mode, its project is saved once the connected slots
+     * return
+     *
+     * Plugins may connect to it in CutterPlugin::setupPlugin(). No UI exists in batch mode,
+     * CutterPlugin::setupInterface() is never called.
+     */
+    void batchAnalysisFinished(const QString &filename);
+
+    /**
+     * @brief Emitted from the debug task a few times per second while continueEmulation() runs
+     */
+    void emulationProgress(quint64 steps, RVA pc, quint64 stepsPerSecond);
+    void emulationFinished(quint64 steps, quint64 stepsPerSecond, const QString &stopReason);
+    /**
+     * @brief A long running debug task published intermediate state, see getDebugSnapshot()
+     */
+    void debugSnapshotPublished();
+
+    void traceRecordingStarted();
+    /**
+     * @brief Emitted from the debug task a few times per second while recording a trace
+     */
+    void traceRecordingProgress(quint64 steps, RVA pc);
+    void traceRecorded();
+
     /**
      * emitted when config regarding disassembly display changes
      */
@@ -834,6 +989,8 @@ private:
     void *coreBed = nullptr;
 
     AsyncTaskManager *asyncTaskManager;
+    PreviewCache *previewCache = nullptr;
+    RefreshScheduler *refreshScheduler = nullptr;
     RVA offsetPriorDebugging = RVA_INVALID;
     QErrorMessage msgBox;
 
@@ -845,7 +1002,70 @@ private:
     BasicInstructionHighlighter biHighlighter;
 
     QSharedPointer<RizinTask> debugTask;
+    DebugSnapshot::Ptr debugSnapshot;
+    DebugSnapshot::Parts debugSnapshotParts;
+    /// Intermediate snapshot of a running debug task, set from the task thread
+    DebugSnapshot::Ptr publishedSnapshot;
+    QMutex publishedSnapshotMutex;
     RizinTaskDialog *debugTaskDialog;
+    QSharedPointer<const TraceBuffer> recordedTrace;
+    MemoryChangeTracker memoryChanges;
+    bool modifiedMemoryRequested = false;
+
+    struct HeapChunksCache
+    {
+        RVA requestedArena = RVA_INVALID;
+        /// Address of the walked arena, resolved if the main arena was requested
+        RVA arena = RVA_INVALID;
+        QVector<Chunk> chunks;
+        /// Walked at a previous stop
+        bool stale = false;
+    };
+    HeapChunksCache heapChunks;
+    bool isHeapModified();
+    void invalidateHeapChunks();
+
+    struct BreakpointState
+    {
+        QString breakIf;
+        quint64 hits = 0;
+    };
+    /// Cutter side state of the breakpoints, by address
+    QHash<RVA, BreakpointState> breakpointStates;
+    void fillBreakpointState(BreakpointDescription *bp) const;
+
+    struct BreakpointAddressCache
+    {
+        QSet<RVA> set;
+        /// Kept while invalid, to tell whether resolving the addresses again moved them
+        QList<RVA> sorted;
+        bool valid = false;
+    };
+    BreakpointAddressCache breakpointAddresses;
+    quint64 breakpointsGeneration = 0;
+    const BreakpointAddressCache &getBreakpointAddressCache();
+    void invalidateBreakpointAddresses();
+    /// Resolve the addresses again, a new generation only if they moved
+    void resolveBreakpointAddresses();
+
+    NameIndex nameIndex;
+    QAtomicInt nameIndexDirtyKinds;
+    /// Kinds whose new segments are being fetched and not published yet
+    QAtomicInt nameIndexBuildingKinds;
+    QAtomicInt nameIndexGeneration;
+    QSharedPointer<NameIndexTask> nameIndexTask;
+    /// Requested while nameIndexTask was running
+    NameIndex::Kinds nameIndexPendingKinds;
+    void startNameIndexTask(NameIndex::Kinds kinds);
+    /// Kinds which are dirty or being rebuilt
+    int staleNameIndexKinds() const;
+    void rebuildNameIndex(int dirty);
+
+    /**
+     * @brief asyncTask() for a debugger stop, also collects the DebugSnapshot after \p fcn
+     */
+    bool asyncDebugTask(std::function<void(RzCore *)> fcn, QSharedPointer<RizinTask> &task);
+    void invalidateDebugSnapshot();
 
     QVector<QString> getCutterRCFilePaths() const;
     QList<TypeDescription> getBaseType(RzBaseTypeKind kind, const char *category);
@@ -854,9 +1074,13 @@ private:
 class CUTTER_EXPORT RzCoreLocked
 {
     CutterCore *const core;
+    CoreLockProfiler::Hold hold;
 
 public:
-    explicit RzCoreLocked(CutterCore *core);
+    /**
+     * @param function Q_FUNC_INFO of the caller, for the CoreLockProfiler
+     */
+    explicit RzCoreLocked(CutterCore *core, const char *function = nullptr);
     RzCoreLocked(const RzCoreLocked &) = delete;
     RzCoreLocked &operator=(const RzCoreLocked &) = delete;
     RzCoreLocked(RzCoreLocked &&);
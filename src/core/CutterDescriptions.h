@@ -10,6 +10,7 @@
 #include <QStringList>
 #include <QMetaType>
 #include <QColor>
+#include <QSharedPointer>
 #include "core/CutterCommon.h"
 
 struct FunctionDescription
@@ -88,6 +89,12 @@ struct SearchDescription
     QString data;
 };
 
+struct AddressRangeDescription
+{
+    RVA begin;
+    RVA end; // exclusive
+};
+
 struct SymbolDescription
 {
     RVA vaddr;
@@ -330,7 +337,12 @@ struct BreakpointDescription
     QString positionExpression;
     QString name;
     QString command;
+    /// Rizin command run at each hit
     QString condition;
+    /// Expression evaluated by Cutter at each hit while continuing, see BreakpointCondition
+    QString breakIf;
+    /// Hits counted by Cutter while continuing in the current debug session
+    quint64 hits = 0;
     bool hw = false;
     bool trace = false;
     bool enabled = true;
@@ -346,6 +358,38 @@ struct ProcessDescription
     QString path;
 };
 
+struct BacktraceDescription
+{
+    QString function;
+    RVA pc;
+    RVA sp;
+    ut64 frameSize;
+    QString description;
+};
+
+struct CUTTER_EXPORT AddrRefs
+{
+    RVA addr;
+    QString mapname;
+    QString section;
+    QString reg;
+    QString fcn;
+    QString type;
+    QString asm_op;
+    QString perms;
+    ut64 value;
+    bool has_value;
+    QString string;
+    QSharedPointer<AddrRefs> ref;
+};
+
+struct CUTTER_EXPORT RegisterRef
+{
+    ut64 value;
+    AddrRefs ref;
+    QString name;
+};
+
 struct RefDescription
 {
     QString ref;
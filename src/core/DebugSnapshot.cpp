@@ -0,0 +1,411 @@
+#include "DebugSnapshot.h"
+#include "MemoryChangeTracker.h"
+
+#include <QHash>
+#include <QPair>
+
+#include <cstring>
+
+/**
+ * @brief Memoized address lookups and memory reads for the telescoping of one stop
+ *
+ * The stack slots, the registers and the pointers they telescope into mostly point into the same
+ * few pages, so every address is classified once and memory is read a page at a time instead of
+ * with one small read per slot and dereference.
+ */
+class TelescopeCache
+{
+public:
+    static constexpr RVA PageSize = 0x1000;
+
+    explicit TelescopeCache(MemoryChangeTracker *memory = nullptr) : memory(memory) {}
+
+    ut64 addressType(RzCore *core, RVA addr)
+    {
+        auto it = types.constFind(addr);
+        if (it != types.constEnd()) {
+            return it.value();
+        }
+        ut64 type = rz_core_analysis_address(core, addr);
+        types.insert(addr, type);
+        return type;
+    }
+
+    QString hasRefs(RzCore *core, ut64 value)
+    {
+        auto it = hasRefsResults.constFind(value);
+        if (it != hasRefsResults.constEnd()) {
+            return it.value();
+        }
+        QString result = fromOwnedCharPtr(rz_core_analysis_hasrefs(core, value, true));
+        hasRefsResults.insert(value, result);
+        return result;
+    }
+
+    /**
+     * @brief Like rz_io_read_at(), through the cached pages
+     */
+    void read(RzCore *core, RVA addr, QByteArray *buf)
+    {
+        int done = 0;
+        while (done < buf->size()) {
+            RVA pageAddr = addr & ~(PageSize - 1);
+            int offset = static_cast<int>(addr - pageAddr);
+            int chunk = qMin(buf->size() - done, static_cast<int>(PageSize) - offset);
+            const QByteArray &page = getPage(core, pageAddr);
+            memcpy(buf->data() + done, page.constData() + offset, chunk);
+            done += chunk;
+            addr += chunk;
+        }
+    }
+
+    /// Telescoped references by address and depth
+    QHash<QPair<RVA, int>, AddrRefs> refs;
+
+private:
+    const QByteArray &getPage(RzCore *core, RVA pageAddr)
+    {
+        auto it = pages.find(pageAddr);
+        if (it == pages.end()) {
+            QByteArray page;
+            if (memory) {
+                // Shares the pages read ahead at the stop
+                page = memory->read(core, pageAddr, static_cast<int>(PageSize));
+            } else {
+                page = QByteArray(static_cast<int>(PageSize), '\xff');
+                rz_io_read_at(core->io, pageAddr, reinterpret_cast<ut8 *>(page.data()),
+                              page.size());
+            }
+            it = pages.insert(pageAddr, page);
+        }
+        return it.value();
+    }
+
+    MemoryChangeTracker *memory;
+
+    QHash<RVA, ut64> types;
+    QHash<ut64, QString> hasRefsResults;
+    QHash<RVA, QByteArray> pages;
+};
+
+DebugSnapshot::Ptr DebugSnapshot::collect(RzCore *core, Parts parts, const Ptr &base,
+                                          MemoryChangeTracker *memory)
+{
+    QSharedPointer<DebugSnapshot> snapshot = base ? QSharedPointer<DebugSnapshot>::create(*base)
+                                                  : QSharedPointer<DebugSnapshot>::create();
+    Parts missing = parts & ~snapshot->parts;
+
+    if (!snapshot->telescopeCache) {
+        snapshot->telescopeCache = QSharedPointer<TelescopeCache>::create(memory);
+    }
+    TelescopeCache *cache = snapshot->telescopeCache.data();
+
+    if (!base) {
+        snapshot->programCounter = rz_core_reg_getv_by_role_or_name(core, "PC");
+        snapshot->stackPointer = rz_core_reg_getv_by_role_or_name(core, "SP");
+    }
+    if (missing.testFlag(Part::RegisterValues)) {
+        snapshot->registerValues = collectRegisterValues(core, cache);
+    }
+    if (missing.testFlag(Part::RegisterRefs)) {
+        snapshot->registerRefs = collectRegisterRefs(core, RefsDepth, cache);
+    }
+    if (missing.testFlag(Part::Stack)) {
+        snapshot->stack = collectStack(core, StackSize, RefsDepth, cache);
+    }
+    if (missing.testFlag(Part::Backtrace)) {
+        snapshot->backtrace = collectBacktrace(core);
+    }
+    if (missing.testFlag(Part::Threads)) {
+        snapshot->threads = collectThreads(core, -1);
+    }
+    if (missing.testFlag(Part::MemoryMaps)) {
+        snapshot->memoryMaps = collectMemoryMaps(core);
+    }
+    snapshot->parts |= missing;
+    return snapshot;
+}
+
+RzReg *DebugSnapshot::getReg(RzCore *core)
+{
+    return rz_core_is_debug(core) ? core->dbg->reg : core->analysis->reg;
+}
+
+bool DebugSnapshot::syncRegisters(RzCore *core, RzRegisterType type, bool write)
+{
+    if (rz_core_is_debug(core)) {
+        return rz_debug_reg_sync(core->dbg, type, write);
+    }
+    return true;
+}
+
+QVector<RegisterRefValueDescription> DebugSnapshot::collectRegisterValues(RzCore *core,
+                                                                         TelescopeCache *cache)
+{
+    TelescopeCache localCache;
+    if (!cache) {
+        cache = &localCache;
+    }
+    QVector<RegisterRefValueDescription> result;
+    RzReg *reg = getReg(core);
+    RzList *ritems = rz_core_reg_filter_items_sync(core, reg, syncRegisters, nullptr);
+    if (!ritems) {
+        return result;
+    }
+    RzListIter *it;
+    RzRegItem *ri;
+    CutterRzListForeach (ritems, it, RzRegItem, ri) {
+        RegisterRefValueDescription desc;
+        desc.name = ri->name;
+        ut64 value = rz_reg_get_value(reg, ri);
+        desc.value = "0x" + QString::number(value, 16);
+        desc.ref = cache->hasRefs(core, value);
+        result.push_back(desc);
+    }
+    rz_list_free(ritems);
+    return result;
+}
+
+QList<RegisterRef> DebugSnapshot::collectRegisterRefs(RzCore *core, int depth,
+                                                      TelescopeCache *cache)
+{
+    TelescopeCache localCache;
+    if (!cache) {
+        cache = &localCache;
+    }
+    QList<RegisterRef> ret;
+    RzReg *reg = getReg(core);
+    RzList *ritems = rz_core_reg_filter_items_sync(core, reg, syncRegisters, nullptr);
+    if (!ritems) {
+        return ret;
+    }
+    RzListIter *it;
+    RzRegItem *ri;
+    CutterRzListForeach (ritems, it, RzRegItem, ri) {
+        RegisterRef regRef;
+        regRef.value = rz_reg_get_value(reg, ri);
+        regRef.ref = collectAddrRefs(core, regRef.value, depth, cache);
+        regRef.name = ri->name;
+        ret.append(regRef);
+    }
+    rz_list_free(ritems);
+    return ret;
+}
+
+QList<AddrRefs> DebugSnapshot::collectStack(RzCore *core, int size, int depth,
+                                            TelescopeCache *cache)
+{
+    TelescopeCache localCache;
+    if (!cache) {
+        cache = &localCache;
+    }
+    QList<AddrRefs> stack;
+    RVA addr = rz_core_reg_getv_by_role_or_name(core, "SP");
+    if (addr == RVA_INVALID) {
+        return stack;
+    }
+
+    int base = core->analysis->bits;
+    for (int i = 0; i < size; i += base / 8) {
+        if ((base == 32 && addr + i >= UT32_MAX) || (base == 16 && addr + i >= UT16_MAX)) {
+            break;
+        }
+
+        stack.append(collectAddrRefs(core, addr + i, depth, cache));
+    }
+
+    return stack;
+}
+
+AddrRefs DebugSnapshot::collectAddrRefs(RzCore *core, RVA addr, int depth, TelescopeCache *cache)
+{
+    AddrRefs refs;
+    if (depth < 1 || addr == UT64_MAX) {
+        refs.addr = RVA_INVALID;
+        return refs;
+    }
+
+    TelescopeCache localCache;
+    if (!cache) {
+        cache = &localCache;
+    }
+    const QPair<RVA, int> key(addr, depth);
+    auto cached = cache->refs.constFind(key);
+    if (cached != cache->refs.constEnd()) {
+        return cached.value();
+    }
+
+    int bits = core->rasm->bits;
+    QByteArray buf = QByteArray();
+    ut64 type = cache->addressType(core, addr);
+
+    refs.addr = addr;
+
+    // Search for the section the addr is in, avoid duplication for heap/stack with type
+    if (!(type & RZ_ANALYSIS_ADDR_TYPE_HEAP || type & RZ_ANALYSIS_ADDR_TYPE_STACK)) {
+        // Attempt to find the address within a map
+        RzDebugMap *map = rz_debug_map_get(core->dbg, addr);
+        if (map && map->name && map->name[0]) {
+            refs.mapname = map->name;
+        }
+
+        RzBinSection *sect = rz_bin_get_section_at(rz_bin_cur_object(core->bin), addr, true);
+        if (sect && sect->name[0]) {
+            refs.section = sect->name;
+        }
+    }
+
+    // Check if the address points to a register
+    RzFlagItem *fi = rz_flag_get_i(core->flags, addr);
+    if (fi) {
+        RzRegItem *r = rz_reg_get(getReg(core), fi->name, -1);
+        if (r) {
+            refs.reg = r->name;
+        }
+    }
+
+    // Attempt to find the address within a function
+    RzAnalysisFunction *fcn = rz_analysis_get_fcn_in(core->analysis, addr, 0);
+    if (fcn) {
+        refs.fcn = fcn->name;
+    }
+
+    // Update type and permission information
+    if (type != 0) {
+        if (type & RZ_ANALYSIS_ADDR_TYPE_HEAP) {
+            refs.type = "heap";
+        } else if (type & RZ_ANALYSIS_ADDR_TYPE_STACK) {
+            refs.type = "stack";
+        } else if (type & RZ_ANALYSIS_ADDR_TYPE_PROGRAM) {
+            refs.type = "program";
+        } else if (type & RZ_ANALYSIS_ADDR_TYPE_LIBRARY) {
+            refs.type = "library";
+        } else if (type & RZ_ANALYSIS_ADDR_TYPE_ASCII) {
+            refs.type = "ascii";
+        } else if (type & RZ_ANALYSIS_ADDR_TYPE_SEQUENCE) {
+            refs.type = "sequence";
+        }
+
+        QString perms = "";
+        if (type & RZ_ANALYSIS_ADDR_TYPE_READ) {
+            perms += "r";
+        }
+        if (type & RZ_ANALYSIS_ADDR_TYPE_WRITE) {
+            perms += "w";
+        }
+        if (type & RZ_ANALYSIS_ADDR_TYPE_EXEC) {
+            RzAsmOp op;
+            buf.resize(32);
+            perms += "x";
+            // Instruction disassembly
+            cache->read(core, addr, &buf);
+            rz_asm_set_pc(core->rasm, addr);
+            rz_asm_disassemble(core->rasm, &op, (unsigned char *)buf.data(), buf.size());
+            refs.asm_op = rz_asm_op_get_asm(&op);
+        }
+
+        if (!perms.isEmpty()) {
+            refs.perms = perms;
+        }
+    }
+
+    // Try to telescope further if depth permits it
+    if ((type & RZ_ANALYSIS_ADDR_TYPE_READ)) {
+        buf.resize(64);
+        cache->read(core, addr, &buf);
+        ut32 *n32 = (ut32 *)buf.data();
+        ut64 *n64 = (ut64 *)buf.data();
+        ut64 n = (bits == 64) ? *n64 : *n32;
+        // The value of the next address will serve as an indication that there's more to
+        // telescope if we have reached the depth limit
+        refs.value = n;
+        refs.has_value = true;
+        if (depth && n != addr && !(type & RZ_ANALYSIS_ADDR_TYPE_EXEC)) {
+            // Make sure we aren't telescoping the same address
+            AddrRefs ref = collectAddrRefs(core, n, depth - 1, cache);
+            if (!ref.type.isNull()) {
+                // If the dereference of the current pointer is an ascii character we
+                // might have a string in this address
+                if (ref.type.contains("ascii")) {
+                    buf.resize(128);
+                    cache->read(core, addr, &buf);
+                    QString strVal = QString(buf);
+                    // Indicate that the string is longer than the printed value
+                    if (strVal.size() == buf.size()) {
+                        strVal += "...";
+                    }
+                    refs.string = strVal;
+                }
+                refs.ref = QSharedPointer<AddrRefs>::create(ref);
+            }
+        }
+    }
+    cache->refs.insert(key, refs);
+    return refs;
+}
+
+QList<BacktraceDescription> DebugSnapshot::collectBacktrace(RzCore *core)
+{
+    QList<BacktraceDescription> ret;
+    RzList *list = rz_core_debug_backtraces(core);
+    RzListIter *iter;
+    RzBacktrace *bt;
+    CutterRzListForeach (list, iter, RzBacktrace, bt) {
+        BacktraceDescription frame;
+        frame.function = bt->fcn ? bt->fcn->name : "";
+        frame.pc = bt->frame ? bt->frame->addr : 0;
+        frame.sp = bt->frame ? bt->frame->sp : 0;
+        frame.frameSize = bt->frame ? bt->frame->size : 0;
+        frame.description = bt->desc;
+        ret << frame;
+    }
+    rz_list_free(list);
+    return ret;
+}
+
+QList<ProcessDescription> DebugSnapshot::collectThreads(RzCore *core, int pid)
+{
+    RzList *list = rz_debug_pids(core->dbg, pid != -1 ? pid : core->dbg->pid);
+    RzListIter *iter;
+    RzDebugPid *p;
+    QList<ProcessDescription> ret;
+
+    CutterRzListForeach (list, iter, RzDebugPid, p) {
+        ProcessDescription proc;
+
+        proc.current = core->dbg->pid == p->pid;
+        proc.ppid = p->ppid;
+        proc.pid = p->pid;
+        proc.uid = p->uid;
+        proc.status = static_cast<RzDebugPidState>(p->status);
+        proc.path = p->path;
+
+        ret << proc;
+    }
+    rz_list_free(list);
+    return ret;
+}
+
+QList<MemoryMapDescription> DebugSnapshot::collectMemoryMaps(RzCore *core)
+{
+    RzList *list0 = rz_debug_map_list(core->dbg, false);
+    RzList *list1 = rz_debug_map_list(core->dbg, true);
+    rz_list_join(list0, list1);
+    QList<MemoryMapDescription> ret;
+    RzListIter *it;
+    RzDebugMap *map;
+    CutterRzListForeach (list0, it, RzDebugMap, map) {
+        MemoryMapDescription memMap;
+
+        memMap.name = map->name;
+        memMap.fileName = map->file;
+        memMap.addrStart = map->addr;
+        memMap.addrEnd = map->addr_end;
+        memMap.type = map->user ? "u" : "s";
+        memMap.permission = rz_str_rwx_i(map->perm);
+
+        ret << memMap;
+    }
+
+    return ret;
+}
@@ -0,0 +1,96 @@
+#ifndef CUTTER_DEBUGSNAPSHOT_H
+#define CUTTER_DEBUGSNAPSHOT_H
+
+#include "CutterCommon.h"
+#include "CutterDescriptions.h"
+
+#include <QFlags>
+#include <QSharedPointer>
+#include <QVector>
+
+class TelescopeCache;
+class MemoryChangeTracker;
+
+/**
+ * @brief Debugger state at one stop: registers, stack, backtrace, threads and memory maps
+ *
+ * Querying the debugger is expensive, especially against a remote gdbserver where every query is
+ * a packet round trip. The snapshot is collected once per stop inside the debug task, right after
+ * the step or continue, and then shared read-only by all debug widgets through
+ * CutterCore::getDebugSnapshot().
+ *
+ * Only the parts requested by widgets after the previous stop are collected in the debug task,
+ * parts requested later are collected on demand and added to a copy of the snapshot.
+ */
+class CUTTER_EXPORT DebugSnapshot
+{
+public:
+    using Ptr = QSharedPointer<const DebugSnapshot>;
+
+    enum class Part {
+        RegisterValues = 1 << 0,
+        RegisterRefs = 1 << 1,
+        Stack = 1 << 2,
+        Backtrace = 1 << 3,
+        Threads = 1 << 4,
+        MemoryMaps = 1 << 5,
+    };
+    Q_DECLARE_FLAGS(Parts, Part)
+
+    static constexpr int StackSize = 0x100;
+    static constexpr int RefsDepth = 6;
+
+    /// Parts which have been collected
+    Parts parts;
+
+    RVA programCounter = RVA_INVALID;
+    RVA stackPointer = RVA_INVALID;
+    QVector<RegisterRefValueDescription> registerValues;
+    QList<RegisterRef> registerRefs;
+    QList<AddrRefs> stack;
+    QList<BacktraceDescription> backtrace;
+    /// Threads of the debugged process
+    QList<ProcessDescription> threads;
+    QList<MemoryMapDescription> memoryMaps;
+
+    /**
+     * @brief Collect \p parts which are not in \p base yet, into a copy of \p base
+     *
+     * The caller must have exclusive access to \p core, i.e. hold the core lock or run inside
+     * the debug task.
+     * @param memory if given, telescoping reads memory through it, sharing its pages with the
+     * memory views. Only used if \p base is null.
+     */
+    static Ptr collect(RzCore *core, Parts parts, const Ptr &base = Ptr(),
+                       MemoryChangeTracker *memory = nullptr);
+
+    /**
+     * @brief Registers of the debugger or of the ESIL emulation
+     */
+    static RzReg *getReg(RzCore *core);
+    static bool syncRegisters(RzCore *core, RzRegisterType type, bool write);
+
+    /*
+     * The telescoping functions memoize address lookups and read memory by whole pages through
+     * \p cache. Without one, they use a cache which only lives for the call.
+     */
+    static QVector<RegisterRefValueDescription>
+    collectRegisterValues(RzCore *core, TelescopeCache *cache = nullptr);
+    static QList<RegisterRef> collectRegisterRefs(RzCore *core, int depth,
+                                                  TelescopeCache *cache = nullptr);
+    static QList<AddrRefs> collectStack(RzCore *core, int size, int depth,
+                                        TelescopeCache *cache = nullptr);
+    static AddrRefs collectAddrRefs(RzCore *core, RVA addr, int depth,
+                                    TelescopeCache *cache = nullptr);
+    static QList<BacktraceDescription> collectBacktrace(RzCore *core);
+    static QList<ProcessDescription> collectThreads(RzCore *core, int pid);
+    static QList<MemoryMapDescription> collectMemoryMaps(RzCore *core);
+
+private:
+    /// Shared with the copies made by collect() for the same stop
+    QSharedPointer<TelescopeCache> telescopeCache;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(DebugSnapshot::Parts)
+
+#endif // CUTTER_DEBUGSNAPSHOT_H
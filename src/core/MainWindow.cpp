@@ -3,7 +3,9 @@
 
 // Common Headers
 #include "common/AnalysisTask.h"
+#include "common/ProjectLoadTask.h"
 #include "common/BugReporting.h"
+#include "common/StallWatchdog.h"
 #include "common/Highlighter.h"
 #include "common/Helpers.h"
 #include "common/SvgIconEngine.h"
@@ -26,6 +28,7 @@
 #include "dialogs/MapFileDialog.h"
 #include "dialogs/AsyncTaskDialog.h"
 #include "dialogs/LayoutManager.h"
+#include "dialogs/StallLogDialog.h"
 
 // Widgets Headers
 #include "widgets/DisassemblerGraphView.h"
@@ -73,6 +76,8 @@
 #include "widgets/RizinGraphWidget.h"
 #include "widgets/CallGraph.h"
 #include "widgets/HeapDockWidget.h"
+#include "widgets/TraceWidget.h"
+#include "widgets/CoreLockWidget.h"
 
 // Qt Headers
 #include <QActionGroup>
@@ -85,6 +90,7 @@
 #include <QDockWidget>
 #include <QFile>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QFont>
 #include <QFontDialog>
 #include <QLabel>
@@ -92,6 +98,8 @@
 #include <QList>
 #include <QMessageBox>
 #include <QProcess>
+#include <QPointer>
+#include <QProgressBar>
 #include <QPropertyAnimation>
 #include <QSysInfo>
 #include <QJsonObject>
@@ -101,6 +109,7 @@
 #include <QScrollBar>
 #include <QSettings>
 #include <QShortcut>
+#include <QStatusBar>
 #include <QStringListModel>
 #include <QStyledItemDelegate>
 #include <QStyleFactory>
@@ -243,6 +252,17 @@ void MainWindow::initUI()
     connect(ui->actionManageLayouts, &QAction::triggered, this, &MainWindow::manageLayouts);
     connect(ui->actionDocumentation, &QAction::triggered, this, &MainWindow::documentationClicked);
 
+    connect(StallWatchdog::instance(), &StallWatchdog::stallEnded, this,
+            [this](const StallWatchdog::Stall &stall) {
+                // Shorter ones are only logged
+                if (stall.durationMs >= 2000) {
+                    statusBar()->showMessage(tr("The interface did not respond for %1 s, see "
+                                                "Help > Interface Stalls")
+                                                     .arg(stall.durationMs / 1000.0, 0, 'f', 1),
+                                             10000);
+                }
+            });
+
     /* Setup plugins interfaces */
     const auto &plugins = Plugins()->getPlugins();
     for (auto &plugin : plugins) {
@@ -288,7 +308,7 @@ void MainWindow::initToolBar()
     spacer3->setMaximumWidth(100);
     ui->mainToolBar->addWidget(spacer3);
 
-    DebugActions *debugActions = new DebugActions(ui->mainToolBar, this);
+    debugActions = new DebugActions(ui->mainToolBar, this);
     // Debug menu
     auto debugViewAction = ui->menuDebug->addAction(tr("View"));
     debugViewAction->setMenu(ui->menuAddDebugWidgets);
@@ -374,76 +394,154 @@ void MainWindow::initDocks()
 
     dashboardDock = new Dashboard(this);
     functionsDock = new FunctionsWidget(this);
-    typesDock = new TypesWidget(this);
     searchDock = new SearchWidget(this);
     commentsDock = new CommentsWidget(this);
     stringsDock = new StringsWidget(this);
 
-    QList<CutterDockWidget *> debugDocks = { stackDock = new StackWidget(this),
-                                             threadsDock = new ThreadsWidget(this),
-                                             processesDock = new ProcessesWidget(this),
-                                             backtraceDock = new BacktraceWidget(this),
-                                             registersDock = new RegistersWidget(this),
-                                             memoryMapDock = new MemoryMapWidget(this),
-                                             breakpointDock = new BreakpointWidget(this),
-                                             registerRefsDock = new RegisterRefsWidget(this),
-                                             heapDock = new HeapDockWidget(this) };
-
-    QList<CutterDockWidget *> infoDocks = {
-        classesDock = new ClassesWidget(this),
-        entrypointDock = new EntrypointWidget(this),
-        exportsDock = new ExportsWidget(this),
-        flagsDock = new FlagsWidget(this),
-        headersDock = new HeadersWidget(this),
-        importsDock = new ImportsWidget(this),
-        relocsDock = new RelocsWidget(this),
-        resourcesDock = new ResourcesWidget(this),
-        sdbDock = new SdbWidget(this),
-        sectionsDock = new SectionsWidget(this),
-        segmentsDock = new SegmentsWidget(this),
-        symbolsDock = new SymbolsWidget(this),
-        globalsDock = new GlobalsWidget(this),
-        vTablesDock = new VTablesWidget(this),
-        flirtDock = new FlirtWidget(this),
-        rzGraphDock = new RizinGraphWidget(this),
-        callGraphDock = new CallGraphWidget(this, false),
-        globalCallGraphDock = new CallGraphWidget(this, true),
+    // The other docks are only constructed once they are shown, either by the user or by a
+    // layout. The titles come from their classes, so that the existing translations are used.
+    auto title = [](const char *context, const char *text) {
+        return QCoreApplication::translate(context, text);
+    };
+    QList<QAction *> debugActions = {
+        addLazyDock("StackWidget", title("StackWidget", "Stack"),
+                    [this]() { return stackDock = new StackWidget(this); }),
+        addLazyDock("ThreadsWidget", title("ThreadsWidget", "Threads"),
+                    [this]() { return threadsDock = new ThreadsWidget(this); }),
+        addLazyDock("ProcessesWidget", title("ProcessesWidget", "Processes"),
+                    [this]() { return processesDock = new ProcessesWidget(this); }),
+        addLazyDock("BacktraceWidget", title("BacktraceWidget", "Backtrace"),
+                    [this]() { return backtraceDock = new BacktraceWidget(this); }),
+        addLazyDock("RegistersWidget", title("RegistersWidget", "Registers"),
+                    [this]() { return registersDock = new RegistersWidget(this); }),
+        addLazyDock("MemoryMapWidget", title("MemoryMapWidget", "Memory Map"),
+                    [this]() { return memoryMapDock = new MemoryMapWidget(this); }),
+        addLazyDock("BreakpointWidget", title("BreakpointWidget", "Breakpoints"),
+                    [this]() { return breakpointDock = new BreakpointWidget(this); }),
+        addLazyDock("RegisterRefsWidget", title("RegisterRefsWidget", "Register References"),
+                    [this]() { return registerRefsDock = new RegisterRefsWidget(this); }),
+        addLazyDock("HeapDockWidget", title("HeapDockWidget", "Heap"),
+                    [this]() { return heapDock = new HeapDockWidget(this); }),
+        addLazyDock("TraceWidget", title("TraceWidget", "Trace"),
+                    [this]() { return traceDock = new TraceWidget(this); }),
     };
 
-    auto makeActionList = [this](QList<CutterDockWidget *> docks) {
-        QList<QAction *> result;
-        for (auto dock : docks) {
-            if (dock != nullptr) {
-                result.push_back(dock->toggleViewAction());
-            } else {
-                auto separator = new QAction(this);
-                separator->setSeparator(true);
-                result.push_back(separator);
-            }
-        }
-        return result;
+    QList<QAction *> infoActions = {
+        addLazyDock("ClassesWidget", title("ClassesWidget", "Classes"),
+                    [this]() { return classesDock = new ClassesWidget(this); }),
+        addLazyDock("EntrypointWidget", title("EntrypointWidget", "Entry Points"),
+                    [this]() { return entrypointDock = new EntrypointWidget(this); }),
+        addLazyDock("ExportsWidget", title("ExportsWidget", "Exports"),
+                    [this]() { return exportsDock = new ExportsWidget(this); }),
+        addLazyDock("FlagsWidget", title("FlagsWidget", "Flags"),
+                    [this]() { return flagsDock = new FlagsWidget(this); }),
+        addLazyDock("HeadersWidget", title("HeadersWidget", "Headers"),
+                    [this]() { return headersDock = new HeadersWidget(this); }),
+        addLazyDock("ImportsWidget", title("ImportsWidget", "Imports"),
+                    [this]() { return importsDock = new ImportsWidget(this); }),
+        addLazyDock("RelocsWidget", title("RelocsWidget", "Relocs"),
+                    [this]() { return relocsDock = new RelocsWidget(this); }),
+        addLazyDock("ResourcesWidget", title("ResourcesWidget", "Resources"),
+                    [this]() { return resourcesDock = new ResourcesWidget(this); }),
+        addLazyDock("SdbWidget", title("SdbWidget", "SDB Browser"),
+                    [this]() { return sdbDock = new SdbWidget(this); }),
+        addLazyDock("SectionsWidget", title("SectionsWidget", "Sections"),
+                    [this]() { return sectionsDock = new SectionsWidget(this); }),
+        addLazyDock("SegmentsWidget", title("SegmentsWidget", "Segments"),
+                    [this]() { return segmentsDock = new SegmentsWidget(this); }),
+        addLazyDock("SymbolsWidget", title("SymbolsWidget", "Symbols"),
+                    [this]() { return symbolsDock = new SymbolsWidget(this); }),
+        addLazyDock("GlobalsWidget", title("GlobalsWidget", "Global Variables"),
+                    [this]() { return globalsDock = new GlobalsWidget(this); }),
+        addLazyDock("VTablesWidget", title("VTablesWidget", "&VTable"),
+                    [this]() { return vTablesDock = new VTablesWidget(this); }),
+        addLazyDock("FlirtWidget", title("FlirtWidget", "Signatures"),
+                    [this]() { return flirtDock = new FlirtWidget(this); }),
+        addLazyDock("RizinGraphWidget", title("RizinGraphWidget", "Rizin graphs"),
+                    [this]() { return rzGraphDock = new RizinGraphWidget(this); }),
+        addLazyDock(title("CallGraphWidget", "Callgraph"), title("CallGraphWidget", "Callgraph"),
+                    [this]() { return callGraphDock = new CallGraphWidget(this, false); }),
+        addLazyDock(title("CallGraphWidget", "GlobalCallgraph"),
+                    title("CallGraphWidget", "Global Callgraph"),
+                    [this]() { return globalCallGraphDock = new CallGraphWidget(this, true); }),
+    };
+
+    auto separator = [this]() {
+        auto action = new QAction(this);
+        action->setSeparator(true);
+        return action;
     };
 
-    QList<CutterDockWidget *> windowDocks = {
-        dashboardDock, nullptr,     functionsDock, overviewDock, nullptr,
-        searchDock,    stringsDock, typesDock,     nullptr,
+    QList<QAction *> windowActions = {
+        dashboardDock->toggleViewAction(),
+        separator(),
+        functionsDock->toggleViewAction(),
+        overviewDock->toggleViewAction(),
+        separator(),
+        searchDock->toggleViewAction(),
+        stringsDock->toggleViewAction(),
+        addLazyDock("TypesWidget", title("TypesWidget", "Types"),
+                    [this]() { return typesDock = new TypesWidget(this); }),
+        separator(),
     };
-    ui->menuWindows->insertActions(ui->actionExtraDecompiler, makeActionList(windowDocks));
-    QList<CutterDockWidget *> windowDocks2 = {
-        consoleDock,
-        commentsDock,
-        nullptr,
+    ui->menuWindows->insertActions(ui->actionExtraDecompiler, windowActions);
+    QList<QAction *> windowActions2 = {
+        consoleDock->toggleViewAction(),
+        commentsDock->toggleViewAction(),
+        addLazyDock("CoreLockWidget", title("CoreLockWidget", "Core Lock"),
+                    [this]() { return coreLockDock = new CoreLockWidget(this); }),
+        separator(),
     };
-    ui->menuWindows->addActions(makeActionList(windowDocks2));
-    ui->menuAddInfoWidgets->addActions(makeActionList(infoDocks));
-    ui->menuAddDebugWidgets->addActions(makeActionList(debugDocks));
-
-    auto uniqueDocks = windowDocks + windowDocks2 + infoDocks + debugDocks;
-    for (auto dock : uniqueDocks) {
-        if (dock) { // ignore nullptr used as separators
-            addWidget(dock);
+    ui->menuWindows->addActions(windowActions2);
+    ui->menuAddInfoWidgets->addActions(infoActions);
+    ui->menuAddDebugWidgets->addActions(debugActions);
+
+    QList<CutterDockWidget *> eagerDocks = { dashboardDock, functionsDock, overviewDock,
+                                             searchDock,    stringsDock,   consoleDock,
+                                             commentsDock };
+    for (auto dock : eagerDocks) {
+        addWidget(dock);
+    }
+}
+
+QAction *MainWindow::addLazyDock(const QString &objectName, const QString &title,
+                                 const std::function<CutterDockWidget *()> &create)
+{
+    auto action = new QAction(title, this);
+    action->setCheckable(true);
+    connect(action, &QAction::triggered, this, [this, objectName](bool checked) {
+        CutterDockWidget *dock = lazyDocks.value(objectName).dock;
+        if (!dock) {
+            dock = createLazyDock(objectName, true);
         }
+        dock->toggleDockWidget(checked);
+    });
+    lazyDocks.insert(objectName, { create, action, nullptr });
+    return action;
+}
+
+CutterDockWidget *MainWindow::createLazyDock(const QString &objectName, bool place)
+{
+    auto it = lazyDocks.find(objectName);
+    if (it == lazyDocks.end()) {
+        return nullptr;
     }
+    if (it->dock) {
+        return it->dock;
+    }
+
+    CutterDockWidget *dock = it->create();
+    it->dock = dock;
+    addWidget(dock);
+    // From now on the placeholder in the menus mirrors the dock's own action
+    QAction *action = it->action;
+    action->setChecked(dock->toggleViewAction()->isChecked());
+    connect(dock->toggleViewAction(), &QAction::toggled, action, &QAction::setChecked);
+    if (place && !restoreDockWidget(dock)) {
+        // Not part of the last restored layout
+        dockOnMainArea(dock);
+    }
+    return dock;
 }
 
 void MainWindow::toggleOverview(bool visibility, GraphWidget *targetGraph)
@@ -601,6 +699,8 @@ void MainWindow::displayInitialOptionsDialog(const InitialOptions &options, bool
 
     if (skipOptionsDialog) {
         if (!options.projectFile.isEmpty()) {
+            connect(this, &MainWindow::projectOpenFailed, this,
+                    &MainWindow::displayNewFileDialog);
             if (!openProject(options.projectFile)) {
                 displayNewFileDialog();
             };
@@ -614,29 +714,86 @@ void MainWindow::displayInitialOptionsDialog(const InitialOptions &options, bool
 
 bool MainWindow::openProject(const QString &file)
 {
-    RzProjectErr err;
-    RzList *res = rz_list_new();
-    {
-        RzCoreLocked core(Core());
-        err = rz_project_load_file(core, file.toUtf8().constData(), true, res);
-    }
-    if (err != RZ_PROJECT_ERR_SUCCESS) {
-        const char *s = rz_project_err_message(err);
-        QString msg = tr("Failed to open project: %1").arg(QString::fromUtf8(s));
-        RzListIter *it;
-        CutterRzListForeach (res, it, const char, s) {
-            msg += "\n" + QString::fromUtf8(s);
-        }
+    if (!QFileInfo(file).isReadable()) {
+        QString msg = tr("Failed to open project: %1")
+                              .arg(QString::fromUtf8(rz_project_err_message(RZ_PROJECT_ERR_FILE)));
         QMessageBox::critical(this, tr("Open Project"), msg);
-        rz_list_free(res);
         return false;
     }
 
-    Config()->addRecentProject(file);
+    auto *loadTask = new ProjectLoadTask(file);
+    AsyncTask::Ptr loadTaskPtr(loadTask);
 
-    rz_list_free(res);
-    setFilename(file.trimmed());
-    finalizeOpen();
+    QPointer<AsyncTaskDialog> taskDialog = new AsyncTaskDialog(loadTaskPtr);
+    taskDialog->setInterruptOnClose(true);
+    taskDialog->setAttribute(Qt::WA_DeleteOnClose);
+    taskDialog->show();
+
+    auto opened = QSharedPointer<bool>::create(false);
+    auto open = [this, file, taskDialog, opened]() {
+        *opened = true;
+        if (taskDialog) {
+            taskDialog->setInterruptOnClose(false);
+            taskDialog->close();
+        }
+        Config()->addRecentProject(file);
+        setFilename(file.trimmed());
+        finalizeOpen();
+        emit projectOpened();
+    };
+
+    auto progressBar = new QProgressBar();
+    progressBar->setMaximumWidth(200);
+    progressBar->setTextVisible(false);
+    progressBar->setRange(0, 0);
+    connect(loadTask, &ProjectLoadTask::loaded, this, [this, loadTask, open, progressBar]() {
+        open();
+        // Saving now would drop what is not restored yet
+        projectRestoring = true;
+        ui->actionSave->setEnabled(false);
+        ui->actionSaveAs->setEnabled(false);
+        statusBar()->addPermanentWidget(progressBar);
+        progressBar->show();
+        loadTask->resume();
+    });
+    connect(loadTask, &ProjectLoadTask::progressChanged, this,
+            [this, progressBar](int step, int steps, const QString &description) {
+                progressBar->setRange(0, steps);
+                progressBar->setValue(step);
+                statusBar()->showMessage(tr("Opening the project (%1/%2): %3")
+                                                 .arg(step + 1)
+                                                 .arg(steps)
+                                                 .arg(description));
+            });
+    connect(loadTask, &AsyncTask::finished, this, [this, loadTask, open, opened, progressBar]() {
+        statusBar()->clearMessage();
+        delete progressBar;
+        projectRestoring = false;
+        ui->actionSave->setEnabled(true);
+        ui->actionSaveAs->setEnabled(true);
+        if (!loadTask->isLoaded()) {
+            if (!loadTask->getErrorMessage().isEmpty()) {
+                QMessageBox::critical(this, tr("Open Project"), loadTask->getErrorMessage());
+            }
+            emit projectOpenFailed();
+            return;
+        }
+        if (!*opened) {
+            open();
+            return;
+        }
+        refreshAll();
+        if (!loadTask->isComplete()) {
+            // Saving asks for a new file instead of overwriting the project with what was restored
+            core->setConfig("prj.file", QString());
+            QMessageBox::warning(this, tr("Open Project"),
+                                 tr("The project could only be restored partially, save it "
+                                    "under a new name to keep the original.\n\n%1")
+                                         .arg(loadTask->getErrorMessage()));
+        }
+    });
+
+    core->getAsyncTaskManager()->start(loadTaskPtr);
     return true;
 }
 
@@ -644,7 +801,6 @@ void MainWindow::finalizeOpen()
 {
     core->getRegs();
     core->updateSeek();
-    refreshAll();
     // Add fortune message
     char *fortune = rz_core_fortune_get_random(core->core());
     if (fortune) {
@@ -668,6 +824,9 @@ void MainWindow::finalizeOpen()
 
     Config()->adjustColorThemeDarkness();
     setViewLayout(getViewLayout(LAYOUT_DEFAULT));
+    // Only now the docks the user sees are known, the others are refreshed once they are shown
+    refreshAll();
+    core->getRefreshScheduler()->runPending(RefreshScheduler::Priority::High);
 
     // Set focus to disasm or graph widget
     // Graph with function in it has focus priority over DisasmWidget.
@@ -699,6 +858,9 @@ void MainWindow::finalizeOpen()
 
 RzProjectErr MainWindow::saveProject(bool *canceled)
 {
+    if (refuseSaveWhileRestoring(canceled)) {
+        return RZ_PROJECT_ERR_SUCCESS;
+    }
     QString file = core->getConfig("prj.file");
     if (file.isEmpty()) {
         return saveProjectAs(canceled);
@@ -715,6 +877,9 @@ RzProjectErr MainWindow::saveProject(bool *canceled)
 
 RzProjectErr MainWindow::saveProjectAs(bool *canceled)
 {
+    if (refuseSaveWhileRestoring(canceled)) {
+        return RZ_PROJECT_ERR_SUCCESS;
+    }
     QString projectFile = core->getConfig("prj.file");
     if (projectFile.isEmpty()) {
         // preferred name is of fromat 'binary.exe.rzdb'
@@ -742,6 +907,20 @@ RzProjectErr MainWindow::saveProjectAs(bool *canceled)
     return err;
 }
 
+bool MainWindow::refuseSaveWhileRestoring(bool *canceled)
+{
+    if (!projectRestoring) {
+        return false;
+    }
+    QMessageBox::information(this, tr("Save Project"),
+                             tr("The project is still being restored. Save it once its cross "
+                                "references and metadata are complete."));
+    if (canceled) {
+        *canceled = true;
+    }
+    return true;
+}
+
 void MainWindow::showProjectSaveError(RzProjectErr err)
 {
     if (err == RZ_PROJECT_ERR_SUCCESS) {
@@ -752,11 +931,6 @@ void MainWindow::showProjectSaveError(RzProjectErr err)
                           tr("Failed to save project: %1").arg(QString::fromUtf8(s)));
 }
 
-void MainWindow::refreshOmniBar(const QStringList &flags)
-{
-    omnibar->refresh(flags);
-}
-
 void MainWindow::setFilename(const QString &fn)
 {
     // Add file name to window title
@@ -883,41 +1057,50 @@ void MainWindow::lockDocks(bool lock)
 
 void MainWindow::restoreDocks()
 {
+    // Lazy docks which don't exist yet are skipped, createLazyDock() places them later
+    auto tabify = [this](QDockWidget *first, QDockWidget *second) {
+        if (first && second && first != second) {
+            tabifyDockWidget(first, second);
+        }
+    };
+    auto firstOf = [](const QList<QDockWidget *> &docks) -> QDockWidget * {
+        for (auto dock : docks) {
+            if (dock) {
+                return dock;
+            }
+        }
+        return nullptr;
+    };
+
     // Initial structure
     // func | main area | debug
     //      |___________|
     //      | console   |
     addDockWidget(Qt::LeftDockWidgetArea, functionsDock);
     splitDockWidget(functionsDock, dashboardDock, Qt::Horizontal);
-    splitDockWidget(dashboardDock, stackDock, Qt::Horizontal);
+    const QList<QDockWidget *> debugColumn = { stackDock,     backtraceDock, threadsDock,
+                                               processesDock, heapDock,      traceDock };
+    QDockWidget *debugAnchor = firstOf(debugColumn);
+    if (debugAnchor) {
+        splitDockWidget(dashboardDock, debugAnchor, Qt::Horizontal);
+    }
     splitDockWidget(dashboardDock, consoleDock, Qt::Vertical);
 
     // overview bellow func
     splitDockWidget(functionsDock, overviewDock, Qt::Vertical);
 
     // main area
-    tabifyDockWidget(dashboardDock, entrypointDock);
-    tabifyDockWidget(dashboardDock, flagsDock);
-    tabifyDockWidget(dashboardDock, stringsDock);
-    tabifyDockWidget(dashboardDock, relocsDock);
-    tabifyDockWidget(dashboardDock, importsDock);
-    tabifyDockWidget(dashboardDock, exportsDock);
-    tabifyDockWidget(dashboardDock, typesDock);
-    tabifyDockWidget(dashboardDock, searchDock);
-    tabifyDockWidget(dashboardDock, headersDock);
-    tabifyDockWidget(dashboardDock, flirtDock);
-    tabifyDockWidget(dashboardDock, symbolsDock);
-    tabifyDockWidget(dashboardDock, globalsDock);
-    tabifyDockWidget(dashboardDock, classesDock);
-    tabifyDockWidget(dashboardDock, resourcesDock);
-    tabifyDockWidget(dashboardDock, vTablesDock);
-    tabifyDockWidget(dashboardDock, sdbDock);
-    tabifyDockWidget(dashboardDock, memoryMapDock);
-    tabifyDockWidget(dashboardDock, breakpointDock);
-    tabifyDockWidget(dashboardDock, registerRefsDock);
-    tabifyDockWidget(dashboardDock, rzGraphDock);
-    tabifyDockWidget(dashboardDock, callGraphDock);
-    tabifyDockWidget(dashboardDock, globalCallGraphDock);
+    const QList<QDockWidget *> mainArea = { entrypointDock,   flagsDock,     stringsDock,
+                                            relocsDock,       importsDock,   exportsDock,
+                                            typesDock,        searchDock,    headersDock,
+                                            flirtDock,        symbolsDock,   globalsDock,
+                                            classesDock,      resourcesDock, vTablesDock,
+                                            sdbDock,          memoryMapDock, breakpointDock,
+                                            registerRefsDock, rzGraphDock,   callGraphDock,
+                                            globalCallGraphDock };
+    for (auto dock : mainArea) {
+        tabify(dashboardDock, dock);
+    }
     for (const auto &it : dockWidgets) {
         // Check whether or not current widgets is graph, hexdump or disasm
         if (isExtraMemoryWidget(it)) {
@@ -926,16 +1109,22 @@ void MainWindow::restoreDocks()
     }
 
     // Console | Sections/segments/comments
-    splitDockWidget(consoleDock, sectionsDock, Qt::Horizontal);
-    tabifyDockWidget(sectionsDock, segmentsDock);
-    tabifyDockWidget(sectionsDock, commentsDock);
+    QDockWidget *consoleSide = firstOf({ sectionsDock, segmentsDock, commentsDock });
+    splitDockWidget(consoleDock, consoleSide, Qt::Horizontal);
+    tabify(consoleSide, segmentsDock);
+    tabify(consoleSide, commentsDock);
 
     // Add Stack, Registers, Threads and Backtrace vertically stacked
-    splitDockWidget(stackDock, registersDock, Qt::Vertical);
-    tabifyDockWidget(stackDock, backtraceDock);
-    tabifyDockWidget(backtraceDock, threadsDock);
-    tabifyDockWidget(threadsDock, processesDock);
-    tabifyDockWidget(processesDock, heapDock);
+    if (debugAnchor) {
+        if (registersDock) {
+            splitDockWidget(debugAnchor, registersDock, Qt::Vertical);
+        }
+        for (auto dock : debugColumn) {
+            tabify(debugAnchor, dock);
+        }
+    } else if (registersDock) {
+        splitDockWidget(dashboardDock, registersDock, Qt::Horizontal);
+    }
 
     for (auto dock : pluginDocks) {
         dockOnMainArea(dock);
@@ -946,7 +1135,8 @@ bool MainWindow::isDebugWidget(QDockWidget *dock) const
 {
     return dock == stackDock || dock == registersDock || dock == backtraceDock
             || dock == threadsDock || dock == memoryMapDock || dock == breakpointDock
-            || dock == processesDock || dock == registerRefsDock || dock == heapDock;
+            || dock == processesDock || dock == registerRefsDock || dock == heapDock
+            || dock == traceDock;
 }
 
 bool MainWindow::isExtraMemoryWidget(QDockWidget *dock) const
@@ -1300,12 +1490,15 @@ void MainWindow::showZenDocks()
 
 void MainWindow::showDebugDocks()
 {
-    QList<QDockWidget *> debugDocks = {
-        functionsDock, stringsDock, searchDock,    stackDock,      registersDock,
-        backtraceDock, threadsDock, memoryMapDock, breakpointDock,
-    };
+    QStringList lazyDebugDocks = { "StackWidget",   "RegistersWidget", "BacktraceWidget",
+                                   "ThreadsWidget", "MemoryMapWidget", "BreakpointWidget" };
     if (QSysInfo::kernelType() == "linux" || Core()->currentlyRemoteDebugging) {
-        debugDocks.append(heapDock);
+        lazyDebugDocks << "HeapDockWidget";
+    }
+    QList<QDockWidget *> debugDocks = { functionsDock, stringsDock, searchDock };
+    for (const QString &name : lazyDebugDocks) {
+        // Constructed and placed now if the user never opened it, so it can be shown below
+        debugDocks.append(createLazyDock(name, true));
     }
     functionDockWidthToRestore = functionsDock->maximumWidth();
     functionsDock->setMaximumWidth(200);
@@ -1411,13 +1604,26 @@ void MainWindow::setViewLayout(const CutterLayout &layout)
         docksToCreate =
                 QStringList { DisassemblyWidget::getWidgetType(), GraphWidget::getWidgetType(),
                               HexdumpWidget::getWidgetType(), DecompilerWidget::getWidgetType() };
+        // The lazy docks shown by showZenDocks() and showDebugDocks()
+        if (isDebug) {
+            docksToCreate << "StackWidget" << "RegistersWidget" << "BacktraceWidget"
+                          << "ThreadsWidget" << "MemoryMapWidget" << "BreakpointWidget";
+            if (QSysInfo::kernelType() == "linux" || Core()->currentlyRemoteDebugging) {
+                docksToCreate << "HeapDockWidget";
+            }
+        } else {
+            docksToCreate << "ImportsWidget";
+        }
     } else {
         docksToCreate = layout.viewProperties.keys();
     }
 
     for (const auto &it : docksToCreate) {
-        if (std::none_of(dockWidgets.constBegin(), dockWidgets.constEnd(),
-                         [&it](QDockWidget *w) { return w->objectName() == it; })) {
+        if (lazyDocks.contains(it)) {
+            // Placed by restoreDocks() and the layout state below
+            createLazyDock(it, false);
+        } else if (std::none_of(dockWidgets.constBegin(), dockWidgets.constEnd(),
+                                [&it](QDockWidget *w) { return w->objectName() == it; })) {
             auto className = it.split(';').at(0);
             if (widgetTypeToConstructorMap.contains(className)) {
                 auto widget = widgetTypeToConstructorMap[className](this);
@@ -1661,6 +1867,13 @@ void MainWindow::on_actionIssue_triggered()
     openIssue();
 }
 
+void MainWindow::on_actionStalls_triggered()
+{
+    auto dialog = new StallLogDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
+
 void MainWindow::documentationClicked()
 {
     QDesktopServices::openUrl(QUrl("https://cutter.re/docs/user-docs"));
@@ -1676,19 +1889,108 @@ void MainWindow::on_actionRefresh_Panels_triggered()
  */
 void MainWindow::on_actionAnalyze_triggered()
 {
+    // Also reachable from the preferences while an analysis runs
+    if (!ui->actionAnalyze->isEnabled()) {
+        return;
+    }
     auto *analysisTask = new AnalysisTask();
     InitialOptions options;
     options.analysisCmd = { { "aaa", "Auto analysis" } };
     analysisTask->setOptions(options);
+    startAnalysis(analysisTask, false);
+}
+
+void MainWindow::startAnalysis(AnalysisTask *analysisTask, bool openingFile)
+{
     AsyncTask::Ptr analysisTaskPtr(analysisTask);
+    analysisTask->setPublishResults(true);
+
+    // Until the file is loaded there is nothing to browse
+    QPointer<AsyncTaskDialog> taskDialog;
+    if (openingFile) {
+        taskDialog = new AsyncTaskDialog(analysisTaskPtr);
+        taskDialog->setInterruptOnClose(true);
+        taskDialog->setAttribute(Qt::WA_DeleteOnClose);
+        taskDialog->show();
+    }
+
+    auto progressBar = new QProgressBar();
+    progressBar->setMaximumWidth(200);
+    progressBar->setTextVisible(false);
+    progressBar->setRange(0, 0);
+    auto cancelButton = new QToolButton();
+    cancelButton->setText(tr("Cancel"));
+    cancelButton->setToolTip(tr("Stop the analysis and keep its results so far"));
+    connect(cancelButton, &QToolButton::clicked, analysisTask, [analysisTask, cancelButton]() {
+        cancelButton->setEnabled(false);
+        analysisTask->interrupt();
+    });
 
-    auto *taskDialog = new AsyncTaskDialog(analysisTaskPtr);
-    taskDialog->setInterruptOnClose(true);
-    taskDialog->setAttribute(Qt::WA_DeleteOnClose);
-    taskDialog->show();
-    connect(analysisTask, &AnalysisTask::finished, this, &MainWindow::refreshAll);
+    auto opened = QSharedPointer<bool>::create(!openingFile);
+    auto showProgress = [this, progressBar, cancelButton]() {
+        if (progressBar->parent()) {
+            return;
+        }
+        statusBar()->addPermanentWidget(progressBar);
+        statusBar()->addPermanentWidget(cancelButton);
+        progressBar->show();
+        cancelButton->show();
+    };
+    if (!openingFile) {
+        showProgress();
+    }
+
+    // Neither may run while the analysis releases the core between its steps
+    QList<QAction *> blockedActions = { ui->actionAnalyze, debugActions->actionStart,
+                                        debugActions->actionStartEmul, debugActions->actionAttach,
+                                        debugActions->actionStartRemote };
+    for (QAction *action : blockedActions) {
+        action->setEnabled(false);
+    }
+
+    connect(analysisTask, &AnalysisTask::resultsAvailable, this,
+            [this, analysisTask, taskDialog, opened, showProgress]() {
+                if (!*opened) {
+                    *opened = true;
+                    if (taskDialog) {
+                        taskDialog->setInterruptOnClose(false);
+                        taskDialog->close();
+                    }
+                    finalizeOpen();
+                    showProgress();
+                } else {
+                    refreshAll();
+                    // All visible widgets now, before the next command locks the core again
+                    core->getRefreshScheduler()->runPending(RefreshScheduler::Priority::Low);
+                }
+                analysisTask->resume();
+            });
+    connect(analysisTask, &AnalysisTask::progressChanged, this,
+            [this, progressBar](int step, int steps, const QString &description) {
+                progressBar->setRange(0, steps);
+                progressBar->setValue(step);
+                statusBar()->showMessage(
+                        tr("Analyzing (%1/%2): %3").arg(step + 1).arg(steps).arg(description));
+            });
+    connect(analysisTask, &AsyncTask::finished, this,
+            [this, analysisTask, opened, progressBar, cancelButton, blockedActions]() {
+                statusBar()->clearMessage();
+                delete progressBar;
+                delete cancelButton;
+                for (QAction *action : blockedActions) {
+                    action->setEnabled(true);
+                }
+                if (analysisTask->getOpenFileFailed()) {
+                    return;
+                }
+                if (!*opened) {
+                    finalizeOpen();
+                } else {
+                    refreshAll();
+                }
+            });
 
-    Core()->getAsyncTaskManager()->start(analysisTaskPtr);
+    core->getAsyncTaskManager()->start(analysisTaskPtr);
 }
 
 void MainWindow::on_actionImportPDB_triggered()
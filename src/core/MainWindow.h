@@ -10,6 +10,7 @@
 #include "common/CutterLayout.h"
 #include "MemoryDockWidget.h"
 
+#include <functional>
 #include <memory>
 
 #include <QMainWindow>
@@ -56,6 +57,8 @@ class OverviewWidget;
 class RizinGraphWidget;
 class CallGraphWidget;
 class HeapWidget;
+class AnalysisTask;
+class DebugActions;
 
 namespace Ui {
 class MainWindow;
@@ -75,8 +78,16 @@ public:
     void displayNewFileDialog();
     void displayWelcomeDialog();
     void closeNewFileDialog();
+    /**
+     * @brief Open the project in the background
+     * @return false if the project can't be read, otherwise projectOpened() or
+     * projectOpenFailed() is emitted later
+     */
     bool openProject(const QString &project_name);
 
+    /**
+     * @brief Save the project, which is refused as canceled while it is still being restored
+     */
     RzProjectErr saveProject(bool *canceled);
     RzProjectErr saveProjectAs(bool *canceled);
     void showProjectSaveError(RzProjectErr err);
@@ -86,7 +97,6 @@ public:
     void readSettings();
     void saveSettings();
     void setFilename(const QString &fn);
-    void refreshOmniBar(const QStringList &flags);
 
     void addWidget(CutterDockWidget *widget);
     void addMemoryDockWidget(MemoryDockWidget *widget);
@@ -131,6 +141,22 @@ public:
      */
     QMenu *getContextMenuExtensions(ContextMenuType type);
 
+    /**
+     * @brief Run \p analysisTask while the file can be browsed, with its progress in the status bar
+     *
+     * The widgets are refreshed with the partial results while the analysis continues. Canceling
+     * it keeps the results so far.
+     * @param openingFile the task loads the file, which shows a dialog until it is loaded and
+     * finalizes the opening afterwards
+     */
+    void startAnalysis(AnalysisTask *analysisTask, bool openingFile);
+
+signals:
+    /// The project from openProject() is shown, while the rest of it may still be restored
+    void projectOpened();
+    /// The project from openProject() couldn't be opened, any error was already shown
+    void projectOpenFailed();
+
 public slots:
     void finalizeOpen();
 
@@ -156,6 +182,7 @@ private slots:
     void on_actionBaseFind_triggered();
     void on_actionAbout_triggered();
     void on_actionIssue_triggered();
+    void on_actionStalls_triggered();
     void documentationClicked();
     void addExtraGraph();
     void addExtraHexdump();
@@ -219,10 +246,13 @@ private:
     ut64 hexdumpTopOffset;
     ut64 hexdumpBottomOffset;
     QString filename;
+    /// The opened project is still being restored, saving it now would lose data
+    bool projectRestoring = false;
     std::unique_ptr<Ui::MainWindow> ui;
     Highlighter *highlighter;
     VisualNavbar *visualNavbar;
     Omnibar *omnibar;
+    DebugActions *debugActions = nullptr;
     ProgressIndicator *tasksProgressIndicator;
     QByteArray emptyState;
     IOModesController ioModesController;
@@ -268,15 +298,40 @@ private:
     CallGraphWidget *callGraphDock = nullptr;
     CallGraphWidget *globalCallGraphDock = nullptr;
     CutterDockWidget *heapDock = nullptr;
+    CutterDockWidget *traceDock = nullptr;
+    CutterDockWidget *coreLockDock = nullptr;
 
     QMenu *disassemblyContextMenuExtensions = nullptr;
     QMenu *addressableContextMenuExtensions = nullptr;
 
     QMap<QString, Cutter::CutterLayout> layouts;
 
+    struct LazyDock
+    {
+        std::function<CutterDockWidget *()> create;
+        /// Stands in for the dock's toggleViewAction() in the menus
+        QAction *action;
+        CutterDockWidget *dock;
+    };
+    /// Docks constructed on first use, by object name
+    QMap<QString, LazyDock> lazyDocks;
+
     void initUI();
     void initToolBar();
     void initDocks();
+    /**
+     * @brief Register a dock which is constructed once it is shown or part of a restored layout
+     * @param create constructs the dock, which must have \p objectName
+     * @return action for the menus, which shows the dock and creates it if necessary
+     */
+    QAction *addLazyDock(const QString &objectName, const QString &title,
+                         const std::function<CutterDockWidget *()> &create);
+    /**
+     * @brief Construct a lazy dock if it doesn't exist yet
+     * @param place put the dock where the last restored layout had it, or on the main area
+     * @return the dock, or null if \p objectName is not a lazy dock
+     */
+    CutterDockWidget *createLazyDock(const QString &objectName, bool place);
     void initBackForwardMenu();
     void displayInitialOptionsDialog(const InitialOptions &options = InitialOptions(),
                                      bool skipOptionsDialog = false);
@@ -298,6 +353,8 @@ private:
      */
     void dockOnMainArea(QDockWidget *widget);
     void enableDebugWidgetsMenu(bool enable);
+    /// Tell the user the project can't be saved yet if it is still being restored
+    bool refuseSaveWhileRestoring(bool *canceled);
     /**
      * @brief Fill menu with seek history entries.
      * @param menu
@@ -0,0 +1,380 @@
+#include "MemoryChangeTracker.h"
+#include "DebugSnapshot.h"
+
+#include <QFile>
+#include <QSet>
+#include <QVector>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#    include <unistd.h>
+#endif
+
+namespace {
+
+/// Limit of pagemap entries read when scanning the whole process
+constexpr quint64 MaxScanPages = 1 << 20;
+/// Bytes prefetched around the program counter and above the stack pointer
+constexpr RVA PrefetchCodeBefore = 0x100;
+constexpr RVA PrefetchCodeAfter = 0x400;
+constexpr RVA PrefetchStack = 0x1000;
+constexpr quint64 SoftDirtyBit = 1ULL << 55;
+
+RVA pageOf(RVA addr)
+{
+    return addr & ~(MemoryChangeTracker::PageSize - 1);
+}
+
+}
+
+void MemoryChangeTracker::newStop(RzCore *core, bool scanProcess, bool remote)
+{
+    QMutexLocker locker(&mutex);
+    stop++;
+    statistics = Statistics();
+    for (auto it = pages.begin(); it != pages.end();) {
+        if (it->lastUsedStop + 1 < stop) {
+            it = pages.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (remote) {
+        // What the disassembly and the stack views show first
+        RzReg *reg = DebugSnapshot::getReg(core);
+        RVA pc = rz_reg_get_value_by_role(reg, RZ_REG_NAME_PC);
+        RVA sp = rz_reg_get_value_by_role(reg, RZ_REG_NAME_SP);
+        addPages(pc - qMin(pc, PrefetchCodeBefore), pc + PrefetchCodeAfter);
+        addPages(sp, sp + PrefetchStack);
+        if (pages.size() > MaxRemotePages) {
+            // Every page is a round trip, those far from the code and the stack are read again
+            // only if a view asks for them
+            auto distance = [pc, sp](RVA addr) {
+                RVA toPc = addr > pc ? addr - pc : pc - addr;
+                RVA toSp = addr > sp ? addr - sp : sp - addr;
+                return qMin(toPc, toSp);
+            };
+            QVector<RVA> addrs;
+            addrs.reserve(pages.size());
+            for (auto it = pages.constBegin(); it != pages.constEnd(); ++it) {
+                addrs.append(it.key());
+            }
+            std::nth_element(addrs.begin(), addrs.begin() + MaxRemotePages, addrs.end(),
+                             [&distance](RVA a, RVA b) { return distance(a) < distance(b); });
+            for (auto it = addrs.constBegin() + MaxRemotePages; it != addrs.constEnd(); ++it) {
+                pages.remove(*it);
+            }
+        }
+    }
+
+    bool useSoftDirty = softDirty != SoftDirtyState::Unusable && canUseSoftDirty(core);
+    int pid = useSoftDirty ? core->dbg->pid : -1;
+    QSet<RVA> dirty;
+    bool haveDirty = false;
+    if (pid > 0) {
+        QList<Range> tracked;
+        for (auto it = pages.constBegin(); it != pages.constEnd(); ++it) {
+            if (!tracked.isEmpty() && tracked.last().second == it.key()) {
+                tracked.last().second += PageSize;
+            } else {
+                tracked.append({ it.key(), it.key() + PageSize });
+            }
+        }
+        QList<RVA> dirtyList;
+        haveDirty = softDirtyPages(pid, tracked, &dirtyList);
+        for (RVA addr : dirtyList) {
+            dirty.insert(addr);
+        }
+    }
+
+    QList<RVA> changed;
+    QSet<RVA> clean;
+    for (auto it = pages.begin(); it != pages.end(); ++it) {
+        Page &page = it.value();
+        page.previous = page.data;
+        page.modified = false;
+        if (haveDirty && !dirty.contains(it.key()) && !page.stale) {
+            if (softDirty == SoftDirtyState::Usable) {
+                continue;
+            }
+            clean.insert(it.key());
+        }
+        changed.append(it.key());
+    }
+    readPages(core, changed);
+    for (RVA addr : changed) {
+        Page &page = pages[addr];
+        page.modified = !page.previous.isEmpty() && page.data != page.previous;
+        if (page.modified && clean.contains(addr)) {
+            // A page changed without its soft-dirty bit, don't trust the bits anymore
+            softDirty = SoftDirtyState::Unusable;
+        }
+    }
+    if (haveDirty && !dirty.isEmpty() && softDirty == SoftDirtyState::Unknown) {
+        softDirty = SoftDirtyState::Usable;
+    }
+
+    processRanges.clear();
+    processScanned = false;
+    if (pid > 0 && scanProcess && softDirty == SoftDirtyState::Usable) {
+        QList<Range> writable;
+        RzList *maps = rz_debug_map_list(core->dbg, false);
+        RzListIter *it;
+        RzDebugMap *map;
+        CutterRzListForeach (maps, it, RzDebugMap, map) {
+            if (map->perm & RZ_PERM_W) {
+                writable.append({ map->addr, map->addr_end });
+            }
+        }
+        QList<RVA> dirtyList;
+        processScanned = softDirtyPages(pid, writable, &dirtyList);
+        if (processScanned) {
+            for (RVA addr : dirtyList) {
+                if (!processRanges.isEmpty() && processRanges.last().second == addr) {
+                    processRanges.last().second += PageSize;
+                } else {
+                    processRanges.append({ addr, addr + PageSize });
+                }
+            }
+        }
+    }
+    if (pid > 0) {
+        clearSoftDirty(pid);
+    }
+}
+
+void MemoryChangeTracker::clear()
+{
+    QMutexLocker locker(&mutex);
+    pages.clear();
+    processRanges.clear();
+    processScanned = false;
+    softDirty = SoftDirtyState::Unknown;
+}
+
+void MemoryChangeTracker::invalidate(RVA addr, RVA size)
+{
+    QMutexLocker locker(&mutex);
+    RVA end = addr + qMax<RVA>(size, 1);
+    for (auto it = pages.lowerBound(pageOf(addr)); it != pages.end() && it.key() < end; ++it) {
+        it->stale = true;
+    }
+}
+
+void MemoryChangeTracker::invalidateAll()
+{
+    QMutexLocker locker(&mutex);
+    for (Page &page : pages) {
+        page.stale = true;
+    }
+}
+
+QByteArray MemoryChangeTracker::read(RzCore *core, RVA addr, int len)
+{
+    QByteArray result;
+    if (len <= 0) {
+        return result;
+    }
+    result.resize(len);
+
+    QMutexLocker locker(&mutex);
+    RVA first = pageOf(addr);
+    RVA end = addr + len;
+    // The pages which are missing are read together
+    QList<RVA> missing;
+    for (RVA pageAddr = first; pageAddr < end && pageAddr >= first; pageAddr += PageSize) {
+        auto it = pages.find(pageAddr);
+        if (it == pages.end() && pages.size() < MaxPages) {
+            it = pages.insert(pageAddr, Page());
+            it->stale = true;
+        }
+        if (it != pages.end() && it->stale) {
+            missing.append(pageAddr);
+        }
+    }
+    readPages(core, missing);
+
+    char *out = result.data();
+    for (RVA pageAddr = first; pageAddr < end && pageAddr >= first; pageAddr += PageSize) {
+        RVA begin = qMax(addr, pageAddr);
+        int count = static_cast<int>(qMin(end, pageAddr + PageSize) - begin);
+        auto it = pages.find(pageAddr);
+        if (it == pages.end()) {
+            // Too many pages tracked already
+            if (!readMemory(core, begin, out, count)) {
+                memset(out, 0xff, count);
+            }
+        } else {
+            if (missing.contains(pageAddr)) {
+                it->modified = !it->previous.isEmpty() && it->data != it->previous;
+            }
+            it->lastUsedStop = stop;
+            memcpy(out, it->data.constData() + (begin - pageAddr), count);
+        }
+        out += count;
+    }
+    return result;
+}
+
+bool MemoryChangeTracker::isModified(RVA addr, RVA size) const
+{
+    QMutexLocker locker(&mutex);
+    RVA end = addr + qMax<RVA>(size, 1);
+    for (auto it = pages.lowerBound(pageOf(addr)); it != pages.end() && it.key() < end; ++it) {
+        const Page &page = it.value();
+        if (!page.modified) {
+            continue;
+        }
+        RVA begin = qMax(addr, it.key());
+        int offset = static_cast<int>(begin - it.key());
+        int count = static_cast<int>(qMin(end, it.key() + PageSize) - begin);
+        if (memcmp(page.data.constData() + offset, page.previous.constData() + offset, count)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QList<MemoryChangeTracker::Range> MemoryChangeTracker::getModifiedRanges() const
+{
+    QMutexLocker locker(&mutex);
+    QList<Range> modified = processRanges;
+    for (auto it = pages.constBegin(); it != pages.constEnd(); ++it) {
+        if (it->modified) {
+            modified.append({ it.key(), it.key() + PageSize });
+        }
+    }
+    std::sort(modified.begin(), modified.end());
+
+    QList<Range> ranges;
+    for (const Range &range : modified) {
+        if (!ranges.isEmpty() && ranges.last().second >= range.first) {
+            ranges.last().second = qMax(ranges.last().second, range.second);
+        } else {
+            ranges.append(range);
+        }
+    }
+    return ranges;
+}
+
+bool MemoryChangeTracker::isProcessScanned() const
+{
+    QMutexLocker locker(&mutex);
+    return processScanned;
+}
+
+MemoryChangeTracker::Statistics MemoryChangeTracker::getStatistics() const
+{
+    QMutexLocker locker(&mutex);
+    return statistics;
+}
+
+void MemoryChangeTracker::addPages(RVA begin, RVA end)
+{
+    for (RVA addr = pageOf(begin); addr < end && pages.size() < MaxPages; addr += PageSize) {
+        auto it = pages.find(addr);
+        if (it == pages.end()) {
+            it = pages.insert(addr, Page());
+            it->stale = true;
+        }
+        it->lastUsedStop = stop;
+    }
+}
+
+void MemoryChangeTracker::readPage(RzCore *core, RVA addr, Page *page)
+{
+    page->data.resize(PageSize);
+    if (!readMemory(core, addr, page->data.data(), PageSize)) {
+        page->data.fill(0xff);
+    }
+    page->stale = false;
+}
+
+void MemoryChangeTracker::readPages(RzCore *core, const QList<RVA> &addrs)
+{
+    QByteArray run;
+    for (int i = 0; i < addrs.size();) {
+        int count = 1;
+        while (i + count < addrs.size() && count < MaxBatchPages
+               && addrs.at(i + count) == addrs.at(i) + count * PageSize) {
+            count++;
+        }
+        // A run fails as a whole if any of its pages is unmapped, read those one by one
+        run.resize(static_cast<int>(count * PageSize));
+        bool batched = count > 1 && readMemory(core, addrs.at(i), run.data(), run.size());
+        for (int j = 0; j < count; j++) {
+            Page &page = pages[addrs.at(i + j)];
+            if (batched) {
+                page.data = run.mid(static_cast<int>(j * PageSize), PageSize);
+                page.stale = false;
+            } else {
+                readPage(core, addrs.at(i + j), &page);
+            }
+        }
+        i += count;
+    }
+}
+
+bool MemoryChangeTracker::readMemory(RzCore *core, RVA addr, char *buf, int len)
+{
+    statistics.reads++;
+    statistics.bytes += len;
+    return rz_io_read_at(core->io, addr, reinterpret_cast<ut8 *>(buf), len);
+}
+
+bool MemoryChangeTracker::canUseSoftDirty(RzCore *core)
+{
+#ifdef Q_OS_LINUX
+    if (!rz_core_is_debug(core) || !core->dbg || core->dbg->pid <= 0
+        || static_cast<RVA>(sysconf(_SC_PAGESIZE)) != PageSize) {
+        return false;
+    }
+    // Other backends may debug a process on another machine
+    return QString(rz_config_get(core->config, "dbg.backend")) == QLatin1String("native");
+#else
+    Q_UNUSED(core)
+    return false;
+#endif
+}
+
+bool MemoryChangeTracker::softDirtyPages(int pid, const QList<Range> &ranges, QList<RVA> *dirty)
+{
+    QFile pagemap(QStringLiteral("/proc/%1/pagemap").arg(pid));
+    if (!pagemap.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        return false;
+    }
+    quint64 scanned = 0;
+    QVector<quint64> entries;
+    for (const Range &range : ranges) {
+        for (RVA addr = pageOf(range.first); addr < range.second;) {
+            if (scanned >= MaxScanPages) {
+                return false;
+            }
+            quint64 count = qMin<quint64>((range.second - addr + PageSize - 1) / PageSize, 4096);
+            count = qMin(count, MaxScanPages - scanned);
+            entries.resize(static_cast<int>(count));
+            qint64 bytes = static_cast<qint64>(count * sizeof(quint64));
+            if (!pagemap.seek(static_cast<qint64>(addr / PageSize * sizeof(quint64)))
+                || pagemap.read(reinterpret_cast<char *>(entries.data()), bytes) != bytes) {
+                return false;
+            }
+            for (quint64 entry : entries) {
+                if (entry & SoftDirtyBit) {
+                    dirty->append(addr);
+                }
+                addr += PageSize;
+            }
+            scanned += count;
+        }
+    }
+    return true;
+}
+
+bool MemoryChangeTracker::clearSoftDirty(int pid)
+{
+    QFile clearRefs(QStringLiteral("/proc/%1/clear_refs").arg(pid));
+    // 4 only clears the soft-dirty bits
+    return clearRefs.open(QIODevice::WriteOnly) && clearRefs.write("4") == 1;
+}
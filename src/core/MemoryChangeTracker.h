@@ -0,0 +1,126 @@
+#ifndef CUTTER_MEMORYCHANGETRACKER_H
+#define CUTTER_MEMORYCHANGETRACKER_H
+
+#include "CutterCommon.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QPair>
+
+/**
+ * @brief Debuggee memory shown by the views, kept per page together with its content at the
+ * previous debugger stop
+ *
+ * Pages read at a stop are read again by the debug task right after the next one, so views get
+ * their data from here and can tell which bytes changed in between without reading anything
+ * twice. Pages which were not shown at the previous stop are dropped.
+ *
+ * When a local process is debugged with the native backend on Linux, the soft-dirty bits of
+ * /proc/pid/pagemap tell which pages were written at all, so unchanged pages are neither read
+ * again nor compared. Everywhere else the pages are read and compared with memcmp.
+ */
+class CUTTER_EXPORT MemoryChangeTracker
+{
+public:
+    static constexpr RVA PageSize = 0x1000;
+    /// Pages kept at most, reads beyond that go to the debuggee directly
+    static constexpr int MaxPages = 4096;
+    /// Pages read again at a stop of a remote debugger at most, the others are dropped
+    static constexpr int MaxRemotePages = 256;
+
+    /// Contiguous pages read with a single request at most
+    static constexpr int MaxBatchPages = 64;
+
+    /// Memory range as begin and end address
+    using Range = QPair<RVA, RVA>;
+
+    struct Statistics
+    {
+        /// Read requests sent to the debugger
+        quint64 reads = 0;
+        quint64 bytes = 0;
+    };
+
+    /**
+     * @brief Start a new stop, must be called by the debug task
+     *
+     * Contiguous pages are read again with one request, which matters most for remote debugging
+     * where each request is a round trip.
+     * @param scanProcess also find the written pages of the whole process if soft-dirty bits are
+     * available, see getModifiedRanges()
+     * @param remote the debugger is remote, so also read the pages around the program counter
+     * and the stack pointer, and keep those nearest to them if there are more than
+     * MaxRemotePages
+     */
+    void newStop(RzCore *core, bool scanProcess, bool remote);
+    void clear();
+    /// Read the pages again on the next access, e.g. after they were written by the user
+    void invalidate(RVA addr, RVA size);
+    void invalidateAll();
+
+    /**
+     * @brief Read \p len bytes at \p addr through the tracked pages, requires the core lock
+     */
+    QByteArray read(RzCore *core, RVA addr, int len);
+    /**
+     * @brief Check if any byte of [addr, addr + size) differs from the previous stop
+     *
+     * Only pages read through read() are known, anything else is reported as unmodified.
+     */
+    bool isModified(RVA addr, RVA size) const;
+    /**
+     * @brief Pages modified since the previous stop, merged into ranges
+     */
+    QList<Range> getModifiedRanges() const;
+    /**
+     * @brief Whether getModifiedRanges() contains all pages of the process written since the
+     * previous stop, instead of just the tracked ones
+     */
+    bool isProcessScanned() const;
+    /**
+     * @brief Reads of the debuggee memory since the start of the current stop
+     */
+    Statistics getStatistics() const;
+
+private:
+    struct Page
+    {
+        QByteArray data;
+        /// Content at the previous stop, empty if the page was not read then
+        QByteArray previous;
+        quint64 lastUsedStop = 0;
+        bool stale = false;
+        bool modified = false;
+    };
+
+    enum class SoftDirtyState {
+        /// No page was seen dirty yet, which is also the case if the kernel lacks support
+        Unknown,
+        Usable,
+        Unusable
+    };
+
+    void addPages(RVA begin, RVA end);
+    void readPage(RzCore *core, RVA addr, Page *page);
+    /// Read the sorted pages \p addrs, contiguous ones with a single request
+    void readPages(RzCore *core, const QList<RVA> &addrs);
+    bool readMemory(RzCore *core, RVA addr, char *buf, int len);
+    static bool canUseSoftDirty(RzCore *core);
+    /// Append the soft-dirty pages of \p ranges in process \p pid to \p dirty, fails if they
+    /// are too large to be scanned completely
+    static bool softDirtyPages(int pid, const QList<Range> &ranges, QList<RVA> *dirty);
+    static bool clearSoftDirty(int pid);
+
+    mutable QMutex mutex;
+    QMap<RVA, Page> pages;
+    /// Written pages of the whole process found by the last scan
+    QList<Range> processRanges;
+    bool processScanned = false;
+    quint64 stop = 1;
+    Statistics statistics;
+    SoftDirtyState softDirty = SoftDirtyState::Unknown;
+};
+
+#endif // CUTTER_MEMORYCHANGETRACKER_H
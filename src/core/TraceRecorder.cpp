@@ -0,0 +1,307 @@
+#include "TraceRecorder.h"
+#include "DebugSnapshot.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+namespace {
+
+using MemReadHook = decltype(RzAnalysisEsilCallbacks::hook_mem_read);
+using MemWriteHook = decltype(RzAnalysisEsilCallbacks::hook_mem_write);
+
+// The ESIL hooks have no user pointer of their own, the recording runs on the debug task thread
+thread_local TraceBuffer *recordingBuffer = nullptr;
+thread_local const TraceOptions *recordingOptions = nullptr;
+thread_local bool accessHit = false;
+thread_local MemReadHook previousMemReadHook = nullptr;
+thread_local MemWriteHook previousMemWriteHook = nullptr;
+
+void checkAccess(ut64 addr, int len)
+{
+    if (recordingOptions && recordingOptions->accessBegin != RVA_INVALID
+        && addr < recordingOptions->accessEnd && addr + len > recordingOptions->accessBegin) {
+        accessHit = true;
+    }
+}
+
+bool recordMemRead(RzAnalysisEsil *esil, ut64 addr, ut8 *buf, int len)
+{
+    checkAccess(addr, len);
+    return previousMemReadHook ? previousMemReadHook(esil, addr, buf, len) : false;
+}
+
+bool recordMemWrite(RzAnalysisEsil *esil, ut64 addr, const ut8 *buf, int len)
+{
+    checkAccess(addr, len);
+    if (recordingBuffer) {
+        recordingBuffer->addMemoryWrite(addr, buf, len);
+    }
+    return previousMemWriteHook ? previousMemWriteHook(esil, addr, buf, len) : false;
+}
+
+/**
+ * @brief General purpose registers which fit into an ut64, in a stable order
+ */
+QVector<RzRegItem *> traceRegisters(RzReg *reg)
+{
+    QVector<RzRegItem *> result;
+    const RzList *list = rz_reg_get_list(reg, RZ_REG_TYPE_GPR);
+    RzListIter *it;
+    RzRegItem *item;
+    CutterRzListForeach (list, it, RzRegItem, item) {
+        if (item->size <= 64 && result.size() < 0xffff) {
+            result.append(item);
+        }
+    }
+    return result;
+}
+
+}
+
+TraceBuffer::TraceBuffer(const QStringList &registerNames, const QVector<ut64> &registerValues,
+                         quint64 capacity)
+    : registerNames(registerNames),
+      currentRegisters(registerValues),
+      maxBlocks(qMax<quint64>(1, (capacity + BlockSteps - 1) / BlockSteps))
+{
+}
+
+void TraceBuffer::beginStep(RVA pc)
+{
+    if (blocks.isEmpty() || blocks.last().steps.size() >= BlockSteps) {
+        if (static_cast<quint64>(blocks.size()) >= maxBlocks) {
+            firstBlockStep += blocks.first().steps.size();
+            blocks.removeFirst();
+        }
+        Block block;
+        block.initialRegisters = currentRegisters;
+        block.steps.reserve(BlockSteps);
+        blocks.append(block);
+    }
+    Block &block = blocks.last();
+    block.steps.append({ pc, static_cast<quint32>(block.changedRegisters.size()),
+                         static_cast<quint32>(block.writes.size()) });
+    stepCount++;
+}
+
+void TraceBuffer::setRegister(int reg, ut64 value)
+{
+    if (currentRegisters[reg] == value || blocks.isEmpty()) {
+        return;
+    }
+    currentRegisters[reg] = value;
+    Block &block = blocks.last();
+    block.changedRegisters.append(static_cast<quint16>(reg));
+    block.changedValues.append(value);
+}
+
+void TraceBuffer::addMemoryWrite(RVA address, const ut8 *data, int size)
+{
+    if (blocks.isEmpty() || size <= 0) {
+        return;
+    }
+    Block &block = blocks.last();
+    block.writes.append({ address, static_cast<quint32>(block.writeData.size()),
+                          static_cast<quint32>(size) });
+    block.writeData.append(reinterpret_cast<const char *>(data), size);
+}
+
+quint64 TraceBuffer::firstStep() const
+{
+    return firstBlockStep;
+}
+
+const TraceBuffer::Block &TraceBuffer::blockOf(quint64 index, int *stepInBlock) const
+{
+    // All blocks but the last one are full
+    quint64 offset = index - firstBlockStep;
+    *stepInBlock = static_cast<int>(offset % BlockSteps);
+    return blocks.at(static_cast<int>(offset / BlockSteps));
+}
+
+TraceBuffer::StepInfo TraceBuffer::getStep(quint64 index) const
+{
+    StepInfo info;
+    info.index = index;
+    info.pc = RVA_INVALID;
+    if (!contains(index)) {
+        return info;
+    }
+
+    int i;
+    const Block &block = blockOf(index, &i);
+    const StepRecord &step = block.steps.at(i);
+    bool last = i + 1 == block.steps.size();
+    int registersEnd = last ? block.changedRegisters.size() : block.steps.at(i + 1).firstRegister;
+    int writesEnd = last ? block.writes.size() : block.steps.at(i + 1).firstWrite;
+
+    info.pc = step.pc;
+    for (int r = step.firstRegister; r < registersEnd; r++) {
+        info.registers.append({ block.changedRegisters.at(r), block.changedValues.at(r) });
+    }
+    for (int w = step.firstWrite; w < writesEnd; w++) {
+        const WriteRecord &write = block.writes.at(w);
+        info.writes.append({ write.address, block.writeData.mid(write.dataOffset, write.size) });
+    }
+    return info;
+}
+
+QVector<ut64> TraceBuffer::getRegistersBefore(quint64 index) const
+{
+    if (!contains(index)) {
+        return index == endStep() ? currentRegisters : QVector<ut64>();
+    }
+    int i;
+    const Block &block = blockOf(index, &i);
+    QVector<ut64> registers = block.initialRegisters;
+    applyChanges(block, i, &registers);
+    return registers;
+}
+
+void TraceBuffer::applyChanges(const Block &block, int steps, QVector<ut64> *registers)
+{
+    int end = steps < block.steps.size() ? block.steps.at(steps).firstRegister
+                                         : block.changedRegisters.size();
+    for (int r = 0; r < end; r++) {
+        (*registers)[block.changedRegisters.at(r)] = block.changedValues.at(r);
+    }
+}
+
+TraceBuffer *TraceRecorder::createBuffer(RzCore *core, quint64 capacity)
+{
+    RzReg *reg = DebugSnapshot::getReg(core);
+    QStringList names;
+    QVector<ut64> values;
+    for (RzRegItem *item : traceRegisters(reg)) {
+        names.append(item->name);
+        values.append(rz_reg_get_value(reg, item));
+    }
+    return new TraceBuffer(names, values, capacity);
+}
+
+TraceRecorder::Result TraceRecorder::record(RzCore *core, const TraceOptions &options,
+                                            TraceBuffer *buffer, const ProgressCallback &progress)
+{
+    Result result;
+    bool emulating = !rz_core_is_debug(core);
+    RzAnalysisEsil *esil = core->analysis->esil;
+    if (emulating && !esil) {
+        result.reason = StopReason::StepFailed;
+        return result;
+    }
+
+    RzReg *reg = DebugSnapshot::getReg(core);
+    const QVector<RzRegItem *> registers = buffer ? traceRegisters(reg) : QVector<RzRegItem *>();
+    QByteArray condition = options.condition.toUtf8();
+    bool breakOnInvalid = false;
+
+    if (emulating) {
+        recordingBuffer = buffer;
+        recordingOptions = &options;
+        accessHit = false;
+        previousMemReadHook = esil->cb.hook_mem_read;
+        previousMemWriteHook = esil->cb.hook_mem_write;
+        esil->cb.hook_mem_read = recordMemRead;
+        esil->cb.hook_mem_write = recordMemWrite;
+        breakOnInvalid = rz_config_get_b(core->config, "esil.breakoninvalid");
+        rz_config_set_b(core->config, "esil.breakoninvalid", options.stopOnInvalid);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 lastProgress = 0;
+    RVA pc = rz_reg_get_value_by_role(reg, RZ_REG_NAME_PC);
+    while (true) {
+        if (result.steps >= options.maxSteps) {
+            result.reason = StopReason::StepLimit;
+            break;
+        }
+        // Checking the clock for every instruction would cost more than the check itself
+        if ((result.steps & 0xfff) == 0) {
+            if (rz_cons_is_breaked()) {
+                result.reason = StopReason::Interrupted;
+                break;
+            }
+            qint64 now = timer.elapsed();
+            if (progress && now - lastProgress >= ProgressInterval) {
+                lastProgress = now;
+                progress(result.steps, pc);
+            }
+        }
+
+        if (buffer) {
+            buffer->beginStep(pc);
+        }
+        bool stepped;
+        if (emulating) {
+            stepped = rz_core_esil_step(core, UT64_MAX, NULL, NULL, false);
+        } else {
+            stepped = rz_core_debug_step_one(core, 1)
+                    && DebugSnapshot::syncRegisters(core, RZ_REG_TYPE_GPR, false);
+        }
+        result.steps++;
+        for (int i = 0; i < registers.size(); i++) {
+            buffer->setRegister(i, rz_reg_get_value(reg, registers.at(i)));
+        }
+        pc = rz_reg_get_value_by_role(reg, RZ_REG_NAME_PC);
+
+        if (!stepped) {
+            result.reason = StopReason::StepFailed;
+            break;
+        }
+        if (pc == options.untilAddress) {
+            result.reason = StopReason::Address;
+            break;
+        }
+        if (emulating) {
+            if (accessHit) {
+                result.reason = StopReason::MemoryAccess;
+                break;
+            }
+            if (!condition.isEmpty()
+                && rz_analysis_esil_condition(esil, condition.constData()) > 0) {
+                result.reason = StopReason::Condition;
+                break;
+            }
+        } else if (rz_debug_is_dead(core->dbg)) {
+            result.reason = StopReason::ProcessExited;
+            break;
+        }
+    }
+
+    if (emulating) {
+        rz_config_set_b(core->config, "esil.breakoninvalid", breakOnInvalid);
+        esil->cb.hook_mem_read = previousMemReadHook;
+        esil->cb.hook_mem_write = previousMemWriteHook;
+        previousMemReadHook = nullptr;
+        previousMemWriteHook = nullptr;
+        recordingOptions = nullptr;
+        recordingBuffer = nullptr;
+    }
+    rz_core_reg_update_flags(core);
+    if (progress) {
+        progress(result.steps, pc);
+    }
+    return result;
+}
+
+QString TraceRecorder::stopReasonDescription(StopReason reason)
+{
+    switch (reason) {
+    case StopReason::StepLimit:
+        return QCoreApplication::translate("TraceRecorder", "step limit reached");
+    case StopReason::Address:
+        return QCoreApplication::translate("TraceRecorder", "address reached");
+    case StopReason::Condition:
+        return QCoreApplication::translate("TraceRecorder", "condition met");
+    case StopReason::MemoryAccess:
+        return QCoreApplication::translate("TraceRecorder", "memory accessed");
+    case StopReason::StepFailed:
+        return QCoreApplication::translate("TraceRecorder", "instruction could not be executed");
+    case StopReason::ProcessExited:
+        return QCoreApplication::translate("TraceRecorder", "process exited");
+    case StopReason::Interrupted:
+        return QCoreApplication::translate("TraceRecorder", "interrupted");
+    }
+    return QString();
+}
@@ -0,0 +1,169 @@
+#ifndef CUTTER_TRACERECORDER_H
+#define CUTTER_TRACERECORDER_H
+
+#include "CutterCommon.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * @brief Options of a run, see CutterCore::recordTrace() and CutterCore::continueEmulation()
+ */
+struct TraceOptions
+{
+    /// Maximum number of instructions to execute
+    quint64 maxSteps = 1000000;
+    /// Stop once the program counter reaches this address
+    RVA untilAddress = RVA_INVALID;
+    /// ESIL expression checked after every step, only used while emulating
+    QString condition;
+    /// Stop after an instruction accessing memory in [accessBegin, accessEnd), only used while
+    /// emulating
+    RVA accessBegin = RVA_INVALID;
+    RVA accessEnd = RVA_INVALID;
+    /// Stop at instructions which can't be emulated instead of skipping them
+    bool stopOnInvalid = true;
+    /// Number of most recent steps kept in the buffer
+    quint64 capacity = 4 * 1024 * 1024;
+};
+
+/**
+ * @brief Ring buffer of executed instructions with the registers and memory they changed
+ *
+ * Steps are stored in blocks of BlockSteps with their register changes and memory writes packed
+ * into flat arrays. When the capacity is exceeded the oldest block is dropped. Each block starts
+ * with the full register values, so the register state at any kept step can be rebuilt from
+ * at most one block.
+ *
+ * The buffer is filled by the debug task and must only be read once the recording finished.
+ */
+class CUTTER_EXPORT TraceBuffer
+{
+public:
+    static constexpr int BlockSteps = 1 << 16;
+
+    struct MemoryWrite
+    {
+        RVA address;
+        QByteArray data;
+    };
+
+    struct StepInfo
+    {
+        quint64 index;
+        RVA pc;
+        /// Registers written by the instruction, as register index and new value
+        QList<QPair<int, ut64>> registers;
+        QList<MemoryWrite> writes;
+    };
+
+    TraceBuffer(const QStringList &registerNames, const QVector<ut64> &registerValues,
+                quint64 capacity);
+
+    void beginStep(RVA pc);
+    /// Record the value of register \p reg after the current step if it changed
+    void setRegister(int reg, ut64 value);
+    void addMemoryWrite(RVA address, const ut8 *data, int size);
+
+    const QStringList &getRegisterNames() const { return registerNames; }
+    /// Index of the oldest step still in the buffer
+    quint64 firstStep() const;
+    /// Index after the most recent step, i.e. the number of steps ever recorded
+    quint64 endStep() const { return stepCount; }
+    quint64 size() const { return endStep() - firstStep(); }
+    bool contains(quint64 index) const { return index >= firstStep() && index < endStep(); }
+
+    StepInfo getStep(quint64 index) const;
+    /// Register values right before step \p index was executed
+    QVector<ut64> getRegistersBefore(quint64 index) const;
+
+private:
+    struct StepRecord
+    {
+        RVA pc;
+        quint32 firstRegister;
+        quint32 firstWrite;
+    };
+
+    struct WriteRecord
+    {
+        RVA address;
+        quint32 dataOffset;
+        quint32 size;
+    };
+
+    struct Block
+    {
+        QVector<ut64> initialRegisters;
+        QVector<StepRecord> steps;
+        QVector<quint16> changedRegisters;
+        QVector<ut64> changedValues;
+        QVector<WriteRecord> writes;
+        QByteArray writeData;
+    };
+
+    const Block &blockOf(quint64 index, int *stepInBlock) const;
+    static void applyChanges(const Block &block, int steps, QVector<ut64> *registers);
+
+    QStringList registerNames;
+    QVector<ut64> currentRegisters;
+    quint64 maxBlocks;
+    QList<Block> blocks;
+    /// Index of the first step of blocks.first()
+    quint64 firstBlockStep = 0;
+    quint64 stepCount = 0;
+};
+
+/**
+ * @brief Single-steps the debuggee or the emulation without any UI refresh in between
+ */
+class CUTTER_EXPORT TraceRecorder
+{
+public:
+    enum class StopReason {
+        StepLimit,
+        Address,
+        Condition,
+        MemoryAccess,
+        /// The instruction could not be stepped, e.g. an invalid one while emulating
+        StepFailed,
+        ProcessExited,
+        Interrupted
+    };
+
+    struct Result
+    {
+        quint64 steps = 0;
+        StopReason reason = StopReason::StepLimit;
+    };
+
+    /// Called with the number of executed steps and the current program counter
+    using ProgressCallback = std::function<void(quint64, RVA)>;
+
+    /// Interval between two progress callbacks, in milliseconds
+    static constexpr int ProgressInterval = 250;
+
+    /**
+     * @brief Create a buffer for the general purpose registers of the debuggee or emulation
+     */
+    static TraceBuffer *createBuffer(RzCore *core, quint64 capacity);
+
+    /**
+     * @brief Execute instructions until one of \p options is met or the task is broken
+     *
+     * Must be called inside the debug task. Memory writes are only recorded while emulating.
+     * @param buffer receives the executed steps, may be null to run without recording
+     */
+    static Result record(RzCore *core, const TraceOptions &options, TraceBuffer *buffer,
+                         const ProgressCallback &progress);
+
+    static QString stopReasonDescription(StopReason reason);
+};
+
+#endif // CUTTER_TRACERECORDER_H
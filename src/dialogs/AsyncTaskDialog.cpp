@@ -56,8 +56,8 @@ void AsyncTaskDialog::updateProgressTimer()
 void AsyncTaskDialog::closeEvent(QCloseEvent *event)
 {
     if (interruptOnClose) {
+        // Not waited for, the owner of the task handles its finished signal
         task->interrupt();
-        task->wait();
     }
 
     QWidget::closeEvent(event);
@@ -5,28 +5,18 @@
 
 #include "common/Helpers.h"
 
-#include <QScrollBar>
 
 // ------------
 // ProcessModel
 // ------------
-ProcessModel::ProcessModel(QObject *parent) : QAbstractListModel(parent)
+ProcessModel::ProcessModel(QObject *parent) : ProcessListModel(parent)
 {
     updateData();
 }
 
 void ProcessModel::updateData()
 {
-    beginResetModel();
-
-    processes = Core()->getAllProcesses();
-
-    endResetModel();
-}
-
-int ProcessModel::rowCount(const QModelIndex &) const
-{
-    return processes.count();
+    setProcesses(Core()->getAllProcesses());
 }
 
 int ProcessModel::columnCount(const QModelIndex &) const
@@ -34,29 +24,17 @@ int ProcessModel::columnCount(const QModelIndex &) const
     return ProcessModel::ColumnCount;
 }
 
-QVariant ProcessModel::data(const QModelIndex &index, int role) const
+QVariant ProcessModel::displayData(const ProcessDescription &proc, int column) const
 {
-    if (index.row() >= processes.count())
-        return QVariant();
-
-    const ProcessDescription &proc = processes.at(index.row());
-
-    switch (role) {
-    case Qt::DisplayRole:
-        switch (index.column()) {
-        case PidColumn:
-            return proc.pid;
-        case UidColumn:
-            return proc.uid;
-        case StatusColumn:
-            return proc.status;
-        case PathColumn:
-            return proc.path;
-        default:
-            return QVariant();
-        }
-    case ProcDescriptionRole:
-        return QVariant::fromValue(proc);
+    switch (column) {
+    case PidColumn:
+        return proc.pid;
+    case UidColumn:
+        return proc.uid;
+    case StatusColumn:
+        return proc.status;
+    case PathColumn:
+        return proc.path;
     default:
         return QVariant();
     }
@@ -125,7 +103,7 @@ bool ProcessBeingAnalysedProxyModel::filterAcceptsRow(int row, const QModelIndex
 {
     QModelIndex index = sourceModel()->index(row, 0, parent);
     ProcessDescription item =
-            index.data(ProcessModel::ProcDescriptionRole).value<ProcessDescription>();
+            index.data(ProcessListModel::ProcDescriptionRole).value<ProcessDescription>();
 
     QString procFilename = processPathToFilename(item.path);
     return procFilename == processBeingAnalysedFilename;
@@ -135,9 +113,9 @@ bool ProcessBeingAnalysedProxyModel::lessThan(const QModelIndex &left,
                                               const QModelIndex &right) const
 {
     ProcessDescription leftProc =
-            left.data(ProcessModel::ProcDescriptionRole).value<ProcessDescription>();
+            left.data(ProcessListModel::ProcDescriptionRole).value<ProcessDescription>();
     ProcessDescription rightProc =
-            right.data(ProcessModel::ProcDescriptionRole).value<ProcessDescription>();
+            right.data(ProcessListModel::ProcDescriptionRole).value<ProcessDescription>();
 
     return ProcessModel::lessThan(leftProc, rightProc, left.column());
 }
@@ -155,16 +133,16 @@ bool ProcessProxyModel::filterAcceptsRow(int row, const QModelIndex &parent) con
 {
     QModelIndex index = sourceModel()->index(row, 0, parent);
     ProcessDescription item =
-            index.data(ProcessModel::ProcDescriptionRole).value<ProcessDescription>();
+            index.data(ProcessListModel::ProcDescriptionRole).value<ProcessDescription>();
     return qhelpers::filterStringContains(item.path, this);
 }
 
 bool ProcessProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
     ProcessDescription leftProc =
-            left.data(ProcessModel::ProcDescriptionRole).value<ProcessDescription>();
+            left.data(ProcessListModel::ProcDescriptionRole).value<ProcessDescription>();
     ProcessDescription rightProc =
-            right.data(ProcessModel::ProcDescriptionRole).value<ProcessDescription>();
+            right.data(ProcessListModel::ProcDescriptionRole).value<ProcessDescription>();
 
     return ProcessModel::lessThan(leftProc, rightProc, left.column());
 }
@@ -200,10 +178,9 @@ AttachProcDialog::AttachProcDialog(QWidget *parent) : QDialog(parent), ui(new Ui
     connect(ui->filterLineEdit, &QLineEdit::textChanged, processProxyModel,
             &QSortFilterProxyModel::setFilterWildcard);
 
-    // Update the processes every 'updateIntervalMs' seconds
+    // Update the processes every 'updateIntervalMs' seconds while shown
     timer = new QTimer(this);
     connect(timer, &QTimer::timeout, this, &AttachProcDialog::updateModelData);
-    timer->start(updateIntervalMs);
 }
 
 AttachProcDialog::~AttachProcDialog()
@@ -220,56 +197,9 @@ void AttachProcDialog::updateModelData()
     auto allView = ui->allProcView;
     auto smallView = ui->procBeingAnalyzedView;
 
-    // Save the old selection and scroll position so that we can update and
-    // model and then restore it.
-    bool allViewHadSelection = allView->selectionModel()->hasSelection();
-    bool smallViewHadSelection = smallView->selectionModel()->hasSelection();
-    int allViewPrevScrollPos = 0;
-    int smallViewPrevScrollPos = 0;
-    int allViewPrevPID = 0;
-    int smallViewPrevPID = 0;
-
-    if (allViewHadSelection) {
-        allViewPrevScrollPos = allView->verticalScrollBar()->value();
-        allViewPrevPID = allView->selectionModel()
-                                 ->currentIndex()
-                                 .data(ProcessModel::ProcDescriptionRole)
-                                 .value<ProcessDescription>()
-                                 .pid;
-    }
-    if (smallViewHadSelection) {
-        smallViewPrevScrollPos = smallView->verticalScrollBar()->value();
-        smallViewPrevPID = smallView->selectionModel()
-                                   ->currentIndex()
-                                   .data(ProcessModel::ProcDescriptionRole)
-                                   .value<ProcessDescription>()
-                                   .pid;
-    }
-
-    // Let the model update
+    // Only changed rows are updated, the views keep their selection and scroll position
     processModel->updateData();
 
-    // Restore the selection and scroll position
-    if (allViewHadSelection) {
-        QModelIndexList idx =
-                allView->model()->match(allView->model()->index(0, 0), Qt::DisplayRole,
-                                        QVariant::fromValue(allViewPrevPID));
-        if (!idx.isEmpty()) {
-            allView->setCurrentIndex(idx.first());
-            allView->verticalScrollBar()->setValue(allViewPrevScrollPos);
-        }
-    }
-    if (smallViewHadSelection) {
-        QModelIndexList idx =
-                smallView->model()->match(smallView->model()->index(0, 0), Qt::DisplayRole,
-                                          QVariant::fromValue(smallViewPrevPID));
-
-        if (!idx.isEmpty()) {
-            smallView->setCurrentIndex(idx.first());
-            smallView->verticalScrollBar()->setValue(smallViewPrevScrollPos);
-        }
-    }
-
     // Init selection if nothing was ever selected yet, and a new process with the same name
     // as the one being analysed was launched.
     if (!allView->selectionModel()->hasSelection()
@@ -278,6 +208,21 @@ void AttachProcDialog::updateModelData()
     }
 }
 
+void AttachProcDialog::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+    // Listing all processes is only worth it while they can be seen
+    if (!timer->isActive()) {
+        timer->start(updateIntervalMs);
+    }
+}
+
+void AttachProcDialog::hideEvent(QHideEvent *event)
+{
+    timer->stop();
+    QDialog::hideEvent(event);
+}
+
 void AttachProcDialog::on_buttonBox_accepted() {}
 
 void AttachProcDialog::on_buttonBox_rejected()
@@ -310,14 +255,14 @@ int AttachProcDialog::getPID()
     if (wasAllProcViewLastPressed && ui->allProcView->selectionModel()->hasSelection()) {
         pid = ui->allProcView->selectionModel()
                       ->currentIndex()
-                      .data(ProcessModel::ProcDescriptionRole)
+                      .data(ProcessListModel::ProcDescriptionRole)
                       .value<ProcessDescription>()
                       .pid;
     } else if (!wasAllProcViewLastPressed
                && ui->procBeingAnalyzedView->selectionModel()->hasSelection()) {
         pid = ui->procBeingAnalyzedView->selectionModel()
                       ->currentIndex()
-                      .data(ProcessModel::ProcDescriptionRole)
+                      .data(ProcessListModel::ProcDescriptionRole)
                       .value<ProcessDescription>()
                       .pid;
     } else {
@@ -1,9 +1,9 @@
 #pragma once
 
 #include "core/Cutter.h"
+#include "common/ProcessListModel.h"
 #include <QDialog>
 #include <memory>
-#include <QAbstractListModel>
 #include <QSortFilterProxyModel>
 #include <QTimer>
 
@@ -15,29 +15,27 @@ class MainWindow;
 class QTreeWidget;
 class QTreeWidgetItem;
 
-class ProcessModel : public QAbstractListModel
+class ProcessModel : public ProcessListModel
 {
     Q_OBJECT
 
-private:
-    QList<ProcessDescription> processes;
-
 public:
     enum Column { PidColumn = 0, UidColumn, StatusColumn, PathColumn, ColumnCount };
-    enum Role { ProcDescriptionRole = Qt::UserRole };
 
     ProcessModel(QObject *parent = 0);
 
-    int rowCount(const QModelIndex &parent = QModelIndex()) const;
-    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
 
-    QVariant data(const QModelIndex &index, int role) const;
-    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
     static bool lessThan(const ProcessDescription &left, const ProcessDescription &right,
                          int column);
 
 public slots:
     void updateData();
+
+protected:
+    QVariant displayData(const ProcessDescription &proc, int column) const override;
 };
 
 class ProcessProxyModel : public QSortFilterProxyModel
@@ -85,6 +83,10 @@ private slots:
     void on_procBeingAnalyzedView_doubleClicked(const QModelIndex &index);
     void updateModelData();
 
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
 private:
     std::unique_ptr<Ui::AttachProcDialog> ui;
     bool eventFilter(QObject *obj, QEvent *event);
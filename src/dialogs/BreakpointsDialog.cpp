@@ -2,6 +2,7 @@
 #include "ui_BreakpointsDialog.h"
 #include "Cutter.h"
 #include "Helpers.h"
+#include "core/BreakpointCondition.h"
 
 #include <QPushButton>
 #include <QCompleter>
@@ -13,8 +14,11 @@ BreakpointsDialog::BreakpointsDialog(bool editMode, QWidget *parent)
     ui->setupUi(this);
     setWindowFlags(windowFlags() & (~Qt::WindowContextHelpButtonHint));
 
+    conditionRegisters = Core()->getBreakpointConditionRegisters();
     connect(ui->breakpointPosition, &QLineEdit::textChanged, this,
             &BreakpointsDialog::refreshOkButton);
+    connect(ui->breakpointBreakIf, &QLineEdit::textChanged, this,
+            &BreakpointsDialog::refreshOkButton);
     refreshOkButton();
 
     if (editMode) {
@@ -84,6 +88,7 @@ BreakpointsDialog::BreakpointsDialog(const BreakpointDescription &breakpoint, QW
     }
     ui->breakpointCommand->setPlainText(breakpoint.command);
     ui->breakpointCondition->setEditText(breakpoint.condition);
+    ui->breakpointBreakIf->setText(breakpoint.breakIf);
     if (breakpoint.hw) {
         ui->radioHardware->setChecked(true);
         ui->hwRead->setChecked(breakpoint.permission & RZ_PERM_R);
@@ -130,6 +135,7 @@ BreakpointDescription BreakpointsDialog::getDescription()
 
     breakpoint.size = Core()->num(ui->breakpointSize->currentText());
     breakpoint.condition = ui->breakpointCondition->currentText().trimmed();
+    breakpoint.breakIf = ui->breakpointBreakIf->text().trimmed();
     breakpoint.command = ui->breakpointCommand->toPlainText().trimmed();
     if (ui->radioHardware->isChecked()) {
         breakpoint.hw = true;
@@ -161,7 +167,13 @@ void BreakpointsDialog::editBreakpoint(const BreakpointDescription &breakpoint,
 void BreakpointsDialog::refreshOkButton()
 {
     auto button = ui->buttonBox->button(QDialogButtonBox::StandardButton::Ok);
-    button->setDisabled(ui->breakpointPosition->text().isEmpty());
+    QString breakIf = ui->breakpointBreakIf->text().trimmed();
+    QString breakIfError;
+    if (!breakIf.isEmpty()) {
+        breakIfError = BreakpointCondition::check(breakIf, conditionRegisters);
+    }
+    button->setToolTip(breakIfError);
+    button->setDisabled(ui->breakpointPosition->text().isEmpty() || !breakIfError.isEmpty());
 }
 
 void BreakpointsDialog::onTypeChanged()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QDialog>
+#include <QHash>
 #include <memory>
 #include "CutterDescriptions.h"
 
@@ -26,6 +27,8 @@ public:
 private:
     std::unique_ptr<Ui::BreakpointsDialog> ui;
     bool editMode = false;
+    /// Fetched once, so that checking the condition while typing doesn't wait for the core
+    QHash<QString, int> conditionRegisters;
 
     void refreshOkButton();
     void onTypeChanged();
@@ -0,0 +1,33 @@
+#include "ContinueEmulationDialog.h"
+#include "ui_ContinueEmulationDialog.h"
+
+#include "common/Configuration.h"
+#include "core/Cutter.h"
+
+ContinueEmulationDialog::ContinueEmulationDialog(QWidget *parent)
+    : QDialog(parent), ui(new Ui::ContinueEmulationDialog)
+{
+    ui->setupUi(this);
+    setWindowFlags(windowFlags() & (~Qt::WindowContextHelpButtonHint));
+    ui->invalidCheckBox->setChecked(Config()->getConfigBool("esil.breakoninvalid"));
+}
+
+ContinueEmulationDialog::~ContinueEmulationDialog() {}
+
+TraceOptions ContinueEmulationDialog::getOptions() const
+{
+    TraceOptions options;
+    options.maxSteps = static_cast<quint64>(ui->stepsSpinBox->value());
+    QString until = ui->untilEdit->text().trimmed();
+    if (!until.isEmpty()) {
+        options.untilAddress = Core()->math(until);
+    }
+    QString access = ui->accessEdit->text().trimmed();
+    if (!access.isEmpty()) {
+        options.accessBegin = Core()->math(access);
+        options.accessEnd = options.accessBegin + ui->accessSizeSpinBox->value();
+    }
+    options.condition = ui->conditionEdit->text().trimmed();
+    options.stopOnInvalid = ui->invalidCheckBox->isChecked();
+    return options;
+}
@@ -0,0 +1,30 @@
+#ifndef CONTINUEEMULATIONDIALOG_H
+#define CONTINUEEMULATIONDIALOG_H
+
+#include "core/TraceRecorder.h"
+
+#include <QDialog>
+#include <memory>
+
+namespace Ui {
+class ContinueEmulationDialog;
+}
+
+/**
+ * @brief Dialog for the stop conditions of CutterCore::continueEmulation()
+ */
+class ContinueEmulationDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ContinueEmulationDialog(QWidget *parent = nullptr);
+    ~ContinueEmulationDialog();
+
+    TraceOptions getOptions() const;
+
+private:
+    std::unique_ptr<Ui::ContinueEmulationDialog> ui;
+};
+
+#endif // CONTINUEEMULATIONDIALOG_H
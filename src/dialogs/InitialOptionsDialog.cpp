@@ -4,7 +4,6 @@
 
 #include "core/MainWindow.h"
 #include "dialogs/NewFileDialog.h"
-#include "dialogs/AsyncTaskDialog.h"
 #include "common/Helpers.h"
 
 #include <QSettings>
@@ -169,6 +168,7 @@ void InitialOptionsDialog::loadOptions(const InitialOptions &options)
     ui->analysisSlider->setValue(analysisLevel);
 
     shellcode = options.shellcode;
+    analysisTraceFile = options.analysisTraceFile;
 
     if (!options.forceBinPlugin.isEmpty()) {
         ui->formatComboBox->setCurrentText(options.forceBinPlugin);
@@ -303,6 +303,7 @@ void InitialOptionsDialog::setupAndStartAnalysis()
         main->setWindowTitle("Cutter – " + options.filename);
     }
     options.shellcode = this->shellcode;
+    options.analysisTraceFile = this->analysisTraceFile;
 
     // Where the bin header is located in the file (-B)
     if (ui->entry_loadOffset->text().length() > 0) {
@@ -354,21 +355,7 @@ void InitialOptionsDialog::setupAndStartAnalysis()
 
     MainWindow *main = this->main;
     connect(analysisTask, &AnalysisTask::openFileFailed, main, &MainWindow::openNewFileFailed);
-    connect(analysisTask, &AsyncTask::finished, main, [analysisTask, main]() {
-        if (analysisTask->getOpenFileFailed()) {
-            return;
-        }
-        main->finalizeOpen();
-    });
-
-    AsyncTask::Ptr analysisTaskPtr(analysisTask);
-
-    AsyncTaskDialog *taskDialog = new AsyncTaskDialog(analysisTaskPtr);
-    taskDialog->setInterruptOnClose(true);
-    taskDialog->setAttribute(Qt::WA_DeleteOnClose);
-    taskDialog->show();
-
-    Core()->getAsyncTaskManager()->start(analysisTaskPtr);
+    main->startAnalysis(analysisTask, true);
 
     done(0);
 
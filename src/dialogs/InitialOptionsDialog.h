@@ -45,6 +45,7 @@ private:
 
     QString analysisDescription(int level);
     QString shellcode;
+    QString analysisTraceFile;
     int analysisLevel;
     QList<RzAsmPluginDescription> asmPlugins;
 
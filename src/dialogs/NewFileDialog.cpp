@@ -350,10 +350,13 @@ void NewFileDialog::loadFile(const QString &filename)
 void NewFileDialog::loadProject(const QString &project)
 {
     MainWindow *main = new MainWindow();
+    // Kept until the project is shown, so that another one can be chosen if it fails
+    connect(main, &MainWindow::projectOpened, this, &NewFileDialog::close);
+    connect(main, &MainWindow::projectOpenFailed, this, [this]() { setEnabled(true); });
     if (!main->openProject(project)) {
         return;
     }
-    close();
+    setEnabled(false);
 }
 
 void NewFileDialog::loadShellcode(const QString &shellcode, const int size)
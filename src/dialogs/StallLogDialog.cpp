@@ -0,0 +1,96 @@
+#include "StallLogDialog.h"
+
+#include "common/BugReporting.h"
+#include "common/Configuration.h"
+#include "common/StallWatchdog.h"
+
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QMessageBox>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QRegularExpression>
+#include <QSpinBox>
+#include <QVBoxLayout>
+
+StallLogDialog::StallLogDialog(QWidget *parent) : QDialog(parent)
+{
+    setWindowTitle(tr("Interface Stalls"));
+    resize(700, 450);
+
+    auto layout = new QVBoxLayout(this);
+    auto form = new QFormLayout();
+    thresholdSpinBox = new QSpinBox(this);
+    thresholdSpinBox->setRange(0, 60000);
+    thresholdSpinBox->setSingleStep(100);
+    thresholdSpinBox->setSuffix(tr(" ms"));
+    thresholdSpinBox->setSpecialValueText(tr("Disabled"));
+    thresholdSpinBox->setToolTip(
+            tr("Log the interface when it does not respond for longer than this"));
+    thresholdSpinBox->setValue(StallWatchdog::instance()->getThreshold());
+    form->addRow(tr("Threshold:"), thresholdSpinBox);
+    layout->addLayout(form);
+
+    logEdit = new QPlainTextEdit(this);
+    logEdit->setReadOnly(true);
+    logEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    logEdit->setPlaceholderText(tr("No stalls were logged."));
+    layout->addWidget(logEdit);
+
+    auto buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    auto saveButton = buttons->addButton(tr("Save..."), QDialogButtonBox::ActionRole);
+    auto clearButton = buttons->addButton(tr("Clear"), QDialogButtonBox::ActionRole);
+    auto reportButton = buttons->addButton(tr("Report Issue..."), QDialogButtonBox::ActionRole);
+    reportButton->setToolTip(tr("Open an issue with the most recent stalls"));
+    layout->addWidget(buttons);
+
+    connect(thresholdSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
+            &StallLogDialog::setThreshold);
+    connect(saveButton, &QPushButton::clicked, this, &StallLogDialog::saveLog);
+    connect(clearButton, &QPushButton::clicked, this, [this]() {
+        StallWatchdog::instance()->clear();
+        updateLog();
+    });
+    connect(reportButton, &QPushButton::clicked, this, &StallLogDialog::reportIssue);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    connect(StallWatchdog::instance(), &StallWatchdog::stallEnded, this,
+            &StallLogDialog::updateLog);
+    updateLog();
+}
+
+void StallLogDialog::setThreshold(int thresholdMs)
+{
+    Config()->setStallThreshold(thresholdMs);
+    StallWatchdog::instance()->setThreshold(thresholdMs);
+}
+
+void StallLogDialog::updateLog()
+{
+    logEdit->setPlainText(StallWatchdog::instance()->toText());
+}
+
+void StallLogDialog::saveLog()
+{
+    QString file = QFileDialog::getSaveFileName(this, tr("Save the stalls"), "stalls.txt",
+                                                tr("Text files (*.txt)"));
+    if (file.isEmpty()) {
+        return;
+    }
+    QString error;
+    if (!StallWatchdog::instance()->save(file, &error)) {
+        QMessageBox::critical(this, tr("Save the stalls"),
+                              tr("Failed to save %1: %2").arg(file, error));
+    }
+}
+
+void StallLogDialog::reportIssue()
+{
+    // Most recent first, so whole stalls are dropped from the end
+    QString log = StallWatchdog::instance()->toText();
+    if (log.size() > MaxReportLength) {
+        int end = log.lastIndexOf(QRegularExpression("\n\\S"), MaxReportLength);
+        log.truncate(end > 0 ? end : MaxReportLength);
+    }
+    openIssue(log);
+}
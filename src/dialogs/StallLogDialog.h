@@ -0,0 +1,33 @@
+#ifndef STALLLOGDIALOG_H
+#define STALLLOGDIALOG_H
+
+#include <QDialog>
+
+class QPlainTextEdit;
+class QSpinBox;
+
+/**
+ * @brief Shows the stalls of the GUI thread logged by the StallWatchdog
+ */
+class StallLogDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit StallLogDialog(QWidget *parent = nullptr);
+
+private slots:
+    void setThreshold(int thresholdMs);
+    void updateLog();
+    void saveLog();
+    void reportIssue();
+
+private:
+    /// Keeps the URL of the issue within the length browsers accept
+    static constexpr int MaxReportLength = 4000;
+
+    QSpinBox *thresholdSpinBox;
+    QPlainTextEdit *logEdit;
+};
+
+#endif // STALLLOGDIALOG_H
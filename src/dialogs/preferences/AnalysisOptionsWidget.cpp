@@ -5,6 +5,7 @@
 
 #include "common/Helpers.h"
 #include "common/Configuration.h"
+#include "common/AnalysisCache.h"
 
 #include "core/MainWindow.h"
 
@@ -52,6 +53,25 @@ AnalysisOptionsWidget::AnalysisOptionsWidget(PreferencesDialog *dialog)
     connect(ui->preludeLineEdit, &QLineEdit::textChanged, this,
             &AnalysisOptionsWidget::updateAnalysisPrelude);
     updateAnalysisOptionsFromVars();
+
+    ui->analysisCacheCheckBox->setChecked(Config()->getAnalysisCacheEnabled());
+    ui->analysisCacheSizeSpinBox->setValue(Config()->getAnalysisCacheSizeLimit());
+    connect(ui->analysisCacheCheckBox, &QCheckBox::toggled, this,
+            [](bool checked) { Config()->setAnalysisCacheEnabled(checked); });
+    connect(ui->analysisCacheSizeSpinBox,
+            static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
+            [](int value) { Config()->setAnalysisCacheSizeLimit(value); });
+    connect(ui->analysisCacheClearButton, &QPushButton::clicked, this, [this]() {
+        AnalysisCache::clear();
+        updateAnalysisCacheUsage();
+    });
+    updateAnalysisCacheUsage();
+}
+
+void AnalysisOptionsWidget::updateAnalysisCacheUsage()
+{
+    ui->analysisCacheUsageLabel->setText(
+            tr("Used: %1 MiB").arg(AnalysisCache::size() / (1024.0 * 1024.0), 0, 'f', 1));
 }
 
 AnalysisOptionsWidget::~AnalysisOptionsWidget() {}
@@ -35,6 +35,8 @@ private:
      */
     void createAnalysisInOptionsList();
 
+    void updateAnalysisCacheUsage();
+
 private slots:
     /**
      * @brief A slot to display the options in the dialog according to the current analysis.*
@@ -26,7 +26,7 @@ BacktraceWidget::BacktraceWidget(MainWindow *main)
 
     refreshDeferrer = createRefreshDeferrer([this]() { updateContents(); });
 
-    connect(Core(), &CutterCore::refreshAll, this, &BacktraceWidget::updateContents);
+    Core()->getRefreshScheduler()->add(this, [this]() { updateContents(); });
     connect(Core(), &CutterCore::registersChanged, this, &BacktraceWidget::updateContents);
     connect(Config(), &Configuration::fontsUpdated, this, &BacktraceWidget::fontsUpdatedSlot);
 }
@@ -44,16 +44,14 @@ void BacktraceWidget::updateContents()
 
 void BacktraceWidget::setBacktraceGrid()
 {
-    RzList *list = rz_core_debug_backtraces(Core()->core());
+    const auto snapshot = Core()->getDebugSnapshot(DebugSnapshot::Part::Backtrace);
     int i = 0;
-    RzListIter *iter;
-    RzBacktrace *bt;
-    CutterRzListForeach (list, iter, RzBacktrace, bt) {
-        QString funcName = bt->fcn ? bt->fcn->name : "";
-        QString pc = RzAddressString(bt->frame ? bt->frame->addr : 0);
-        QString sp = RzAddressString(bt->frame ? bt->frame->sp : 0);
-        QString frameSize = QString::number(bt->frame ? bt->frame->size : 0);
-        QString desc = bt->desc;
+    for (const BacktraceDescription &frame : snapshot->backtrace) {
+        QString funcName = frame.function;
+        QString pc = RzAddressString(frame.pc);
+        QString sp = RzAddressString(frame.sp);
+        QString frameSize = QString::number(frame.frameSize);
+        QString desc = frame.description;
 
         modelBacktrace->setItem(i, 0, new QStandardItem(funcName));
         modelBacktrace->setItem(i, 1, new QStandardItem(sp));
@@ -62,7 +60,6 @@ void BacktraceWidget::setBacktraceGrid()
         modelBacktrace->setItem(i, 4, new QStandardItem(frameSize));
         ++i;
     }
-    rz_list_free(list);
 
     // Remove irrelevant old rows
     if (modelBacktrace->rowCount() > i) {
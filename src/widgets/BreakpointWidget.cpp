@@ -69,6 +69,8 @@ QVariant BreakpointModel::data(const QModelIndex &index, int role) const
             return breakpoint.trace;
         case EnabledColumn:
             return breakpoint.enabled;
+        case HitsColumn:
+            return QString::number(breakpoint.hits);
         case CommentColumn:
             return Core()->getCommentAt(breakpoint.addr);
         default:
@@ -82,9 +84,16 @@ QVariant BreakpointModel::data(const QModelIndex &index, int role) const
             return breakpoint.trace;
         case EnabledColumn:
             return breakpoint.enabled;
+        case HitsColumn:
+            return breakpoint.hits;
         default:
             return data(index, Qt::DisplayRole);
         }
+    case Qt::ToolTipRole:
+        if (index.column() == HitsColumn && !breakpoint.breakIf.isEmpty()) {
+            return tr("Break if %1").arg(breakpoint.breakIf);
+        }
+        return QVariant();
     case BreakpointDescriptionRole:
         return QVariant::fromValue(breakpoint);
     default:
@@ -107,6 +116,8 @@ QVariant BreakpointModel::headerData(int section, Qt::Orientation, int role) con
             return tr("Tracing");
         case EnabledColumn:
             return tr("Enabled");
+        case HitsColumn:
+            return tr("Hits");
         case CommentColumn:
             return tr("Comment");
         default:
@@ -213,7 +224,7 @@ BreakpointWidget::BreakpointWidget(MainWindow *main)
     contextMenu->addAction(actionToggleBreakpoint);
     contextMenu->addAction(actionDelBreakpoint);
 
-    connect(Core(), &CutterCore::refreshAll, this, &BreakpointWidget::refreshBreakpoint);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshBreakpoint(); });
     connect(Core(), &CutterCore::breakpointsChanged, this, &BreakpointWidget::refreshBreakpoint);
     connect(Core(), &CutterCore::codeRebased, this, &BreakpointWidget::refreshBreakpoint);
     connect(Core(), &CutterCore::refreshCodeViews, this, &BreakpointWidget::refreshBreakpoint);
@@ -234,6 +245,11 @@ void BreakpointWidget::refreshBreakpoint()
     if (editing || !refreshDeferrer->attemptRefresh(nullptr)) {
         return;
     }
+    // refreshCodeViews comes after every step, which rarely touches the breakpoints
+    if (shownGeneration == Core()->getBreakpointsGeneration()) {
+        return;
+    }
+    shownGeneration = Core()->getBreakpointsGeneration();
 
     breakpointModel->refresh();
 
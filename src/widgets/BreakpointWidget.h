@@ -36,6 +36,7 @@ public:
         TypeColumn,
         TraceColumn,
         EnabledColumn,
+        HitsColumn,
         CommentColumn,
         ColumnCount
     };
@@ -95,4 +96,6 @@ private:
 
     RefreshDeferrer *refreshDeferrer;
     bool editing = false;
+    /// Breakpoints generation shown by the model, see CutterCore::getBreakpointsGeneration()
+    quint64 shownGeneration = ~0ULL;
 };
@@ -43,7 +43,7 @@ CallGraphView::CallGraphView(CutterDockWidget *parent, MainWindow *main, bool gl
     enableAddresses(true);
     refreshDeferrer.registerFor(parent);
     connect(&refreshDeferrer, &RefreshDeferrer::refreshNow, this, &CallGraphView::refreshView);
-    connect(Core(), &CutterCore::refreshAll, this, &SimpleTextGraphView::refreshView);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshView(); });
     connect(Core(), &CutterCore::functionRenamed, this, &CallGraphView::refreshView);
 }
 
@@ -227,7 +227,6 @@ AnalysisClassesModel::AnalysisClassesModel(CutterDockWidget *parent)
     // refresh everything later.
     refreshDeferrer = parent->createRefreshDeferrer([this]() { this->refreshAll(); });
 
-    connect(Core(), &CutterCore::refreshAll, this, &AnalysisClassesModel::refreshAll);
     connect(Core(), &CutterCore::codeRebased, this, &AnalysisClassesModel::refreshAll);
     connect(Core(), &CutterCore::classNew, this, &AnalysisClassesModel::classNew);
     connect(Core(), &CutterCore::classDeleted, this, &AnalysisClassesModel::classDeleted);
@@ -624,6 +623,15 @@ ClassesWidget::ClassesWidget(MainWindow *main)
 
     connect<void (QComboBox::*)(int)>(classSourceCombo, &QComboBox::currentIndexChanged, this,
                                       &ClassesWidget::refreshClasses);
+    // Registered once here, the analysis model is replaced when the source changes
+    Core()->getRefreshScheduler()->add(
+            this,
+            [this]() {
+                if (analysis_model) {
+                    analysis_model->refreshAll();
+                }
+            },
+            RefreshScheduler::Priority::Low);
 
     connect(&seekToVTableAction, &QAction::triggered, this,
             &ClassesWidget::seekToVTableActionTriggered);
@@ -260,7 +260,7 @@ CommentsWidget::CommentsWidget(MainWindow *main)
 
     connect(Core(), &CutterCore::codeRebased, this, &CommentsWidget::refreshTree);
     connect(Core(), &CutterCore::commentsChanged, this, &CommentsWidget::refreshTree);
-    connect(Core(), &CutterCore::refreshAll, this, &CommentsWidget::refreshTree);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshTree(); });
 }
 
 CommentsWidget::~CommentsWidget() {}
@@ -0,0 +1,136 @@
+#include "CoreLockWidget.h"
+
+#include "core/CoreLockProfiler.h"
+#include "core/MainWindow.h"
+
+#include <QCheckBox>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace {
+
+/// Sorted by the durations, not their formatted text
+class ProfileItem : public QTreeWidgetItem
+{
+public:
+    bool operator<(const QTreeWidgetItem &other) const override
+    {
+        int column = treeWidget()->sortColumn();
+        QVariant value = data(column, Qt::UserRole);
+        if (!value.isValid()) {
+            return QTreeWidgetItem::operator<(other);
+        }
+        return value.toLongLong() < other.data(column, Qt::UserRole).toLongLong();
+    }
+};
+
+}
+
+CoreLockWidget::CoreLockWidget(MainWindow *main) : CutterDockWidget(main)
+{
+    setObjectName("CoreLockWidget");
+    setWindowTitle(tr("Core Lock"));
+
+    auto content = new QWidget(this);
+    auto layout = new QVBoxLayout(content);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    auto buttons = new QHBoxLayout();
+    recordCheckBox = new QCheckBox(tr("Record"), content);
+    recordCheckBox->setToolTip(tr("Measure how long each caller waits for and holds the core"));
+    auto resetButton = new QPushButton(tr("Reset"), content);
+    auto saveButton = new QPushButton(tr("Save..."), content);
+    buttons->addWidget(recordCheckBox);
+    buttons->addStretch();
+    buttons->addWidget(resetButton);
+    buttons->addWidget(saveButton);
+    layout->addLayout(buttons);
+
+    tree = new QTreeWidget(content);
+    tree->setRootIsDecorated(false);
+    tree->setSortingEnabled(true);
+    tree->setHeaderLabels({ tr("Caller"), tr("Thread"), tr("Count"), tr("Wait"), tr("Wait p99"),
+                            tr("Wait max"), tr("Hold"), tr("Hold p99"), tr("Hold max") });
+    tree->sortByColumn(WaitTotalColumn, Qt::DescendingOrder);
+    layout->addWidget(tree);
+    setWidget(content);
+
+    recordCheckBox->setChecked(CoreLockProfiler::instance()->isEnabled());
+    connect(recordCheckBox, &QCheckBox::toggled, this, &CoreLockWidget::setRecording);
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        CoreLockProfiler::instance()->reset();
+        updateContents();
+    });
+    connect(saveButton, &QPushButton::clicked, this, &CoreLockWidget::saveProfile);
+
+    // Nothing signals new measurements
+    updateTimer.setInterval(1000);
+    connect(&updateTimer, &QTimer::timeout, this, &CoreLockWidget::updateContents);
+    connect(this, &CutterDockWidget::becameVisibleToUser, this, &CoreLockWidget::updateContents);
+    setRecording(recordCheckBox->isChecked());
+}
+
+void CoreLockWidget::setRecording(bool recording)
+{
+    CoreLockProfiler::instance()->setEnabled(recording);
+    if (recording) {
+        updateTimer.start();
+    } else {
+        updateTimer.stop();
+        updateContents();
+    }
+}
+
+void CoreLockWidget::updateContents()
+{
+    if (!isVisibleToUser()) {
+        return;
+    }
+
+    tree->setSortingEnabled(false);
+    tree->clear();
+    for (const CoreLockProfiler::Entry &entry : CoreLockProfiler::instance()->getEntries()) {
+        auto item = new ProfileItem();
+        auto setDuration = [item](int column, qint64 us) {
+            item->setText(column, CoreLockProfiler::formatDuration(us));
+            item->setData(column, Qt::UserRole, us);
+        };
+        item->setText(CallerColumn,
+                      entry.scope.isEmpty() ? entry.function
+                                            : QString("%1 > %2").arg(entry.scope, entry.function));
+        item->setText(ThreadColumn, entry.guiThread ? tr("GUI") : tr("Worker"));
+        item->setData(CountColumn, Qt::DisplayRole, static_cast<qulonglong>(entry.hold.count));
+        setDuration(WaitTotalColumn, entry.wait.totalUs);
+        setDuration(WaitP99Column, entry.wait.percentileUs(0.99));
+        setDuration(WaitMaxColumn, entry.wait.maxUs);
+        setDuration(HoldTotalColumn, entry.hold.totalUs);
+        setDuration(HoldP99Column, entry.hold.percentileUs(0.99));
+        setDuration(HoldMaxColumn, entry.hold.maxUs);
+
+        QString histograms = tr("Wait: %1\nHold: %2")
+                                     .arg(entry.wait.bucketsText(), entry.hold.bucketsText());
+        for (int column = 0; column < ColumnCount; column++) {
+            item->setToolTip(column, histograms);
+        }
+        tree->addTopLevelItem(item);
+    }
+    tree->setSortingEnabled(true);
+}
+
+void CoreLockWidget::saveProfile()
+{
+    QString file = QFileDialog::getSaveFileName(this, tr("Save the core lock profile"),
+                                                "core-lock.txt", tr("Text files (*.txt)"));
+    if (file.isEmpty()) {
+        return;
+    }
+    QString error;
+    if (!CoreLockProfiler::instance()->save(file, &error)) {
+        QMessageBox::critical(this, tr("Save the core lock profile"),
+                              tr("Failed to save %1: %2").arg(file, error));
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef CORELOCKWIDGET_H
+#define CORELOCKWIDGET_H
+
+#include "CutterDockWidget.h"
+
+#include <QTimer>
+
+class MainWindow;
+class QCheckBox;
+class QTreeWidget;
+
+/**
+ * @brief Shows the CoreLockProfiler while it records, to find what the GUI thread waits for
+ */
+class CoreLockWidget : public CutterDockWidget
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        CallerColumn = 0,
+        ThreadColumn,
+        CountColumn,
+        WaitTotalColumn,
+        WaitP99Column,
+        WaitMaxColumn,
+        HoldTotalColumn,
+        HoldP99Column,
+        HoldMaxColumn,
+        ColumnCount
+    };
+
+    explicit CoreLockWidget(MainWindow *main);
+
+private slots:
+    void setRecording(bool recording);
+    void updateContents();
+    void saveProfile();
+
+private:
+    QCheckBox *recordCheckBox;
+    QTreeWidget *tree;
+    QTimer updateTimer;
+};
+
+#endif // CORELOCKWIDGET_H
@@ -24,7 +24,7 @@ Dashboard::Dashboard(MainWindow *main) : CutterDockWidget(main), ui(new Ui::Dash
 {
     ui->setupUi(this);
 
-    connect(Core(), &CutterCore::refreshAll, this, &Dashboard::updateContents);
+    Core()->getRefreshScheduler()->add(this, [this]() { updateContents(); });
 }
 
 Dashboard::~Dashboard() {}
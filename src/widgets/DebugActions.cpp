@@ -2,6 +2,7 @@
 #include "core/MainWindow.h"
 #include "dialogs/AttachProcDialog.h"
 #include "dialogs/NativeDebugDialog.h"
+#include "dialogs/ContinueEmulationDialog.h"
 #include "common/Configuration.h"
 #include "common/Helpers.h"
 
@@ -12,6 +13,8 @@
 #include <QToolBar>
 #include <QToolButton>
 #include <QSettings>
+#include <QStatusBar>
+#include <QTimer>
 
 DebugActions::DebugActions(QToolBar *toolBar, MainWindow *main) : QObject(main), main(main)
 {
@@ -43,6 +46,7 @@ DebugActions::DebugActions(QToolBar *toolBar, MainWindow *main) : QObject(main),
     QString continueUMLabel = tr("Continue until main");
     QString continueUCLabel = tr("Continue until call");
     QString continueUSLabel = tr("Continue until syscall");
+    QString continueEmulLabel = tr("Continue emulation until...");
     QString continueBackLabel = tr("Continue backwards");
     QString stepLabel = tr("Step");
     QString stepOverLabel = tr("Step over");
@@ -67,6 +71,7 @@ DebugActions::DebugActions(QToolBar *toolBar, MainWindow *main) : QObject(main),
     actionContinueUntilMain = new QAction(continueUMLabel, this);
     actionContinueUntilCall = new QAction(continueUCLabel, this);
     actionContinueUntilSyscall = new QAction(continueUSLabel, this);
+    actionContinueEmulation = new QAction(continueEmulLabel, this);
     actionContinueBack = new QAction(continueBackIcon, continueBackLabel, this);
     actionContinueBack->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_F5));
     actionStep = new QAction(stepLabel, this);
@@ -99,6 +104,7 @@ DebugActions::DebugActions(QToolBar *toolBar, MainWindow *main) : QObject(main),
     continueUntilMenu->addAction(actionContinueUntilMain);
     continueUntilMenu->addAction(actionContinueUntilCall);
     continueUntilMenu->addAction(actionContinueUntilSyscall);
+    continueUntilMenu->addAction(actionContinueEmulation);
     continueUntilButton->setMenu(continueUntilMenu);
     continueUntilButton->setDefaultAction(actionContinueUntilMain);
 
@@ -120,6 +126,7 @@ DebugActions::DebugActions(QToolBar *toolBar, MainWindow *main) : QObject(main),
                    actionContinueUntilCall,
                    actionContinueUntilMain,
                    actionContinueUntilSyscall,
+                   actionContinueEmulation,
                    actionStep,
                    actionStepOut,
                    actionStepOver,
@@ -138,6 +145,7 @@ DebugActions::DebugActions(QToolBar *toolBar, MainWindow *main) : QObject(main),
                       actionContinueUntilMain,
                       actionContinueUntilCall,
                       actionContinueUntilSyscall,
+                      actionContinueEmulation,
                       actionTrace };
     toggleConnectionActions = { actionAttach, actionStartRemote };
     reverseActions = { actionStepBack, actionContinueBack };
@@ -148,6 +156,38 @@ DebugActions::DebugActions(QToolBar *toolBar, MainWindow *main) : QObject(main),
         msgBox.exec();
     });
 
+    QStatusBar *statusBar = main->statusBar();
+    connect(Core(), &CutterCore::emulationProgress, this,
+            [this, statusBar](quint64 steps, RVA pc, quint64 stepsPerSecond) {
+                statusBar->showMessage(tr("Emulating: %1 instructions, at %2, %3 instructions/s")
+                                               .arg(steps)
+                                               .arg(RzAddressString(pc))
+                                               .arg(stepsPerSecond));
+            });
+    connect(Core(), &CutterCore::emulationFinished, this,
+            [this, statusBar](quint64 steps, quint64 stepsPerSecond, const QString &reason) {
+                statusBar->showMessage(
+                        tr("Emulation stopped after %1 instructions (%2), %3 instructions/s")
+                                .arg(steps)
+                                .arg(reason)
+                                .arg(stepsPerSecond),
+                        10000);
+            });
+
+    connect(Core(), &CutterCore::registersChanged, this, [statusBar]() {
+        if (!Core()->currentlyRemoteDebugging) {
+            return;
+        }
+        // Once the widgets refreshed for the stop
+        QTimer::singleShot(0, statusBar, [statusBar]() {
+            auto statistics = Core()->getMemoryStatistics();
+            statusBar->showMessage(tr("Memory reads since the last stop: %1 requests, %2 bytes")
+                                           .arg(statistics.reads)
+                                           .arg(statistics.bytes),
+                                   10000);
+        });
+    });
+
     connect(Core(), &CutterCore::debugTaskStateChanged, this, [=]() {
         bool disableToolbar = Core()->isDebugTaskInProgress();
         if (Core()->currentlyDebugging) {
@@ -220,6 +260,7 @@ DebugActions::DebugActions(QToolBar *toolBar, MainWindow *main) : QObject(main),
     connect(actionContinueUntilCall, &QAction::triggered, Core(), &CutterCore::continueUntilCall);
     connect(actionContinueUntilSyscall, &QAction::triggered, Core(),
             &CutterCore::continueUntilSyscall);
+    connect(actionContinueEmulation, &QAction::triggered, this, &DebugActions::continueEmulation);
     connect(actionContinueBack, &QAction::triggered, Core(), &CutterCore::continueBackDebug);
     connect(actionContinue, &QAction::triggered, Core(), [=]() {
         // Switch between continue and suspend depending on the debugger's state
@@ -284,11 +325,20 @@ void DebugActions::continueUntilMain()
     Core()->continueUntilDebug(main_flag->offset);
 }
 
+void DebugActions::continueEmulation()
+{
+    ContinueEmulationDialog dialog(main);
+    if (dialog.exec()) {
+        Core()->continueEmulation(dialog.getOptions());
+    }
+}
+
 void DebugActions::attachRemoteDebugger()
 {
     QString stopAttachLabel = tr("Detach from process");
     // Hide unwanted buttons
     setAllActionsVisible(true);
+    actionContinueEmulation->setVisible(false);
     actionStart->setVisible(false);
     actionStartRemote->setVisible(false);
     actionStartEmul->setVisible(false);
@@ -368,6 +418,7 @@ void DebugActions::attachProcess(int pid)
     QString stopAttachLabel = tr("Detach from process");
     // hide unwanted buttons
     setAllActionsVisible(true);
+    actionContinueEmulation->setVisible(false);
     actionStart->setVisible(false);
     actionStartRemote->setVisible(false);
     actionStartEmul->setVisible(false);
@@ -405,6 +456,7 @@ void DebugActions::startDebug()
     Core()->setConfig("dbg.args", args);
 
     setAllActionsVisible(true);
+    actionContinueEmulation->setVisible(false);
     actionAttach->setVisible(false);
     actionStartRemote->setVisible(false);
     actionStartEmul->setVisible(false);
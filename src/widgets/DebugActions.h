@@ -26,6 +26,7 @@ public:
     QAction *actionContinueUntilMain;
     QAction *actionContinueUntilCall;
     QAction *actionContinueUntilSyscall;
+    QAction *actionContinueEmulation;
     QAction *actionContinueBack;
     QAction *actionStep;
     QAction *actionStepOver;
@@ -71,6 +72,7 @@ private:
 
 private slots:
     void continueUntilMain();
+    void continueEmulation();
     void startDebug();
     void attachProcessDialog();
     void attachProcess(int pid);
@@ -85,7 +85,8 @@ DecompilerWidget::DecompilerWidget(MainWindow *main)
     ui->progressLabel->setVisible(false);
     doRefresh();
 
-    connect(Core(), &CutterCore::refreshAll, this, &DecompilerWidget::doRefresh);
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { doRefresh(); }, RefreshScheduler::Priority::High);
     connect(Core(), &CutterCore::functionRenamed, this, &DecompilerWidget::doRefresh);
     connect(Core(), &CutterCore::varsChanged, this, &DecompilerWidget::doRefresh);
     connect(Core(), &CutterCore::functionsChanged, this, &DecompilerWidget::doRefresh);
@@ -48,7 +48,8 @@ DisassemblerGraphView::DisassemblerGraphView(QWidget *parent, CutterSeekable *se
     connect(Config(), &Configuration::colorsUpdated, this,
             &DisassemblerGraphView::setTooltipStylesheet);
 
-    connect(Core(), &CutterCore::refreshAll, this, &DisassemblerGraphView::refreshView);
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { refreshView(); }, RefreshScheduler::Priority::High);
     connect(Core(), &CutterCore::commentsChanged, this, &DisassemblerGraphView::refreshView);
     connect(Core(), &CutterCore::functionRenamed, this, &DisassemblerGraphView::refreshView);
     connect(Core(), &CutterCore::flagsChanged, this, &DisassemblerGraphView::refreshView);
@@ -171,7 +172,7 @@ void DisassemblerGraphView::refreshView()
 {
     CutterGraphView::refreshView();
     loadCurrentGraph();
-    breakpoints = Core()->getBreakpointsAddresses();
+    breakpoints = Core()->getBreakpointAddressSet();
     emit viewRefreshed();
 }
 
@@ -181,7 +181,7 @@ private:
 
     CutterSeekable *seekable = nullptr;
     QList<QShortcut *> shortcuts;
-    QList<RVA> breakpoints;
+    QSet<RVA> breakpoints;
 
     QAction actionUnhighlight;
     QAction actionUnhighlightInstruction;
@@ -140,8 +140,9 @@ DisassemblyWidget::DisassemblyWidget(MainWindow *main)
     connect(Config(), &Configuration::fontsUpdated, this, &DisassemblyWidget::fontsUpdatedSlot);
     connect(Config(), &Configuration::colorsUpdated, this, &DisassemblyWidget::colorsUpdatedSlot);
 
-    connect(Core(), &CutterCore::refreshAll, this,
-            [this]() { refreshDisasm(seekable->getOffset()); });
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { refreshDisasm(seekable->getOffset()); },
+            RefreshScheduler::Priority::High);
     refreshDisasm(seekable->getOffset());
 
     connect(mCtxMenu, &DisassemblyContextMenu::copy, mDisasTextEdit, &QPlainTextEdit::copy);
@@ -254,7 +255,7 @@ void DisassemblyWidget::refreshDisasm(RVA offset)
         return;
     }
 
-    breakpoints = Core()->getBreakpointsAddresses();
+    breakpoints = Core()->getBreakpointAddressSet();
     int horizontalScrollValue = mDisasTextEdit->horizontalScrollBar()->value();
     mDisasTextEdit->setLockScroll(true); // avoid flicker
 
@@ -295,6 +296,12 @@ void DisassemblyWidget::refreshDisasm(RVA offset)
         bottomOffset = topOffset;
     }
 
+    if (Core()->currentlyDebugging && bottomOffset > topOffset
+        && bottomOffset - topOffset < 0x100000) {
+        // Keep the shown code tracked, so changes are highlighted after the next stop
+        Core()->ioReadTracked(topOffset, static_cast<int>(bottomOffset - topOffset + 16));
+    }
+
     connectCursorPositionChanged(false);
 
     updateCursorPosition();
@@ -432,6 +439,37 @@ void DisassemblyWidget::highlightPCLine()
         }
     }
 
+    if (Core()->currentlyDebugging) {
+        // Instructions changed since the previous debugger stop, e.g. unpacked code
+        QColor modifiedColor = ConfigColor("graph.diff.unmatch");
+        modifiedColor.setAlpha(64);
+        QList<QPair<RVA, QTextBlock>> blocks;
+        for (QTextBlock block = mDisasTextEdit->document()->begin(); block.isValid();
+             block = block.next()) {
+            auto userData = getUserData(block);
+            if (userData) {
+                blocks.append({ userData->line.offset, block });
+            }
+        }
+        for (int i = 0; i < blocks.size(); i++) {
+            RVA offset = blocks.at(i).first;
+            RVA end = offset + 1;
+            for (int j = i + 1; j < blocks.size(); j++) {
+                if (blocks.at(j).first > offset) {
+                    end = qMin(blocks.at(j).first, offset + 16);
+                    break;
+                }
+            }
+            if (Core()->isMemoryModified(offset, end - offset)) {
+                QTextEdit::ExtraSelection modifiedSelection;
+                modifiedSelection.cursor = QTextCursor(blocks.at(i).second);
+                modifiedSelection.format.setBackground(modifiedColor);
+                modifiedSelection.format.setProperty(QTextFormat::FullWidthSelection, true);
+                pcSelections.append(modifiedSelection);
+            }
+        }
+    }
+
     // Don't override any extraSelections already set
     QList<QTextEdit::ExtraSelection> currentSelections = mDisasTextEdit->extraSelections();
     currentSelections.append(pcSelections);
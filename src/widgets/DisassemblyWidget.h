@@ -91,7 +91,7 @@ private:
     int topOffsetHistoryPos = 0;
     QList<RVA> topOffsetHistory;
 
-    QList<RVA> breakpoints;
+    QSet<RVA> breakpoints;
 
     void setupFonts();
     void setupColors();
@@ -19,7 +19,7 @@ EntrypointWidget::EntrypointWidget(MainWindow *main)
     setScrollMode();
 
     connect(Core(), &CutterCore::codeRebased, this, &EntrypointWidget::fillEntrypoint);
-    connect(Core(), &CutterCore::refreshAll, this, &EntrypointWidget::fillEntrypoint);
+    Core()->getRefreshScheduler()->add(this, [this]() { fillEntrypoint(); });
 }
 
 EntrypointWidget::~EntrypointWidget() {}
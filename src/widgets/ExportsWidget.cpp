@@ -147,7 +147,7 @@ ExportsWidget::ExportsWidget(MainWindow *main) : ListDockWidget(main)
     connect(toggle_shortcut, &QShortcut::activated, this, [=]() { toggleDockWidget(true); });
 
     connect(Core(), &CutterCore::codeRebased, this, &ExportsWidget::refreshExports);
-    connect(Core(), &CutterCore::refreshAll, this, &ExportsWidget::refreshExports);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshExports(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(exportsModel, ExportsModel::CommentColumn); });
 }
@@ -101,12 +101,16 @@ const FlagDescription *FlagsModel::description(QModelIndex index) const
 FlagsSortFilterProxyModel::FlagsSortFilterProxyModel(FlagsModel *source_model, QObject *parent)
     : AddressableFilterProxyModel(source_model, parent)
 {
+    setNameIndexKinds(NameIndex::Kind::Flag);
 }
 
 bool FlagsSortFilterProxyModel::filterAcceptsRow(int row, const QModelIndex &parent) const
 {
     QModelIndex index = sourceModel()->index(row, 0, parent);
     FlagDescription flag = index.data(FlagsModel::FlagDescriptionRole).value<FlagDescription>();
+    if (rejectedByNameIndex(flag.offset)) {
+        return false;
+    }
     return qhelpers::filterStringContains(flag.name, this);
 }
 
@@ -153,7 +157,7 @@ FlagsWidget::FlagsWidget(MainWindow *main)
     flags_model = new FlagsModel(&flags, this);
     flags_proxy_model = new FlagsSortFilterProxyModel(flags_model, this);
     connect(ui->filterLineEdit, &QLineEdit::textChanged, flags_proxy_model,
-            &QSortFilterProxyModel::setFilterWildcard);
+            &AddressableFilterProxyModel::setFilterWildcardIndexed);
     ui->flagsTreeView->setMainWindow(mainWindow);
     ui->flagsTreeView->setModel(flags_proxy_model);
     ui->flagsTreeView->sortByColumn(FlagsModel::OFFSET, Qt::AscendingOrder);
@@ -182,7 +186,7 @@ FlagsWidget::FlagsWidget(MainWindow *main)
 
     connect(Core(), &CutterCore::flagsChanged, this, &FlagsWidget::flagsChanged);
     connect(Core(), &CutterCore::codeRebased, this, &FlagsWidget::flagsChanged);
-    connect(Core(), &CutterCore::refreshAll, this, &FlagsWidget::refreshFlagspaces);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshFlagspaces(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(flags_model, FlagsModel::COMMENT); });
 
@@ -270,12 +274,6 @@ void FlagsWidget::refreshFlags()
     flags_model->endResetModel();
 
     tree->showItemsNumber(flags_proxy_model->rowCount());
-
-    // TODO: this is not a very good place for the following:
-    QStringList flagNames;
-    for (const FlagDescription &i : flags)
-        flagNames.append(i.name);
-    main->refreshOmniBar(flagNames);
 }
 
 void FlagsWidget::setScrollMode()
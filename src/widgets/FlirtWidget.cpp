@@ -141,7 +141,8 @@ FlirtWidget::FlirtWidget(MainWindow *main)
 
     this->connect(ui->flirtTreeView->selectionModel(), &QItemSelectionModel::currentChanged, this,
                   &FlirtWidget::onSelectedItemChanged);
-    connect(Core(), &CutterCore::refreshAll, this, &FlirtWidget::refreshFlirt);
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { refreshFlirt(); }, RefreshScheduler::Priority::Low);
 
     this->addActions(this->blockMenu->actions());
 }
@@ -5,6 +5,7 @@
 #include "common/DisassemblyPreview.h"
 #include "common/Helpers.h"
 #include "common/FunctionsTask.h"
+#include "common/PreviewCache.h"
 #include "common/TempConfig.h"
 #include "menus/AddressableItemContextMenu.h"
 
@@ -228,16 +229,14 @@ QVariant FunctionModel::data(const QModelIndex &index, int role) const
         return static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter);
 
     case Qt::ToolTipRole: {
-
-        QStringList disasmPreview =
-                Core()->getDisassemblyPreview(function.offset, kMaxTooltipDisasmPreviewLines);
-        QStringList summary {};
-        {
-            auto seeker = Core()->seekTemp(function.offset);
-            auto strings = fromOwnedCharPtr(rz_core_print_disasm_strings(
-                    Core()->core(), RZ_CORE_DISASM_STRINGS_MODE_FUNCTION, 0, NULL));
-            summary = strings.split('\n', CUTTER_QT_SKIP_EMPTY_PARTS);
-        }
+        // Generated in the background, the tooltip is refreshed once the previews are ready
+        PreviewCache *previews = Core()->getPreviewCache();
+        QStringList disasmPreview;
+        QStringList summary;
+        bool ready = previews->lookup(PreviewCache::Kind::Disassembly, function.offset,
+                                      &disasmPreview);
+        ready = previews->lookup(PreviewCache::Kind::FunctionStrings, function.offset, &summary)
+                && ready;
 
         const QFont &fnt = Config()->getFont();
         QFontMetrics fm { fnt };
@@ -251,7 +250,7 @@ QVariant FunctionModel::data(const QModelIndex &index, int role) const
                 break;
             }
         }
-        if (disasmPreview.isEmpty() && highlights.isEmpty())
+        if (ready && disasmPreview.isEmpty() && highlights.isEmpty())
             return {};
 
         QString toolTipContent =
@@ -261,6 +260,9 @@ QVariant FunctionModel::data(const QModelIndex &index, int role) const
                         .arg(qMax(6, fnt.pointSize() - 1)); // slightly decrease font size, to
                                                             // keep more text in the same box
 
+        if (!ready)
+            toolTipContent += tr("<i>Loading preview...</i>");
+
         if (!disasmPreview.isEmpty())
             toolTipContent += tr("<div style=\"margin-bottom: 10px;\"><strong>Disassembly "
                                  "preview</strong>:<br>%1</div>")
@@ -409,6 +411,7 @@ FunctionSortFilterProxyModel::FunctionSortFilterProxyModel(FunctionModel *source
 {
     setFilterCaseSensitivity(Qt::CaseInsensitive);
     setSortCaseSensitivity(Qt::CaseInsensitive);
+    setNameIndexKinds(NameIndex::Kind::Function);
 }
 
 bool FunctionSortFilterProxyModel::filterAcceptsRow(int row, const QModelIndex &parent) const
@@ -416,6 +419,9 @@ bool FunctionSortFilterProxyModel::filterAcceptsRow(int row, const QModelIndex &
     QModelIndex index = sourceModel()->index(row, 0, parent);
     FunctionDescription function =
             index.data(FunctionModel::FunctionDescriptionRole).value<FunctionDescription>();
+    if (rejectedByNameIndex(function.offset)) {
+        return false;
+    }
 
     return qhelpers::filterStringContains(function.name, this);
 }
@@ -509,6 +515,16 @@ FunctionsWidget::FunctionsWidget(MainWindow *main)
     ui->treeView->sortByColumn(FunctionModel::NameColumn, Qt::AscendingOrder);
     ui->treeView->setExpandsOnDoubleClick(false);
 
+    // Start generating the tooltip previews of the hovered rows before the tooltip is requested
+    ui->treeView->setMouseTracking(true);
+    connect(ui->treeView, &QAbstractItemView::entered, this, [this](const QModelIndex &index) {
+        QList<RVA> addresses = qhelpers::neighborAddresses(functionProxyModel, index, 2);
+        Core()->getPreviewCache()->prefetch(PreviewCache::Kind::Disassembly, addresses);
+        Core()->getPreviewCache()->prefetch(PreviewCache::Kind::FunctionStrings, addresses);
+    });
+    connect(Core()->getPreviewCache(), &PreviewCache::previewReady, this,
+            [this]() { qhelpers::refreshHoveredToolTip(ui->treeView); });
+
     titleContextMenu = new QMenu(this);
     auto viewTypeGroup = new QActionGroup(titleContextMenu);
     actionHorizontal.setCheckable(true);
@@ -547,7 +563,7 @@ FunctionsWidget::FunctionsWidget(MainWindow *main)
 
     connect(Core(), &CutterCore::functionsChanged, this, &FunctionsWidget::refreshTree);
     connect(Core(), &CutterCore::codeRebased, this, &FunctionsWidget::refreshTree);
-    connect(Core(), &CutterCore::refreshAll, this, &FunctionsWidget::refreshTree);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshTree(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(functionModel, FunctionModel::CommentColumn); });
 }
@@ -556,13 +572,13 @@ FunctionsWidget::~FunctionsWidget() {}
 
 void FunctionsWidget::refreshTree()
 {
-    if (task) {
-        task->wait();
-    }
-
     task = QSharedPointer<FunctionsTask>(new FunctionsTask());
-    connect(task.data(), &FunctionsTask::fetchFinished, this,
-            [this](const QList<FunctionDescription> &functions) {
+    FunctionsTask *taskPtr = task.data();
+    connect(taskPtr, &FunctionsTask::fetchFinished, this,
+            [this, taskPtr](const QList<FunctionDescription> &functions) {
+                if (task.data() != taskPtr) {
+                    return;
+                }
                 functionModel->beginResetModel();
 
                 this->functions = functions;
@@ -591,7 +607,10 @@ void FunctionsWidget::refreshTree()
                 // resize offset and size columns
                 qhelpers::adjustColumns(ui->treeView, 3, 0);
             });
-    Core()->getAsyncTaskManager()->start(task);
+    // Bursts of functionsChanged, e.g. from scripts, collapse into a single fetch
+    Core()->getAsyncTaskManager()->replace("functions-list", task,
+                                           isVisibleToUser() ? AsyncTaskManager::VisiblePriority
+                                                             : AsyncTaskManager::HiddenPriority);
 }
 
 void FunctionsWidget::changeSizePolicy(QSizePolicy::Policy hor, QSizePolicy::Policy ver)
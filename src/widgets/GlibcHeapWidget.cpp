@@ -27,7 +27,7 @@ GlibcHeapWidget::GlibcHeapWidget(MainWindow *main, QWidget *parent)
     chunkInfoAction = new QAction(tr("Detailed Chunk Info"), this);
     binInfoAction = new QAction(tr("Bins Info"), this);
 
-    connect(Core(), &CutterCore::refreshAll, this, &GlibcHeapWidget::updateContents);
+    Core()->getRefreshScheduler()->add(this, [this]() { updateContents(); });
     connect(Core(), &CutterCore::debugTaskStateChanged, this, &GlibcHeapWidget::updateContents);
     connect(viewHeap, &QAbstractItemView::doubleClicked, this, &GlibcHeapWidget::onDoubleClicked);
     connect<void (QComboBox::*)(int)>(arenaSelectorView, &QComboBox::currentIndexChanged, this,
@@ -111,10 +111,50 @@ void GlibcHeapWidget::customMenuRequested(QPoint pos)
 
 void GlibcHeapModel::reload()
 {
-    beginResetModel();
-    values.clear();
-    values = Core()->getHeapChunks(arena_addr);
-    endResetModel();
+    QVector<Chunk> chunks = Core()->getHeapChunks(arena_addr);
+
+    // Rows before the first changed chunk are kept, so are the view's scroll position and
+    // selection if the heap only changed further down
+    int unchanged = 0;
+    int common = qMin(chunks.size(), fetchedRows);
+    while (unchanged < common && chunks.at(unchanged).offset == values.at(unchanged).offset
+           && chunks.at(unchanged).size == values.at(unchanged).size
+           && chunks.at(unchanged).status == values.at(unchanged).status) {
+        unchanged++;
+    }
+
+    int shownRows = qMax(fetchedRows, FetchSize);
+    if (unchanged < fetchedRows) {
+        beginRemoveRows(QModelIndex(), unchanged, fetchedRows - 1);
+        fetchedRows = unchanged;
+        values = chunks;
+        endRemoveRows();
+    } else {
+        values = chunks;
+    }
+
+    int count = qMin(shownRows, values.size()) - fetchedRows;
+    if (count > 0) {
+        beginInsertRows(QModelIndex(), fetchedRows, fetchedRows + count - 1);
+        fetchedRows += count;
+        endInsertRows();
+    }
+}
+
+bool GlibcHeapModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && fetchedRows < values.size();
+}
+
+void GlibcHeapModel::fetchMore(const QModelIndex &parent)
+{
+    int count = qMin(FetchSize, values.size() - fetchedRows);
+    if (parent.isValid() || count <= 0) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), fetchedRows, fetchedRows + count - 1);
+    fetchedRows += count;
+    endInsertRows();
 }
 
 int GlibcHeapModel::columnCount(const QModelIndex &) const
@@ -122,14 +162,14 @@ int GlibcHeapModel::columnCount(const QModelIndex &) const
     return ColumnCount;
 }
 
-int GlibcHeapModel::rowCount(const QModelIndex &) const
+int GlibcHeapModel::rowCount(const QModelIndex &parent) const
 {
-    return this->values.size();
+    return parent.isValid() ? 0 : fetchedRows;
 }
 
 QVariant GlibcHeapModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() >= values.count())
+    if (!index.isValid() || index.row() >= fetchedRows)
         return QVariant();
 
     const auto &item = values.at(index.row());
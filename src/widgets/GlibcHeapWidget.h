@@ -18,15 +18,25 @@ class GlibcHeapModel : public QAbstractTableModel
 public:
     explicit GlibcHeapModel(QObject *parent = nullptr);
     enum Column { OffsetColumn = 0, SizeColumn, StatusColumn, ColumnCount };
+    /// Rows added to the view at once, arenas may have millions of chunks
+    static constexpr int FetchSize = 4096;
+
+    /**
+     * @brief Get the chunks again and only update the rows which changed
+     */
     void reload();
     int rowCount(const QModelIndex &parent) const override;
     int columnCount(const QModelIndex &parent) const override;
     QVariant data(const QModelIndex &index, int role) const override;
     QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
     RVA arena_addr = 0;
 
 private:
     QVector<Chunk> values;
+    /// Number of values shown as rows
+    int fetchedRows = 0;
 };
 
 class GlibcHeapWidget : public QWidget
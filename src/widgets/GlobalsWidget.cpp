@@ -200,7 +200,7 @@ GlobalsWidget::GlobalsWidget(MainWindow *main)
 
     connect(Core(), &CutterCore::globalVarsChanged, this, &GlobalsWidget::refreshGlobals);
     connect(Core(), &CutterCore::codeRebased, this, &GlobalsWidget::refreshGlobals);
-    connect(Core(), &CutterCore::refreshAll, this, &GlobalsWidget::refreshGlobals);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshGlobals(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(globalsModel, GlobalsModel::CommentColumn); });
 }
@@ -129,7 +129,7 @@ HeadersWidget::HeadersWidget(MainWindow *main) : ListDockWidget(main)
     showCount(false);
 
     connect(Core(), &CutterCore::codeRebased, this, &HeadersWidget::refreshHeaders);
-    connect(Core(), &CutterCore::refreshAll, this, &HeadersWidget::refreshHeaders);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshHeaders(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(headersModel, HeadersModel::CommentColumn); });
 }
@@ -35,8 +35,16 @@ void HeapBinsGraphView::loadCurrentGraph()
     bool singleLinkedBin = QString(heapBin->type) == QString("Fast")
             || QString(heapBin->type) == QString("Tcache");
 
-    // store info about the chunks in a vector for easy access
+    // store info about the chunks in a vector for easy access, reading the details of the
+    // loaded ones only as long bins would take a while
+    int chunkCount = rz_list_length(heapBin->chunks);
+    allChunksLoaded = chunkCount <= loadedChunks;
+    moreBlock = RVA_INVALID;
     CutterRzListForeach (heapBin->chunks, iter, RzHeapChunkListItem, item) {
+        if (chunks.size() >= loadedChunks) {
+            moreBlock = item->addr;
+            break;
+        }
         GraphHeapChunk graphHeapChunk;
         graphHeapChunk.addr = item->addr;
         RzHeapChunkSimple *chunkInfo = Core()->getHeapChunk(item->addr);
@@ -64,6 +72,15 @@ void HeapBinsGraphView::loadCurrentGraph()
         display_double_linked_list(chunks);
     }
 
+    if (moreBlock != RVA_INVALID) {
+        // Entered by the fd edge of the last loaded chunk
+        GraphLayout::GraphBlock gbMore;
+        gbMore.entry = moreBlock;
+        addBlock(gbMore,
+                 tr("%1 more chunks\nDouble-click to load them").arg(chunkCount - chunks.size()),
+                 moreBlock);
+    }
+
     cleanupEdges(blocks);
     computeGraphPlacement();
 }
@@ -96,7 +113,7 @@ void HeapBinsGraphView::display_single_linked_list(QVector<GraphHeapChunk> chunk
             gbChunk.edges.emplace_back(chunks[i].fd);
         }
 
-        if (i == chunks.size() - 1 && heapBin->message) {
+        if (i == chunks.size() - 1 && allChunksLoaded && heapBin->message) {
             chunks[i].content += "\n" + QString(heapBin->message);
         }
 
@@ -104,7 +121,7 @@ void HeapBinsGraphView::display_single_linked_list(QVector<GraphHeapChunk> chunk
     }
 
     // add the END block if no message
-    if (!heapBin->message) {
+    if (allChunksLoaded && !heapBin->message) {
         GraphLayout::GraphBlock gbEnd;
         gbEnd.entry = 0;
         addBlock(gbEnd, "END", 0);
@@ -133,7 +150,7 @@ void HeapBinsGraphView::display_double_linked_list(QVector<GraphHeapChunk> chunk
         gbChunk.edges.emplace_back(chunks[i].bk);
 
         // if last chunk and there is message then show it in the chunk
-        if (i == chunks.size() - 1 && heapBin->message) {
+        if (i == chunks.size() - 1 && allChunksLoaded && heapBin->message) {
             chunks[i].content += "\n" + QString(heapBin->message);
         }
 
@@ -141,6 +158,17 @@ void HeapBinsGraphView::display_double_linked_list(QVector<GraphHeapChunk> chunk
     }
 }
 
+void HeapBinsGraphView::blockDoubleClicked(GraphView::GraphBlock &block, QMouseEvent *event,
+                                           QPoint pos)
+{
+    if (block.entry != moreBlock) {
+        SimpleTextGraphView::blockDoubleClicked(block, event, pos);
+        return;
+    }
+    loadedChunks += ChunksPerLoad;
+    refreshView();
+}
+
 // overriding this function from SimpleTextGraphView to support multiline text in graph block
 // most code is shared from that implementation
 void HeapBinsGraphView::drawBlock(QPainter &p, GraphView::GraphBlock &block, bool interactive)
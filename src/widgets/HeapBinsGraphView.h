@@ -16,8 +16,12 @@ class HeapBinsGraphView : public SimpleTextGraphView
 public:
     explicit HeapBinsGraphView(QWidget *parent, RzHeapBin *bin, MainWindow *main);
 
+    /// Chunks whose details are read at once, the rest is loaded when requested
+    static constexpr int ChunksPerLoad = 64;
+
 protected:
     void loadCurrentGraph() override;
+    void blockDoubleClicked(GraphView::GraphBlock &block, QMouseEvent *event, QPoint pos) override;
     void drawBlock(QPainter &p, GraphView::GraphBlock &block, bool interactive) override;
     void addBlock(GraphLayout::GraphBlock block, const QString &text,
                   RVA address = RVA_INVALID) override;
@@ -34,6 +38,11 @@ private:
     QAction *chunkInfoAction;
     RVA selectedBlock;
     int bits;
+    int loadedChunks = ChunksPerLoad;
+    /// Whether the chunks shown are all chunks of the bin
+    bool allChunksLoaded = false;
+    /// Block standing for the chunks which are not loaded yet
+    ut64 moreBlock = RVA_INVALID;
 };
 
 #endif // CUTTER_HEAPBINSGRAPHVIEW_H
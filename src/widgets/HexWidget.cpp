@@ -298,10 +298,14 @@ void HexWidget::setItemGroupSize(int size)
  * @see HexWidget#readItem
  *
  * Checks if current Item at the address changed compared to the last read data.
- * It is assumed that the current read data buffer contains the address.
+ * It is assumed that the current read data buffer contains the address. While debugging, the
+ * Item is compared with the memory at the previous debugger stop instead.
  */
 bool HexWidget::isItemDifferentAt(uint64_t address)
 {
+    if (Core()->currentlyDebugging) {
+        return Core()->isMemoryModified(address, static_cast<RVA>(itemByteLen));
+    }
     char oldItem[sizeof(uint64_t)] = {};
     char newItem[sizeof(uint64_t)] = {};
     if (data->copy(newItem, address, static_cast<size_t>(itemByteLen))
@@ -1278,6 +1282,7 @@ void HexWidget::w_writeString()
         RzCoreLocked core(Core());
         rz_core_write_string_at(core, getLocationAddress(), str.toUtf8().constData());
     }
+    Core()->memoryWritten(getLocationAddress(), str.toUtf8().size());
     refresh();
 }
 
@@ -1300,6 +1305,7 @@ void HexWidget::w_increaseDecrease()
         RzCoreLocked core(Core());
         rz_core_write_value_inc_at(core, getLocationAddress(), value, sz);
     }
+    Core()->memoryWritten(getLocationAddress(), sz);
     refresh();
 }
 
@@ -1336,6 +1342,7 @@ void HexWidget::w_writeBytes()
         rz_core_write_at(core, getLocationAddress(), buf, bytes_size);
         free(buf);
     }
+    Core()->memoryWritten(getLocationAddress(), bytes_size);
     refresh();
 }
 
@@ -1392,6 +1399,8 @@ void HexWidget::w_write64()
             rz_core_write_base64d_at(core, getLocationAddress(), str.constData());
         }
     }
+    // Encoding writes 4 bytes for every 3, decoding fewer than the input
+    Core()->memoryWritten(getLocationAddress(), (str.size() + 2) / 3 * 4);
     refresh();
 }
 
@@ -1417,6 +1426,7 @@ void HexWidget::w_writeRandom()
         RzCoreLocked core(Core());
         rz_core_write_random_at(core, getLocationAddress(), nbytes);
     }
+    Core()->memoryWritten(getLocationAddress(), nbytes);
     refresh();
 }
 
@@ -1436,6 +1446,7 @@ void HexWidget::w_duplFromOffset()
         RzCoreLocked core(Core());
         rz_core_write_duplicate_at(core, getLocationAddress(), src, len);
     }
+    Core()->memoryWritten(getLocationAddress(), len);
     refresh();
 }
 
@@ -1454,6 +1465,8 @@ void HexWidget::w_writePascalString()
         RzCoreLocked core(Core());
         rz_core_write_length_string_at(core, getLocationAddress(), str.toUtf8().constData());
     }
+    // Preceded by its length
+    Core()->memoryWritten(getLocationAddress(), str.toUtf8().size() + 1);
     refresh();
 }
 
@@ -1472,6 +1485,7 @@ void HexWidget::w_writeWideString()
         RzCoreLocked core(Core());
         rz_core_write_string_wide_at(core, getLocationAddress(), str.toUtf8().constData());
     }
+    Core()->memoryWritten(getLocationAddress(), str.toUtf8().size() * 2);
     refresh();
 }
 
@@ -1490,6 +1504,7 @@ void HexWidget::w_writeCString()
         RzCoreLocked core(Core());
         rz_core_write_string_zero_at(core, getLocationAddress(), str.toUtf8().constData());
     }
+    Core()->memoryWritten(getLocationAddress(), str.toUtf8().size() + 1);
     refresh();
 }
 
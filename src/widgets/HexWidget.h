@@ -160,7 +160,7 @@ public:
         m_blocks.clear();
         uint64_t addr = alignedAddr;
         for (ut64 i = 0; i < len / blockSize; ++i, addr += blockSize) {
-            m_blocks.append(Core()->ioRead(addr, blockSize));
+            m_blocks.append(Core()->ioReadTracked(addr, blockSize));
         }
     }
 
@@ -222,6 +222,7 @@ public:
         RzCoreLocked core(Core());
         rz_core_write_at(core, adr, in, len);
         writeToCache(in, adr, len);
+        Core()->memoryWritten(adr, len);
         emit Core()->instructionChanged(adr);
         return true;
     }
@@ -75,7 +75,8 @@ HexdumpWidget::HexdumpWidget(MainWindow *main)
     this->ui->hexTextView->addAction(&syncAction);
 
     connect(Config(), &Configuration::fontsUpdated, this, &HexdumpWidget::fontsUpdated);
-    connect(Core(), &CutterCore::refreshAll, this, [this]() { refresh(); });
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { refresh(); }, RefreshScheduler::Priority::High);
     connect(Core(), &CutterCore::refreshCodeViews, this, [this]() { refresh(); });
     connect(Core(), &CutterCore::instructionChanged, this, [this]() { refresh(); });
     connect(Core(), &CutterCore::stackChanged, this, [this]() { refresh(); });
@@ -114,6 +114,7 @@ void ImportsModel::reload()
 ImportsProxyModel::ImportsProxyModel(ImportsModel *sourceModel, QObject *parent)
     : AddressableFilterProxyModel(sourceModel, parent)
 {
+    setNameIndexKinds(NameIndex::Kind::Import);
     setFilterCaseSensitivity(Qt::CaseInsensitive);
     setSortCaseSensitivity(Qt::CaseInsensitive);
 }
@@ -122,7 +123,9 @@ bool ImportsProxyModel::filterAcceptsRow(int row, const QModelIndex &parent) con
 {
     QModelIndex index = sourceModel()->index(row, 0, parent);
     auto import = index.data(ImportsModel::ImportDescriptionRole).value<ImportDescription>();
-
+    if (rejectedByNameIndex(import.plt)) {
+        return false;
+    }
     return qhelpers::filterStringContains(import.name, this);
 }
 
@@ -179,7 +182,7 @@ ImportsWidget::ImportsWidget(MainWindow *main)
     connect(toggle_shortcut, &QShortcut::activated, this, [=]() { toggleDockWidget(true); });
 
     connect(Core(), &CutterCore::codeRebased, this, &ImportsWidget::refreshImports);
-    connect(Core(), &CutterCore::refreshAll, this, &ImportsWidget::refreshImports);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshImports(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(importsModel, ImportsModel::CommentColumn); });
 }
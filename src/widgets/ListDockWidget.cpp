@@ -57,7 +57,7 @@ void ListDockWidget::setModels(AddressableFilterProxyModel *objectFilterProxyMod
     ui->treeView->setModel(objectFilterProxyModel);
 
     connect(ui->quickFilterView, &QuickFilterView::filterTextChanged, objectFilterProxyModel,
-            &QSortFilterProxyModel::setFilterWildcard);
+            &AddressableFilterProxyModel::setFilterWildcardIndexed);
     connect(ui->quickFilterView, &QuickFilterView::filterClosed, ui->treeView,
             static_cast<void (QWidget::*)()>(&QWidget::setFocus));
 
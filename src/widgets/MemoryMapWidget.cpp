@@ -2,13 +2,30 @@
 #include "ui_ListDockWidget.h"
 #include "core/MainWindow.h"
 #include "common/Helpers.h"
+#include "common/Configuration.h"
 #include <QShortcut>
 
-MemoryMapModel::MemoryMapModel(QList<MemoryMapDescription> *memoryMaps, QObject *parent)
-    : AddressableItemModel<QAbstractListModel>(parent), memoryMaps(memoryMaps)
+MemoryMapModel::MemoryMapModel(QList<MemoryMapDescription> *memoryMaps,
+                               QList<QPair<RVA, RVA>> *modifiedMemory, QObject *parent)
+    : AddressableItemModel<QAbstractListModel>(parent),
+      memoryMaps(memoryMaps),
+      modifiedMemory(modifiedMemory)
 {
 }
 
+RVA MemoryMapModel::modifiedSize(const MemoryMapDescription &memoryMap) const
+{
+    RVA size = 0;
+    for (const auto &range : *modifiedMemory) {
+        RVA begin = qMax(range.first, memoryMap.addrStart);
+        RVA end = qMin(range.second, memoryMap.addrEnd);
+        if (end > begin) {
+            size += end - begin;
+        }
+    }
+    return size;
+}
+
 int MemoryMapModel::rowCount(const QModelIndex &) const
 {
     return memoryMaps->count();
@@ -37,13 +54,24 @@ QVariant MemoryMapModel::data(const QModelIndex &index, int role) const
             return memoryMap.name;
         case PermColumn:
             return memoryMap.permission;
+        case ModifiedColumn: {
+            RVA size = modifiedSize(memoryMap);
+            return size ? RzSizeString(size) : QString();
+        }
         case CommentColumn:
             return Core()->getCommentAt(memoryMap.addrStart);
         default:
             return QVariant();
         }
+    case Qt::ForegroundRole:
+        if (modifiedSize(memoryMap)) {
+            return Config()->getColor("graph.diff.unmatch");
+        }
+        return QVariant();
     case MemoryDescriptionRole:
         return QVariant::fromValue(memoryMap);
+    case ModifiedSizeRole:
+        return QVariant::fromValue(modifiedSize(memoryMap));
     default:
         return QVariant();
     }
@@ -62,6 +90,8 @@ QVariant MemoryMapModel::headerData(int section, Qt::Orientation, int role) cons
             return tr("Name");
         case PermColumn:
             return tr("Permissions");
+        case ModifiedColumn:
+            return tr("Modified since last stop");
         case CommentColumn:
             return tr("Comment");
         default:
@@ -107,6 +137,9 @@ bool MemoryProxyModel::lessThan(const QModelIndex &left, const QModelIndex &righ
         return leftMemMap.name < rightMemMap.name;
     case MemoryMapModel::PermColumn:
         return leftMemMap.permission < rightMemMap.permission;
+    case MemoryMapModel::ModifiedColumn:
+        return left.data(MemoryMapModel::ModifiedSizeRole).toULongLong()
+                < right.data(MemoryMapModel::ModifiedSizeRole).toULongLong();
     case MemoryMapModel::CommentColumn:
         return Core()->getCommentAt(leftMemMap.addrStart)
                 < Core()->getCommentAt(rightMemMap.addrStart);
@@ -123,14 +156,14 @@ MemoryMapWidget::MemoryMapWidget(MainWindow *main)
     setWindowTitle(tr("Memory Map"));
     setObjectName("MemoryMapWidget");
 
-    memoryModel = new MemoryMapModel(&memoryMaps, this);
+    memoryModel = new MemoryMapModel(&memoryMaps, &modifiedMemory, this);
     memoryProxyModel = new MemoryProxyModel(memoryModel, this);
     setModels(memoryProxyModel);
     ui->treeView->sortByColumn(MemoryMapModel::AddrStartColumn, Qt::AscendingOrder);
 
     refreshDeferrer = createRefreshDeferrer([this]() { refreshMemoryMap(); });
 
-    connect(Core(), &CutterCore::refreshAll, this, &MemoryMapWidget::refreshMemoryMap);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshMemoryMap(); });
     connect(Core(), &CutterCore::registersChanged, this, &MemoryMapWidget::refreshMemoryMap);
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(memoryModel, MemoryMapModel::CommentColumn); });
@@ -150,10 +183,12 @@ void MemoryMapWidget::refreshMemoryMap()
         return;
     }
     memoryModel->beginResetModel();
-    memoryMaps = Core()->getMemoryMap();
+    memoryMaps = Core()->getDebugSnapshot(DebugSnapshot::Part::MemoryMaps)->memoryMaps;
+    modifiedMemory = Core()->getModifiedMemory();
     memoryModel->endResetModel();
 
     ui->treeView->resizeColumnToContents(0);
     ui->treeView->resizeColumnToContents(1);
     ui->treeView->resizeColumnToContents(2);
+    ui->treeView->resizeColumnToContents(MemoryMapModel::ModifiedColumn);
 }
@@ -28,6 +28,10 @@ class MemoryMapModel : public AddressableItemModel<QAbstractListModel>
 
 private:
     QList<MemoryMapDescription> *memoryMaps;
+    QList<QPair<RVA, RVA>> *modifiedMemory;
+
+    /// Number of bytes of \p memoryMap modified since the previous debugger stop
+    RVA modifiedSize(const MemoryMapDescription &memoryMap) const;
 
 public:
     enum Column {
@@ -35,12 +39,14 @@ public:
         AddrEndColumn,
         NameColumn,
         PermColumn,
+        ModifiedColumn,
         CommentColumn,
         ColumnCount
     };
-    enum Role { MemoryDescriptionRole = Qt::UserRole };
+    enum Role { MemoryDescriptionRole = Qt::UserRole, ModifiedSizeRole };
 
-    MemoryMapModel(QList<MemoryMapDescription> *memoryMaps, QObject *parent = nullptr);
+    MemoryMapModel(QList<MemoryMapDescription> *memoryMaps,
+                   QList<QPair<RVA, RVA>> *modifiedMemory, QObject *parent = nullptr);
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -80,6 +86,7 @@ private:
     MemoryMapModel *memoryModel;
     MemoryProxyModel *memoryProxyModel;
     QList<MemoryMapDescription> memoryMaps;
+    QList<QPair<RVA, RVA>> modifiedMemory;
 
     RefreshDeferrer *refreshDeferrer;
 };
@@ -2,22 +2,55 @@
 #include "core/MainWindow.h"
 #include "CutterSeekable.h"
 
-#include <QStringListModel>
+#include <QStandardItemModel>
 #include <QCompleter>
 #include <QShortcut>
 #include <QAbstractItemView>
 
+namespace {
+
+constexpr int kMaxMatches = 50;
+// Wait for the user to stop typing before starting a new search
+constexpr int kSearchDelayMs = 30;
+
+constexpr int kNameRole = Qt::UserRole;
+constexpr int kOffsetRole = Qt::UserRole + 1;
+
+}
+
 Omnibar::Omnibar(MainWindow *main, QWidget *parent) : QLineEdit(parent), main(main)
 {
     // QLineEdit basic features
     this->setMinimumHeight(16);
     this->setFrame(false);
-    this->setPlaceholderText(tr("Type flag name or address here"));
+    this->setPlaceholderText(tr("Type name or address here"));
     this->setStyleSheet("border-radius: 5px; padding: 0 8px; margin: 5px 0;");
     this->setTextMargins(10, 0, 0, 0);
     this->setClearButtonEnabled(true);
 
+    // The matches are already ranked by OmnibarTask, the completer only displays them
+    matchesModel = new QStandardItemModel(this);
+    completer = new QCompleter(matchesModel, this);
+    completer->setMaxVisibleItems(20);
+    completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    completer->setCompletionRole(kNameRole);
+    this->setCompleter(completer);
+    connect(completer,
+            static_cast<void (QCompleter::*)(const QModelIndex &)>(&QCompleter::activated), this,
+            &Omnibar::matchActivated);
+
+    searchTimer.setSingleShot(true);
+    searchTimer.setInterval(kSearchDelayMs);
+    connect(&searchTimer, &QTimer::timeout, this, &Omnibar::startSearch);
+    connect(this, &QLineEdit::textEdited, &searchTimer, [this]() { searchTimer.start(); });
+
     connect(this, &QLineEdit::returnPressed, this, &Omnibar::on_gotoEntry_returnPressed);
+    // Names reindexed in the background may match the query being typed differently
+    connect(Core(), &CutterCore::nameIndexUpdated, this, [this]() {
+        if (hasFocus() && !text().trimmed().isEmpty()) {
+            searchTimer.start();
+        }
+    });
 
     // Esc clears omnibar
     QShortcut *clear_shortcut = new QShortcut(QKeySequence(Qt::Key_Escape), this);
@@ -25,38 +58,87 @@ Omnibar::Omnibar(MainWindow *main, QWidget *parent) : QLineEdit(parent), main(ma
     clear_shortcut->setContext(Qt::WidgetWithChildrenShortcut);
 }
 
-void Omnibar::setupCompleter()
+Omnibar::~Omnibar()
 {
-    // Set gotoEntry completer for jump history
-    QCompleter *completer = new QCompleter(flags, this);
-    completer->setMaxVisibleItems(20);
-    completer->setCompletionMode(QCompleter::PopupCompletion);
-    completer->setModelSorting(QCompleter::CaseSensitivelySortedModel);
-    completer->setCaseSensitivity(Qt::CaseInsensitive);
-    completer->setFilterMode(Qt::MatchContains);
+    cancelSearch();
+}
 
-    this->setCompleter(completer);
+void Omnibar::cancelSearch()
+{
+    searchTimer.stop();
+    if (task) {
+        // Don't wait for it, its results are ignored from now on
+        task->interrupt();
+        task.clear();
+    }
 }
 
-void Omnibar::refresh(const QStringList &flagList)
+void Omnibar::startSearch()
 {
-    flags = flagList;
+    cancelSearch();
 
-    setupCompleter();
+    QString query = text().trimmed();
+    if (query.isEmpty()) {
+        matchesModel->clear();
+        return;
+    }
+
+    task = QSharedPointer<OmnibarTask>::create(query, Core()->getSeekHistory(), kMaxMatches);
+    OmnibarTask *taskPtr = task.data();
+    connect(taskPtr, &OmnibarTask::matchesUpdated, this,
+            [this, taskPtr](const QList<OmnibarMatch> &matches, bool) {
+                if (task.data() == taskPtr) {
+                    matchesUpdated(matches);
+                }
+            });
+    Core()->getAsyncTaskManager()->start(task);
 }
 
-void Omnibar::restoreCompleter()
+void Omnibar::matchesUpdated(const QList<OmnibarMatch> &matches)
 {
-    QCompleter *completer = this->completer();
-    if (!completer) {
-        return;
+    matchesModel->clear();
+    for (const OmnibarMatch &match : matches) {
+        auto item = new QStandardItem(QString("%1  (%2 @ %3)")
+                                              .arg(match.name)
+                                              .arg(NameIndex::kindName(match.kind))
+                                              .arg(RzAddressString(match.offset)));
+        item->setData(match.name, kNameRole);
+        item->setData(QVariant::fromValue(match.offset), kOffsetRole);
+        matchesModel->appendRow(item);
     }
-    completer->setFilterMode(Qt::MatchContains);
+
+    if (hasFocus() && !matches.isEmpty()) {
+        completer->complete();
+    }
+}
+
+void Omnibar::matchActivated(const QModelIndex &index)
+{
+    gotoOffset(index.data(kOffsetRole).toULongLong());
+    // The completer has put the name into the line edit, don't evaluate it on returnPressed
+    this->setText("");
+}
+
+void Omnibar::gotoOffset(RVA offset)
+{
+    cancelSearch();
+    if (auto memoryWidget = main->getLastMemoryWidget()) {
+        memoryWidget->getSeekable()->seek(offset);
+        memoryWidget->raiseMemoryWidget();
+    } else {
+        Core()->seekAndShow(offset);
+    }
+
+    this->setText("");
+    this->clearFocus();
+    matchesModel->clear();
 }
 
 void Omnibar::clear()
 {
     QLineEdit::clear();
+    cancelSearch();
+    matchesModel->clear();
 
     // Close the potential shown completer popup
     clearFocus();
@@ -66,17 +148,8 @@ void Omnibar::clear()
 void Omnibar::on_gotoEntry_returnPressed()
 {
     QString str = this->text();
-    if (!str.isEmpty()) {
-        if (auto memoryWidget = main->getLastMemoryWidget()) {
-            RVA offset = Core()->math(str);
-            memoryWidget->getSeekable()->seek(offset);
-            memoryWidget->raiseMemoryWidget();
-        } else {
-            Core()->seekAndShow(str);
-        }
+    if (str.isEmpty()) {
+        return;
     }
-
-    this->setText("");
-    this->clearFocus();
-    this->restoreCompleter();
+    gotoOffset(Core()->math(str));
 }
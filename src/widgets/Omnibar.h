@@ -2,30 +2,40 @@
 #define OMNIBAR_H
 
 #include <QLineEdit>
+#include <QSharedPointer>
+#include <QTimer>
+
+#include "common/OmnibarTask.h"
 
 class MainWindow;
+class QCompleter;
+class QStandardItemModel;
 
 class Omnibar : public QLineEdit
 {
     Q_OBJECT
 public:
     explicit Omnibar(MainWindow *main, QWidget *parent = nullptr);
-
-    void refresh(const QStringList &flagList);
+    ~Omnibar() override;
 
 private slots:
     void on_gotoEntry_returnPressed();
-
-    void restoreCompleter();
+    void startSearch();
+    void matchesUpdated(const QList<OmnibarMatch> &matches);
+    void matchActivated(const QModelIndex &index);
 
 public slots:
     void clear();
 
 private:
-    void setupCompleter();
+    void gotoOffset(RVA offset);
+    void cancelSearch();
 
     MainWindow *main;
-    QStringList flags;
+    QCompleter *completer;
+    QStandardItemModel *matchesModel;
+    QTimer searchTimer;
+    QSharedPointer<OmnibarTask> task;
 };
 
 #endif // OMNIBAR_H
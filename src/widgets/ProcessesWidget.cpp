@@ -50,7 +50,7 @@ ProcessesWidget::ProcessesWidget(MainWindow *main)
 
     connect(ui->quickFilterView, &QuickFilterView::filterTextChanged, modelFilter,
             &ProcessesFilterModel::setFilterWildcard);
-    connect(Core(), &CutterCore::refreshAll, this, &ProcessesWidget::updateContents);
+    Core()->getRefreshScheduler()->add(this, [this]() { updateContents(); });
     connect(Core(), &CutterCore::registersChanged, this, &ProcessesWidget::updateContents);
     connect(Core(), &CutterCore::debugTaskStateChanged, this, &ProcessesWidget::updateContents);
     // Seek doesn't necessarily change when switching processes
@@ -106,7 +106,8 @@ void ProcessesWidget::setProcessesGrid()
     int i = 0;
     QFont font;
 
-    for (const auto &processesItem : Core()->getProcessThreads(DEBUGGED_PID)) {
+    const auto snapshot = Core()->getDebugSnapshot(DebugSnapshot::Part::Threads);
+    for (const auto &processesItem : snapshot->threads) {
         st64 pid = processesItem.pid;
         st64 uid = processesItem.uid;
         QString status = translateStatus(processesItem.status);
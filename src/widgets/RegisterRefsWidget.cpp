@@ -157,7 +157,7 @@ RegisterRefsWidget::RegisterRefsWidget(MainWindow *main)
     connect(ui->quickFilterView, &QuickFilterView::filterClosed, ui->registerRefTreeView,
             [this]() { ui->registerRefTreeView->setFocus(); });
     setScrollMode();
-    connect(Core(), &CutterCore::refreshAll, this, &RegisterRefsWidget::refreshRegisterRef);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshRegisterRef(); });
     connect(Core(), &CutterCore::registersChanged, this, &RegisterRefsWidget::refreshRegisterRef);
     connect(Core(), &CutterCore::commentsChanged, this, [this]() {
         qhelpers::emitColumnChanged(registerRefModel, RegisterRefModel::CommentColumn);
@@ -185,7 +185,8 @@ void RegisterRefsWidget::refreshRegisterRef()
     registerRefModel->beginResetModel();
 
     registerRefs.clear();
-    for (const RegisterRef &reg : Core()->getRegisterRefs()) {
+    const auto snapshot = Core()->getDebugSnapshot(DebugSnapshot::Part::RegisterRefs);
+    for (const RegisterRef &reg : snapshot->registerRefs) {
         RegisterRefDescription desc;
 
         desc.value = RzAddressString(reg.value);
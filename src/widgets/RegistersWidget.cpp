@@ -20,8 +20,9 @@ RegistersWidget::RegistersWidget(MainWindow *main)
 
     refreshDeferrer = createRefreshDeferrer([this]() { updateContents(); });
 
-    connect(Core(), &CutterCore::refreshAll, this, &RegistersWidget::updateContents);
+    Core()->getRefreshScheduler()->add(this, [this]() { updateContents(); });
     connect(Core(), &CutterCore::registersChanged, this, &RegistersWidget::updateContents);
+    connect(Core(), &CutterCore::debugSnapshotPublished, this, &RegistersWidget::updateContents);
 
     // Hide shortcuts because there is no way of selecting an item and triger them
     for (auto &action : addressContextMenu.actions()) {
@@ -47,7 +48,10 @@ void RegistersWidget::setRegisterGrid()
     QString regValue;
     QLabel *registerLabel;
     QLineEdit *registerEditValue;
-    const auto registerRefs = Core()->getRegisterRefValues();
+    // Without a debug session there is no snapshot, the registers are the ones of the analysis
+    const auto registerRefs = Core()->currentlyDebugging
+            ? Core()->getDebugSnapshot(DebugSnapshot::Part::RegisterValues)->registerValues
+            : Core()->getRegisterRefValues();
 
     registerLen = registerRefs.size();
     for (auto &reg : registerRefs) {
@@ -135,7 +135,7 @@ RelocsWidget::RelocsWidget(MainWindow *main)
     ui->treeView->sortByColumn(RelocsModel::NameColumn, Qt::AscendingOrder);
 
     connect(Core(), &CutterCore::codeRebased, this, &RelocsWidget::refreshRelocs);
-    connect(Core(), &CutterCore::refreshAll, this, &RelocsWidget::refreshRelocs);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshRelocs(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(relocsModel, RelocsModel::CommentColumn); });
 }
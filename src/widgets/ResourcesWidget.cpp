@@ -117,7 +117,7 @@ ResourcesWidget::ResourcesWidget(MainWindow *main)
     // Configure widget
     this->setWindowTitle(tr("Resources"));
 
-    connect(Core(), &CutterCore::refreshAll, this, &ResourcesWidget::refreshResources);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshResources(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(model, ResourcesModel::COMMENT); });
 }
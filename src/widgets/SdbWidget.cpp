@@ -13,7 +13,8 @@ SdbWidget::SdbWidget(MainWindow *main) : CutterDockWidget(main), ui(new Ui::SdbW
 
     path.clear();
 
-    connect(Core(), &CutterCore::refreshAll, this, [this]() { reload(); });
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { reload(); }, RefreshScheduler::Priority::Low);
     reload();
 }
 
@@ -2,6 +2,9 @@
 #include "ui_SearchWidget.h"
 #include "core/MainWindow.h"
 #include "common/Helpers.h"
+#include "common/PreviewCache.h"
+#include "common/SearchTask.h"
+#include "core/BytePatternSearch.h"
 
 #include <QDockWidget>
 #include <QTreeWidget>
@@ -11,8 +14,6 @@
 namespace {
 
 static const int kMaxTooltipWidth = 500;
-static const int kMaxTooltipDisasmPreviewLines = 10;
-static const int kMaxTooltipHexdumpBytes = 64;
 
 }
 
@@ -71,16 +72,19 @@ QVariant SearchModel::data(const QModelIndex &index, int role) const
         }
     case Qt::ToolTipRole: {
 
-        QString previewContent = QString();
+        // Generated in the background, the tooltip is refreshed once the preview is ready
+        PreviewCache *previews = Core()->getPreviewCache();
+        QStringList preview;
+        bool ready = true;
         // if result is CODE, show disassembly
         if (!exp.code.isEmpty()) {
-            previewContent =
-                    Core()->getDisassemblyPreview(exp.offset, kMaxTooltipDisasmPreviewLines)
-                            .join("<br>");
-            // if result is DATA or Disassembly is N/A
-        } else if (!exp.data.isEmpty() || previewContent.isEmpty()) {
-            previewContent = Core()->getHexdumpPreview(exp.offset, kMaxTooltipHexdumpBytes);
+            ready = previews->lookup(PreviewCache::Kind::Disassembly, exp.offset, &preview);
         }
+        // if result is DATA or Disassembly is N/A
+        if (ready && preview.isEmpty()) {
+            ready = previews->lookup(PreviewCache::Kind::Hexdump, exp.offset, &preview);
+        }
+        QString previewContent = ready ? preview.join("<br>") : tr("<i>Loading...</i>");
 
         const QFont &fnt = Config()->getBaseFont();
         QFontMetrics fm { fnt };
@@ -188,25 +192,37 @@ SearchWidget::SearchWidget(MainWindow *main) : CutterDockWidget(main), ui(new Ui
 
     setScrollMode();
 
+    // Start generating the tooltip previews of the hovered rows before the tooltip is requested
+    ui->searchTreeView->setMouseTracking(true);
+    connect(ui->searchTreeView, &QAbstractItemView::entered, this,
+            [this](const QModelIndex &index) {
+                // All results of a search are either code or data
+                bool code = !index.data(SearchModel::SearchDescriptionRole)
+                                     .value<SearchDescription>()
+                                     .code.isEmpty();
+                Core()->getPreviewCache()->prefetch(
+                        code ? PreviewCache::Kind::Disassembly : PreviewCache::Kind::Hexdump,
+                        qhelpers::neighborAddresses(search_proxy_model, index, 2));
+            });
+    connect(Core()->getPreviewCache(), &PreviewCache::previewReady, this,
+            [this]() { qhelpers::refreshHoveredToolTip(ui->searchTreeView); });
+
     connect(Core(), &CutterCore::toggleDebugView, this, &SearchWidget::updateSearchBoundaries);
-    connect(Core(), &CutterCore::refreshAll, this, &SearchWidget::refreshSearchspaces);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshSearchspaces(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(search_model, SearchModel::COMMENT); });
 
     QShortcut *enter_press = new QShortcut(QKeySequence(Qt::Key_Return), this);
-    connect(enter_press, &QShortcut::activated, this, [this]() {
-        disableSearch();
-        refreshSearch();
-        checkSearchResultEmpty();
-        enableSearch();
-    });
+    connect(enter_press, &QShortcut::activated, this, [this]() { refreshSearch(true); });
     enter_press->setContext(Qt::WidgetWithChildrenShortcut);
 
+    // The search button turns into a stop button while searching
     connect(ui->searchButton, &QAbstractButton::clicked, this, [this]() {
-        disableSearch();
-        refreshSearch();
-        checkSearchResultEmpty();
-        enableSearch();
+        if (searchTask) {
+            stopSearch();
+        } else {
+            refreshSearch(true);
+        }
     });
 
     connect(ui->searchspaceCombo,
@@ -214,7 +230,10 @@ SearchWidget::SearchWidget(MainWindow *main) : CutterDockWidget(main), ui(new Ui
             [this](int index) { updatePlaceholderText(index); });
 }
 
-SearchWidget::~SearchWidget() {}
+SearchWidget::~SearchWidget()
+{
+    stopSearch();
+}
 
 void SearchWidget::updateSearchBoundaries()
 {
@@ -258,6 +277,8 @@ void SearchWidget::refreshSearchspaces()
     ui->searchspaceCombo->addItem(tr("hex string"), QVariant("/xj"));
     ui->searchspaceCombo->addItem(tr("ROP gadgets"), QVariant("/Rj"));
     ui->searchspaceCombo->addItem(tr("32bit value"), QVariant("/vj"));
+    ui->searchspaceCombo->addItem(tr("hex patterns (wildcards, masks)"),
+                                  QVariant(SearchTask::BytePatternSpace));
 
     if (cur_idx > 0)
         ui->searchspaceCombo->setCurrentIndex(cur_idx);
@@ -265,17 +286,82 @@ void SearchWidget::refreshSearchspaces()
     refreshSearch();
 }
 
-void SearchWidget::refreshSearch()
+void SearchWidget::refreshSearch(bool interactive)
 {
+    stopSearch();
+
     QString searchFor = ui->filterLineEdit->text();
     QString searchSpace = ui->searchspaceCombo->currentData().toString();
     QString searchIn = ui->searchInCombo->currentData().toString();
 
     search_model->beginResetModel();
-    search = Core()->getAllSearch(searchFor, searchSpace, searchIn);
+    search.clear();
     search_model->endResetModel();
 
-    qhelpers::adjustColumns(ui->searchTreeView, 3, 0);
+    if (searchFor.isEmpty()) {
+        return;
+    }
+
+    if (searchSpace == SearchTask::BytePatternSpace) {
+        QVector<BytePattern> patterns;
+        QString error;
+        if (!BytePattern::parseList(searchFor, &patterns, &error)) {
+            if (interactive) {
+                QMessageBox::warning(this, tr("Invalid pattern"), error);
+            }
+            return;
+        }
+    }
+
+    searchTask = QSharedPointer<SearchTask>::create(searchFor, searchSpace, searchIn,
+                                                    ui->limitSpinBox->value());
+    SearchTask *task = searchTask.data();
+    // Results of a stopped or replaced search are ignored, the task keeps running until it
+    // notices the interruption.
+    connect(task, &SearchTask::resultsFound, this,
+            [this, task](const QList<SearchDescription> &results) {
+                if (searchTask.data() != task) {
+                    return;
+                }
+                bool first = search.isEmpty();
+                search_model->beginInsertRows(QModelIndex(), search.count(),
+                                              search.count() + results.count() - 1);
+                search.append(results);
+                search_model->endInsertRows();
+                if (first) {
+                    qhelpers::adjustColumns(ui->searchTreeView, 3, 0);
+                }
+            });
+    connect(task, &SearchTask::searchProgress, this, [this, task](int percent) {
+        if (searchTask.data() == task) {
+            ui->searchButton->setText(tr("Stop (%1%)").arg(percent));
+        }
+    });
+    connect(task, &AsyncTask::finished, this, [this, task, interactive]() {
+        if (searchTask.data() != task) {
+            return;
+        }
+        searchTask.clear();
+        enableSearch();
+        qhelpers::adjustColumns(ui->searchTreeView, 3, 0);
+        if (interactive) {
+            checkSearchResultEmpty();
+        }
+    });
+
+    disableSearch();
+    Core()->getAsyncTaskManager()->start(searchTask);
+}
+
+void SearchWidget::stopSearch()
+{
+    if (!searchTask) {
+        return;
+    }
+    // Keep the results found so far
+    searchTask->interrupt();
+    searchTask.clear();
+    enableSearch();
 }
 
 // No Results Found information message when search returns empty
@@ -314,6 +400,9 @@ void SearchWidget::updatePlaceholderText(int index)
     case 5: // 32bit value
         ui->filterLineEdit->setPlaceholderText("0xdeadbeef");
         break;
+    case 6: // hex patterns
+        ui->filterLineEdit->setPlaceholderText("e8????????, 4?8b:f0ff");
+        break;
     default:
         ui->filterLineEdit->setPlaceholderText("jmp rax");
     }
@@ -321,9 +410,7 @@ void SearchWidget::updatePlaceholderText(int index)
 
 void SearchWidget::disableSearch()
 {
-    ui->searchButton->setEnabled(false);
-    ui->searchButton->setText(tr("Searching..."));
-    qApp->processEvents();
+    ui->searchButton->setText(tr("Stop"));
 }
 
 void SearchWidget::enableSearch()
@@ -12,6 +12,7 @@
 
 class MainWindow;
 class QTreeWidgetItem;
+class SearchTask;
 class SearchWidget;
 
 class SearchModel : public AddressableItemModel<QAbstractListModel>
@@ -74,8 +75,14 @@ private:
     SearchModel *search_model;
     SearchSortFilterProxyModel *search_proxy_model;
     QList<SearchDescription> search;
-
-    void refreshSearch();
+    QSharedPointer<SearchTask> searchTask;
+
+    /**
+     * @param interactive whether the search was started by the user and should report empty
+     * results
+     */
+    void refreshSearch(bool interactive = false);
+    void stopSearch();
     void checkSearchResultEmpty();
     void enableSearch();
     void disableSearch();
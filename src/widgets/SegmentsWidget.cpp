@@ -140,7 +140,7 @@ bool SegmentsProxyModel::lessThan(const QModelIndex &left, const QModelIndex &ri
 SegmentsWidget::SegmentsWidget(MainWindow *main) : ListDockWidget(main)
 {
     setObjectName("SegmentsWidget");
-    setWindowTitle(QStringLiteral("Segments"));
+    setWindowTitle(tr("Segments"));
 
     segmentsModel = new SegmentsModel(&segments, this);
     auto proxyModel = new SegmentsProxyModel(segmentsModel, this);
@@ -151,7 +151,7 @@ SegmentsWidget::SegmentsWidget(MainWindow *main) : ListDockWidget(main)
     ui->quickFilterView->closeFilter();
     showCount(false);
 
-    connect(Core(), &CutterCore::refreshAll, this, &SegmentsWidget::refreshSegments);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshSegments(); });
     connect(Core(), &CutterCore::codeRebased, this, &SegmentsWidget::refreshSegments);
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(segmentsModel, SegmentsModel::CommentColumn); });
@@ -35,7 +35,7 @@ StackWidget::StackWidget(MainWindow *main)
 
     refreshDeferrer = createRefreshDeferrer([this]() { updateContents(); });
 
-    connect(Core(), &CutterCore::refreshAll, this, &StackWidget::updateContents);
+    Core()->getRefreshScheduler()->add(this, [this]() { updateContents(); });
     connect(Core(), &CutterCore::registersChanged, this, &StackWidget::updateContents);
     connect(Core(), &CutterCore::stackChanged, this, &StackWidget::updateContents);
     connect(Core(), &CutterCore::commentsChanged, this,
@@ -145,7 +145,17 @@ StackModel::StackModel(QObject *parent) : QAbstractTableModel(parent) {}
 
 void StackModel::reload()
 {
-    QList<AddrRefs> stackItems = Core()->getStack();
+    const auto snapshot = Core()->getDebugSnapshot(DebugSnapshot::Part::Stack);
+    const QList<AddrRefs> &stackItems = snapshot->stack;
+    const int ptrSize = Core()->getArchBits() / 8;
+    if (!stackItems.isEmpty()) {
+        // Keep the shown stack pages tracked, so they are compared at the next stop
+        RVA begin = stackItems.first().addr;
+        RVA end = stackItems.last().addr + ptrSize;
+        if (end > begin && end - begin <= 0x100000) {
+            Core()->ioReadTracked(begin, static_cast<int>(end - begin));
+        }
+    }
 
     beginResetModel();
     values.clear();
@@ -154,6 +164,7 @@ void StackModel::reload()
 
         item.offset = stackItem.addr;
         item.value = RzAddressString(stackItem.value);
+        item.modified = Core()->isMemoryModified(stackItem.addr, ptrSize);
         if (!stackItem.ref.isNull()) {
             item.refDesc = Core()->formatRefDesc(stackItem.ref);
         }
@@ -196,6 +207,8 @@ QVariant StackModel::data(const QModelIndex &index, int role) const
         }
     case Qt::ForegroundRole:
         switch (index.column()) {
+        case ValueColumn:
+            return item.modified ? Config()->getColor("graph.diff.unmatch") : QVariant();
         case DescriptionColumn:
             return item.refDesc.refColor;
         default:
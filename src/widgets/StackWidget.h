@@ -24,6 +24,8 @@ public:
         RVA offset;
         QString value;
         RefDescription refDesc;
+        /// Changed since the previous debugger stop
+        bool modified;
     };
 
     enum Column { OffsetColumn = 0, ValueColumn, DescriptionColumn, CommentColumn, ColumnCount };
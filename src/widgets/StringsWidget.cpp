@@ -101,6 +101,7 @@ StringsProxyModel::StringsProxyModel(StringsModel *sourceModel, QObject *parent)
 {
     setFilterCaseSensitivity(Qt::CaseInsensitive);
     setSortCaseSensitivity(Qt::CaseInsensitive);
+    setNameIndexKinds(NameIndex::Kind::String);
 }
 
 void StringsProxyModel::setSelectedSection(QString section)
@@ -118,6 +119,9 @@ bool StringsProxyModel::filterAcceptsRow(int row, const QModelIndex &parent) con
     QModelIndex index = sourceModel()->index(row, 0, parent);
     StringDescription str =
             index.data(StringsModel::StringDescriptionRole).value<StringDescription>();
+    if (rejectedByNameIndex(str.vaddr)) {
+        return false;
+    }
     if (selectedSection.isEmpty()) {
         return qhelpers::filterStringContains(str.string, this);
     } else {
@@ -186,7 +190,7 @@ StringsWidget::StringsWidget(MainWindow *main)
     menu->addAction(ui->actionCopy_String);
 
     connect(ui->quickFilterView, &ComboQuickFilterView::filterTextChanged, proxyModel,
-            &QSortFilterProxyModel::setFilterWildcard);
+            &AddressableFilterProxyModel::setFilterWildcardIndexed);
 
     connect(ui->quickFilterView, &ComboQuickFilterView::filterTextChanged, this,
             [this] { tree->showItemsNumber(proxyModel->rowCount()); });
@@ -203,7 +207,8 @@ StringsWidget::StringsWidget(MainWindow *main)
     });
     clearShortcut->setContext(Qt::WidgetWithChildrenShortcut);
 
-    connect(Core(), &CutterCore::refreshAll, this, &StringsWidget::refreshStrings);
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { refreshStrings(); }, RefreshScheduler::Priority::Low);
     connect(Core(), &CutterCore::codeRebased, this, &StringsWidget::refreshStrings);
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(model, StringsModel::CommentColumn); });
@@ -224,14 +229,17 @@ StringsWidget::~StringsWidget() {}
 
 void StringsWidget::refreshStrings()
 {
-    if (task) {
-        task->wait();
-    }
-
     task = QSharedPointer<StringsTask>(new StringsTask());
-    connect(task.data(), &StringsTask::stringSearchFinished, this,
-            &StringsWidget::stringSearchFinished);
-    Core()->getAsyncTaskManager()->start(task);
+    StringsTask *taskPtr = task.data();
+    connect(taskPtr, &StringsTask::stringSearchFinished, this,
+            [this, taskPtr](const QList<StringDescription> &strings) {
+                if (task.data() == taskPtr) {
+                    stringSearchFinished(strings);
+                }
+            });
+    Core()->getAsyncTaskManager()->replace("strings-list", task,
+                                           isVisibleToUser() ? AsyncTaskManager::VisiblePriority
+                                                             : AsyncTaskManager::HiddenPriority);
 
     refreshSectionCombo();
 }
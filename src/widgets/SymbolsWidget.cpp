@@ -87,12 +87,16 @@ SymbolsProxyModel::SymbolsProxyModel(SymbolsModel *sourceModel, QObject *parent)
 {
     setFilterCaseSensitivity(Qt::CaseInsensitive);
     setSortCaseSensitivity(Qt::CaseInsensitive);
+    setNameIndexKinds(NameIndex::Kind::Symbol);
 }
 
 bool SymbolsProxyModel::filterAcceptsRow(int row, const QModelIndex &parent) const
 {
     QModelIndex index = sourceModel()->index(row, 0, parent);
     auto symbol = index.data(SymbolsModel::SymbolDescriptionRole).value<SymbolDescription>();
+    if (rejectedByNameIndex(symbol.vaddr)) {
+        return false;
+    }
 
     return qhelpers::filterStringContains(symbol.name, this);
 }
@@ -129,7 +133,7 @@ SymbolsWidget::SymbolsWidget(MainWindow *main) : ListDockWidget(main)
     ui->treeView->sortByColumn(SymbolsModel::AddressColumn, Qt::AscendingOrder);
 
     connect(Core(), &CutterCore::codeRebased, this, &SymbolsWidget::refreshSymbols);
-    connect(Core(), &CutterCore::refreshAll, this, &SymbolsWidget::refreshSymbols);
+    Core()->getRefreshScheduler()->add(this, [this]() { refreshSymbols(); });
     connect(Core(), &CutterCore::commentsChanged, this,
             [this]() { qhelpers::emitColumnChanged(symbolsModel, SymbolsModel::CommentColumn); });
 }
@@ -7,19 +7,12 @@
 
 #include "core/MainWindow.h"
 
-#define DEBUGGED_PID (-1)
-
 ThreadsWidget::ThreadsWidget(MainWindow *main) : CutterDockWidget(main), ui(new Ui::ThreadsWidget)
 {
     ui->setupUi(this);
 
     // Setup threads model
-    modelThreads = new QStandardItemModel(1, 3, this);
-    modelThreads->setHorizontalHeaderItem(ThreadsWidget::COLUMN_PID, new QStandardItem(tr("PID")));
-    modelThreads->setHorizontalHeaderItem(ThreadsWidget::COLUMN_STATUS,
-                                          new QStandardItem(tr("Status")));
-    modelThreads->setHorizontalHeaderItem(ThreadsWidget::COLUMN_PATH,
-                                          new QStandardItem(tr("Path")));
+    modelThreads = new ThreadsModel(this);
     ui->viewThreads->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft | Qt::AlignVCenter);
     ui->viewThreads->verticalHeader()->setVisible(false);
     ui->viewThreads->setFont(Config()->getFont());
@@ -46,7 +39,7 @@ ThreadsWidget::ThreadsWidget(MainWindow *main) : CutterDockWidget(main), ui(new
 
     connect(ui->quickFilterView, &QuickFilterView::filterTextChanged, modelFilter,
             &ThreadsFilterModel::setFilterWildcard);
-    connect(Core(), &CutterCore::refreshAll, this, &ThreadsWidget::updateContents);
+    Core()->getRefreshScheduler()->add(this, [this]() { updateContents(); });
     connect(Core(), &CutterCore::registersChanged, this, &ThreadsWidget::updateContents);
     connect(Core(), &CutterCore::debugTaskStateChanged, this, &ThreadsWidget::updateContents);
     // Seek doesn't necessarily change when switching threads/processes
@@ -66,7 +59,7 @@ void ThreadsWidget::updateContents()
 
     if (!Core()->currentlyDebugging) {
         // Remove rows from the previous debugging session
-        modelThreads->removeRows(0, modelThreads->rowCount());
+        modelThreads->setProcesses({});
         return;
     }
 
@@ -78,58 +71,14 @@ void ThreadsWidget::updateContents()
     }
 }
 
-QString ThreadsWidget::translateStatus(const char status)
-{
-    switch (status) {
-    case RZ_DBG_PROC_STOP:
-        return "Stopped";
-    case RZ_DBG_PROC_RUN:
-        return "Running";
-    case RZ_DBG_PROC_SLEEP:
-        return "Sleeping";
-    case RZ_DBG_PROC_ZOMBIE:
-        return "Zombie";
-    case RZ_DBG_PROC_DEAD:
-        return "Dead";
-    case RZ_DBG_PROC_RAISED:
-        return "Raised event";
-    default:
-        return "Unknown status";
-    }
-}
-
 void ThreadsWidget::setThreadsGrid()
 {
-    int i = 0;
-    QFont font;
-
-    for (const auto &threadsItem : Core()->getProcessThreads(DEBUGGED_PID)) {
-        st64 pid = threadsItem.pid;
-        QString status = translateStatus(threadsItem.status);
-        QString path = threadsItem.path;
-        bool current = threadsItem.current;
-        // Use bold font to highlight active thread
-        font.setBold(current);
-        QStandardItem *rowPid = new QStandardItem(QString::number(pid));
-        rowPid->setFont(font);
-        QStandardItem *rowStatus = new QStandardItem(status);
-        rowStatus->setFont(font);
-        QStandardItem *rowPath = new QStandardItem(path);
-        rowPath->setFont(font);
-        modelThreads->setItem(i, ThreadsWidget::COLUMN_PID, rowPid);
-        modelThreads->setItem(i, ThreadsWidget::COLUMN_STATUS, rowStatus);
-        modelThreads->setItem(i, ThreadsWidget::COLUMN_PATH, rowPath);
-        i++;
-    }
-
-    // Remove irrelevant old rows
-    if (modelThreads->rowCount() > i) {
-        modelThreads->removeRows(i, modelThreads->rowCount() - i);
+    const auto snapshot = Core()->getDebugSnapshot(DebugSnapshot::Part::Threads);
+    int rows = modelThreads->rowCount();
+    modelThreads->setProcesses(snapshot->threads);
+    if (modelThreads->rowCount() != rows) {
+        ui->viewThreads->resizeColumnsToContents();
     }
-
-    modelFilter->setSourceModel(modelThreads);
-    ui->viewThreads->resizeColumnsToContents();
-    ;
 }
 
 void ThreadsWidget::fontsUpdatedSlot()
@@ -146,7 +95,8 @@ void ThreadsWidget::onActivated(const QModelIndex &index)
 
     // Verify that the selected tid is still in the threads list since dpt= will
     // attach to any given id. If it isn't found simply update the UI.
-    for (const auto &value : Core()->getProcessThreads(DEBUGGED_PID)) {
+    const auto snapshot = Core()->getDebugSnapshot(DebugSnapshot::Part::Threads);
+    for (const auto &value : snapshot->threads) {
         if (tid == value.pid) {
             Core()->setCurrentDebugThread(tid);
             break;
@@ -156,6 +106,75 @@ void ThreadsWidget::onActivated(const QModelIndex &index)
     updateContents();
 }
 
+ThreadsModel::ThreadsModel(QObject *parent) : ProcessListModel(parent) {}
+
+int ThreadsModel::columnCount(const QModelIndex &) const
+{
+    return ThreadsWidget::COLUMN_COUNT;
+}
+
+QVariant ThreadsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+    case ThreadsWidget::COLUMN_PID:
+        return tr("PID");
+    case ThreadsWidget::COLUMN_STATUS:
+        return tr("Status");
+    case ThreadsWidget::COLUMN_PATH:
+        return tr("Path");
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ThreadsModel::displayData(const ProcessDescription &proc, int column) const
+{
+    switch (column) {
+    case ThreadsWidget::COLUMN_PID:
+        return QString::number(proc.pid);
+    case ThreadsWidget::COLUMN_STATUS:
+        return translateStatus(proc.status);
+    case ThreadsWidget::COLUMN_PATH:
+        return proc.path;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ThreadsModel::roleData(const ProcessDescription &proc, int, int role) const
+{
+    if (role == Qt::FontRole && proc.current) {
+        // Use bold font to highlight active thread
+        QFont font;
+        font.setBold(true);
+        return font;
+    }
+    return QVariant();
+}
+
+QString ThreadsModel::translateStatus(const char status)
+{
+    switch (status) {
+    case RZ_DBG_PROC_STOP:
+        return "Stopped";
+    case RZ_DBG_PROC_RUN:
+        return "Running";
+    case RZ_DBG_PROC_SLEEP:
+        return "Sleeping";
+    case RZ_DBG_PROC_ZOMBIE:
+        return "Zombie";
+    case RZ_DBG_PROC_DEAD:
+        return "Dead";
+    case RZ_DBG_PROC_RAISED:
+        return "Raised event";
+    default:
+        return "Unknown status";
+    }
+}
+
 ThreadsFilterModel::ThreadsFilterModel(QObject *parent) : QSortFilterProxyModel(parent)
 {
     setFilterCaseSensitivity(Qt::CaseInsensitive);
@@ -2,11 +2,11 @@
 
 #include <QJsonObject>
 #include <memory>
-#include <QStandardItem>
 #include <QTableView>
 #include <QSortFilterProxyModel>
 
 #include "core/Cutter.h"
+#include "common/ProcessListModel.h"
 #include "CutterDockWidget.h"
 
 class MainWindow;
@@ -15,6 +15,25 @@ namespace Ui {
 class ThreadsWidget;
 }
 
+class ThreadsModel : public ProcessListModel
+{
+    Q_OBJECT
+
+public:
+    explicit ThreadsModel(QObject *parent = nullptr);
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+protected:
+    QVariant displayData(const ProcessDescription &proc, int column) const override;
+    QVariant roleData(const ProcessDescription &proc, int column, int role) const override;
+
+private:
+    static QString translateStatus(const char status);
+};
+
 class ThreadsFilterModel : public QSortFilterProxyModel
 {
     Q_OBJECT
@@ -35,6 +54,7 @@ public:
         COLUMN_PID = 0,
         COLUMN_STATUS,
         COLUMN_PATH,
+        COLUMN_COUNT
     };
 
     explicit ThreadsWidget(MainWindow *main);
@@ -47,9 +67,8 @@ private slots:
     void onActivated(const QModelIndex &index);
 
 private:
-    QString translateStatus(const char status);
     std::unique_ptr<Ui::ThreadsWidget> ui;
-    QStandardItemModel *modelThreads;
+    ThreadsModel *modelThreads;
     ThreadsFilterModel *modelFilter;
     RefreshDeferrer *refreshDeferrer;
 };
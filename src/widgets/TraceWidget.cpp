@@ -0,0 +1,250 @@
+#include "TraceWidget.h"
+#include "ui_TraceWidget.h"
+
+#include "core/MainWindow.h"
+
+#include <QHeaderView>
+
+TraceModel::TraceModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+void TraceModel::setTrace(const QSharedPointer<const TraceBuffer> &trace)
+{
+    beginResetModel();
+    this->trace = trace;
+    endResetModel();
+}
+
+quint64 TraceModel::stepAt(int row) const
+{
+    return trace ? trace->firstStep() + row : 0;
+}
+
+int TraceModel::rowOf(quint64 step) const
+{
+    return trace && trace->contains(step) ? static_cast<int>(step - trace->firstStep()) : -1;
+}
+
+int TraceModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() || !trace ? 0 : static_cast<int>(trace->size());
+}
+
+int TraceModel::columnCount(const QModelIndex &) const
+{
+    return ColumnCount;
+}
+
+QVariant TraceModel::data(const QModelIndex &index, int role) const
+{
+    if (!trace || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    const TraceBuffer::StepInfo step = trace->getStep(stepAt(index.row()));
+    switch (index.column()) {
+    case IndexColumn:
+        return QString::number(step.index);
+    case AddressColumn:
+        return RzAddressString(step.pc);
+    case RegistersColumn: {
+        QStringList registers;
+        for (const auto &reg : step.registers) {
+            registers << QStringLiteral("%1=%2").arg(trace->getRegisterNames().at(reg.first),
+                                                     RzAddressString(reg.second));
+        }
+        return registers.join(' ');
+    }
+    case WritesColumn: {
+        QStringList writes;
+        for (const TraceBuffer::MemoryWrite &write : step.writes) {
+            writes << QStringLiteral("[%1]=%2").arg(RzAddressString(write.address),
+                                                    QString(write.data.toHex(' ')));
+        }
+        return writes.join(' ');
+    }
+    default:
+        return QVariant();
+    }
+}
+
+QVariant TraceModel::headerData(int section, Qt::Orientation, int role) const
+{
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+    case IndexColumn:
+        return tr("Step");
+    case AddressColumn:
+        return tr("Address");
+    case RegistersColumn:
+        return tr("Registers");
+    case WritesColumn:
+        return tr("Memory writes");
+    default:
+        return QVariant();
+    }
+}
+
+TraceWidget::TraceWidget(MainWindow *main)
+    : CutterDockWidget(main), ui(new Ui::TraceWidget), model(new TraceModel(this))
+{
+    ui->setupUi(this);
+
+    ui->traceView->setModel(model);
+    ui->traceView->setFont(Config()->getFont());
+    ui->traceView->verticalHeader()->setVisible(false);
+    // Traces have millions of rows, never let the view measure them
+    ui->traceView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->traceView->horizontalHeader()->setStretchLastSection(true);
+    ui->registersView->setColumnCount(2);
+    ui->registersView->setHorizontalHeaderLabels({ tr("Register"), tr("Value") });
+    ui->registersView->verticalHeader()->setVisible(false);
+    ui->registersView->setFont(Config()->getFont());
+    ui->stepSlider->setEnabled(false);
+
+    connect(ui->recordButton, &QPushButton::clicked, this, &TraceWidget::record);
+    connect(ui->stepSlider, &QSlider::valueChanged, this,
+            [this](int row) { selectStep(model->stepAt(row)); });
+    connect(ui->traceView->selectionModel(), &QItemSelectionModel::currentRowChanged, this,
+            [this](const QModelIndex &current) {
+                if (current.isValid() && current.row() != ui->stepSlider->value()) {
+                    selectStep(model->stepAt(current.row()));
+                }
+            });
+    connect(ui->traceView, &QTableView::doubleClicked, this, [this](const QModelIndex &index) {
+        auto trace = model->getTrace();
+        if (trace) {
+            Core()->seekAndShow(trace->getStep(model->stepAt(index.row())).pc);
+        }
+    });
+
+    connect(Core(), &CutterCore::traceRecordingStarted, this, &TraceWidget::recordingStarted);
+    connect(Core(), &CutterCore::traceRecordingProgress, this, &TraceWidget::recordingProgress);
+    connect(Core(), &CutterCore::traceRecorded, this, &TraceWidget::recorded);
+    connect(Core(), &CutterCore::debugTaskStateChanged, this, &TraceWidget::updateActions);
+    connect(Core(), &CutterCore::refreshAll, this, &TraceWidget::updateActions);
+    connect(Config(), &Configuration::fontsUpdated, this, &TraceWidget::fontsUpdatedSlot);
+    updateActions();
+}
+
+TraceWidget::~TraceWidget() {}
+
+void TraceWidget::record()
+{
+    if (Core()->isDebugTaskInProgress()) {
+        // The button stops the running recording
+        Core()->suspendDebug();
+        return;
+    }
+
+    TraceOptions options;
+    options.maxSteps = static_cast<quint64>(ui->stepsSpinBox->value());
+    options.capacity = static_cast<quint64>(ui->keepSpinBox->value());
+    QString until = ui->untilEdit->text().trimmed();
+    if (!until.isEmpty()) {
+        options.untilAddress = Core()->math(until);
+    }
+    options.condition = ui->conditionEdit->text().trimmed();
+    Core()->recordTrace(options);
+}
+
+void TraceWidget::recordingStarted()
+{
+    model->setTrace(QSharedPointer<const TraceBuffer>());
+    ui->registersView->setRowCount(0);
+    ui->stepSlider->setEnabled(false);
+    ui->statusLabel->setText(tr("Recording..."));
+    recordingTimer.start();
+}
+
+void TraceWidget::recordingProgress(quint64 steps, RVA pc)
+{
+    qint64 elapsed = recordingTimer.elapsed();
+    QString rate = elapsed > 0 ? QString::number(steps * 1000 / elapsed) : QString("-");
+    ui->statusLabel->setText(tr("Recording: %1 steps at %2, %3 steps/s")
+                                     .arg(steps)
+                                     .arg(RzAddressString(pc))
+                                     .arg(rate));
+}
+
+void TraceWidget::recorded()
+{
+    auto trace = Core()->getRecordedTrace();
+    model->setTrace(trace);
+    if (!trace || trace->size() == 0) {
+        ui->statusLabel->setText(tr("Nothing was recorded."));
+        return;
+    }
+
+    if (trace->firstStep() > 0) {
+        ui->statusLabel->setText(tr("%1 steps recorded in %2 ms, showing the last %3")
+                                         .arg(trace->endStep())
+                                         .arg(recordingTimer.elapsed())
+                                         .arg(trace->size()));
+    } else {
+        ui->statusLabel->setText(tr("%1 steps recorded in %2 ms")
+                                         .arg(trace->endStep())
+                                         .arg(recordingTimer.elapsed()));
+    }
+    ui->stepSlider->setRange(0, static_cast<int>(trace->size()) - 1);
+    ui->stepSlider->setEnabled(true);
+    ui->stepSlider->setValue(ui->stepSlider->maximum());
+    ui->traceView->resizeColumnToContents(TraceModel::IndexColumn);
+    ui->traceView->resizeColumnToContents(TraceModel::AddressColumn);
+    selectStep(trace->endStep() - 1);
+}
+
+void TraceWidget::updateActions()
+{
+    bool recording = Core()->isDebugTaskInProgress();
+    ui->recordButton->setText(recording ? tr("Stop") : tr("Record"));
+    ui->recordButton->setEnabled(Core()->currentlyDebugging);
+    ui->conditionEdit->setEnabled(Core()->currentlyEmulating);
+}
+
+void TraceWidget::selectStep(quint64 step)
+{
+    int row = model->rowOf(step);
+    if (row < 0) {
+        return;
+    }
+    if (ui->stepSlider->value() != row) {
+        QSignalBlocker blocker(ui->stepSlider);
+        ui->stepSlider->setValue(row);
+    }
+    QModelIndex index = model->index(row, 0);
+    if (ui->traceView->currentIndex().row() != row) {
+        ui->traceView->setCurrentIndex(index);
+    }
+    ui->traceView->scrollTo(index);
+    showRegisters(step);
+}
+
+void TraceWidget::showRegisters(quint64 step)
+{
+    auto trace = model->getTrace();
+    const QStringList &names = trace->getRegisterNames();
+    const QVector<ut64> values = trace->getRegistersBefore(step);
+    const QVector<ut64> next = trace->getRegistersBefore(step + 1);
+    ui->registersView->setRowCount(names.size());
+    for (int i = 0; i < names.size() && i < values.size(); i++) {
+        auto *name = new QTableWidgetItem(names.at(i));
+        auto *value = new QTableWidgetItem(RzAddressString(values.at(i)));
+        if (i < next.size() && next.at(i) != values.at(i)) {
+            // Written by the selected instruction
+            QFont font = Config()->getFont();
+            font.setBold(true);
+            value->setFont(font);
+            value->setToolTip(tr("Becomes %1").arg(RzAddressString(next.at(i))));
+        }
+        ui->registersView->setItem(i, 0, name);
+        ui->registersView->setItem(i, 1, value);
+    }
+}
+
+void TraceWidget::fontsUpdatedSlot()
+{
+    ui->traceView->setFont(Config()->getFont());
+    ui->registersView->setFont(Config()->getFont());
+}
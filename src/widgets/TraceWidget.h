@@ -0,0 +1,70 @@
+#ifndef TRACEWIDGET_H
+#define TRACEWIDGET_H
+
+#include <memory>
+
+#include <QAbstractTableModel>
+#include <QElapsedTimer>
+
+#include "core/Cutter.h"
+#include "CutterDockWidget.h"
+
+class MainWindow;
+
+namespace Ui {
+class TraceWidget;
+}
+
+/**
+ * @brief Steps of a recorded trace, without copying them out of the TraceBuffer
+ */
+class TraceModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column { IndexColumn = 0, AddressColumn, RegistersColumn, WritesColumn, ColumnCount };
+
+    explicit TraceModel(QObject *parent = nullptr);
+
+    void setTrace(const QSharedPointer<const TraceBuffer> &trace);
+    QSharedPointer<const TraceBuffer> getTrace() const { return trace; }
+    quint64 stepAt(int row) const;
+    int rowOf(quint64 step) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+private:
+    QSharedPointer<const TraceBuffer> trace;
+};
+
+class TraceWidget : public CutterDockWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TraceWidget(MainWindow *main);
+    ~TraceWidget();
+
+private slots:
+    void record();
+    void recordingStarted();
+    void recordingProgress(quint64 steps, RVA pc);
+    void recorded();
+    void updateActions();
+    void selectStep(quint64 step);
+    void fontsUpdatedSlot();
+
+private:
+    void showRegisters(quint64 step);
+
+    std::unique_ptr<Ui::TraceWidget> ui;
+    TraceModel *model;
+    QElapsedTimer recordingTimer;
+};
+
+#endif // TRACEWIDGET_H
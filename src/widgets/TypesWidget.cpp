@@ -188,7 +188,8 @@ TypesWidget::TypesWidget(MainWindow *main)
             &ComboQuickFilterView::clearFilter);
     clearShortcut->setContext(Qt::WidgetWithChildrenShortcut);
 
-    connect(Core(), &CutterCore::refreshAll, this, &TypesWidget::refreshTypes);
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { refreshTypes(); }, RefreshScheduler::Priority::Low);
 
     connect(ui->quickFilterView->comboBox(), &QComboBox::currentTextChanged, this, [this]() {
         types_proxy_model->setCategory(ui->quickFilterView->comboBox()->currentData().toString());
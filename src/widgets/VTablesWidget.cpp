@@ -161,7 +161,8 @@ VTablesWidget::VTablesWidget(MainWindow *main)
             [this] { tree->showItemsNumber(proxy->rowCount()); });
 
     connect(Core(), &CutterCore::codeRebased, this, &VTablesWidget::refreshVTables);
-    connect(Core(), &CutterCore::refreshAll, this, &VTablesWidget::refreshVTables);
+    Core()->getRefreshScheduler()->add(
+            this, [this]() { refreshVTables(); }, RefreshScheduler::Priority::Low);
 
     refreshDeferrer = createRefreshDeferrer([this]() { refreshVTables(); });
 }
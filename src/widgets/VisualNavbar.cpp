@@ -47,7 +47,7 @@ VisualNavbar::VisualNavbar(MainWindow *main, QWidget *parent)
 
     connect(Core(), &CutterCore::seekChanged, this, &VisualNavbar::on_seekChanged);
     connect(Core(), &CutterCore::registersChanged, this, &VisualNavbar::drawPCCursor);
-    connect(Core(), &CutterCore::refreshAll, this, &VisualNavbar::fetchAndPaintData);
+    Core()->getRefreshScheduler()->add(this, [this]() { fetchAndPaintData(); });
     connect(Core(), &CutterCore::functionsChanged, this, &VisualNavbar::fetchAndPaintData);
     connect(Core(), &CutterCore::flagsChanged, this, &VisualNavbar::fetchAndPaintData);
     connect(Core(), &CutterCore::globalVarsChanged, this, &VisualNavbar::fetchAndPaintData);